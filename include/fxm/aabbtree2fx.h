@@ -0,0 +1,569 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+#include "shapes2fx.h"
+
+/**
+ * \brief Dynamic bounding volume tree of Aabb2fx for broadphase queries over objects of very different sizes.
+ * Leaves store a fattened copy of each object's box so small movements don't touch the tree, and the tree is kept balanced
+ * with rotations on the way back up from every insert and remove. Nodes live in one pooled array linked by index, freed
+ * nodes are recycled through a free list. Everything is integer math on Fixed so the tree shape, traversal order and
+ * query results are identical on every machine given the same sequence of calls.
+ */
+struct AabbTree2fx
+{
+	using fixed = fixed64;
+
+	static constexpr int32_t NullNode = -1;
+
+	struct Node
+	{
+		Aabb2fx aabb;
+		int32_t parent = NullNode; // next free node while on the free list
+		int32_t child1 = NullNode;
+		int32_t child2 = NullNode;
+		int32_t height = -1; // 0 for leaves, -1 for free nodes
+		uint32_t userData = 0;
+
+		bool IsLeaf() const { return child1 == NullNode; }
+	};
+
+	// constructors
+	explicit AabbTree2fx(fixed margin = fixed::One >> 3) : margin(margin) {}
+
+	/**
+	 * \brief Adds an object and returns its proxy id, the stored box is \p aabb expanded by the margin.
+	 */
+	int32_t Insert(const Aabb2fx& aabb, uint32_t userData);
+	void Remove(int32_t proxy);
+
+	/**
+	 * \brief Updates an object's box, only touches the tree when \p aabb has left the fattened box.
+	 * The new fattened box is also stretched by \p displacement so an object moving steadily isn't reinserted every step.
+	 * \return True when the proxy was reinserted.
+	 */
+	bool Move(int32_t proxy, const Aabb2fx& aabb, const Vector2fx& displacement = Vector2fx::Zero);
+
+	const Aabb2fx& FatAabb(int32_t proxy) const { return nodes[proxy].aabb; }
+	uint32_t UserData(int32_t proxy) const { return nodes[proxy].userData; }
+	size_t Size() const { return proxyCount; }
+	int Height() const { return root == NullNode ? 0 : nodes[root].height; }
+	fixed Margin() const { return margin; }
+
+	/**
+	 * \brief Calls \p callback(proxy) for every leaf whose fat box overlaps \p aabb, stops early when the callback returns false.
+	 */
+	template <typename Callback>
+	void Query(const Aabb2fx& aabb, Callback&& callback) const;
+	void Query(const Aabb2fx& aabb, std::vector<int32_t>& out) const;
+
+	/**
+	 * \brief Calls \p callback(proxy) for every leaf whose fat box the segment \p from -> \p to touches, in traversal order.
+	 * Stops early when the callback returns false. The test is exact while raw coordinates stay below 2^61.
+	 */
+	template <typename Callback>
+	void RayCast(const Vector2fx& from, const Vector2fx& to, Callback&& callback) const;
+	void RayCast(const Vector2fx& from, const Vector2fx& to, std::vector<int32_t>& out) const;
+
+	/**
+	 * \brief Appends every pair of proxies whose fat boxes overlap, each pair once with the smaller proxy id first.
+	 */
+	void OverlapPairs(std::vector<std::pair<int32_t, int32_t>>& out) const;
+
+	// Checks parent links, heights and bounds of the whole tree, for tests and debugging
+	bool Validate() const;
+
+private:
+	fixed margin;
+	int32_t root = NullNode;
+	int32_t freeList = NullNode;
+	size_t proxyCount = 0;
+	std::vector<Node> nodes;
+
+	// Traversal stack that stays on the stack for any balanced tree and only spills to the heap for degenerate ones
+	struct NodeStack
+	{
+		std::array<int32_t, 128> inlineNodes;
+		std::vector<int32_t> heapNodes;
+		int32_t* data = inlineNodes.data();
+		size_t size = 0;
+		size_t capacity = 128;
+
+		bool Empty() const { return size == 0; }
+		int32_t Pop() { return data[--size]; }
+		void Push(int32_t node)
+		{
+			if (size == capacity)
+			{
+				std::vector<int32_t> grown(capacity * 2);
+				std::copy(data, data + size, grown.begin());
+				heapNodes.swap(grown);
+				data = heapNodes.data();
+				capacity *= 2;
+			}
+			data[size++] = node;
+		}
+	};
+
+	int32_t AllocateNode();
+	void FreeNode(int32_t node);
+	void InsertLeaf(int32_t leaf);
+	void RemoveLeaf(int32_t leaf);
+	int32_t Balance(int32_t node);
+	void Refit(int32_t node);
+	bool ValidateNode(int32_t node, int32_t parent) const;
+};
+
+int32_t AabbTree2fx::AllocateNode()
+{
+	int32_t node = freeList;
+	if (node == NullNode)
+	{
+		node = static_cast<int32_t>(nodes.size());
+		nodes.emplace_back();
+	}
+	else
+	{
+		freeList = nodes[node].parent;
+	}
+
+	nodes[node] = Node();
+	nodes[node].height = 0;
+	return node;
+}
+
+void AabbTree2fx::FreeNode(int32_t node)
+{
+	nodes[node].parent = freeList;
+	nodes[node].height = -1;
+	freeList = node;
+}
+
+int32_t AabbTree2fx::Insert(const Aabb2fx& aabb, uint32_t userData)
+{
+	const int32_t proxy = AllocateNode();
+	nodes[proxy].aabb = Aabb2fx::Expand(aabb, margin);
+	nodes[proxy].userData = userData;
+	InsertLeaf(proxy);
+	++proxyCount;
+	return proxy;
+}
+
+void AabbTree2fx::Remove(int32_t proxy)
+{
+	FXMATH_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].IsLeaf() && nodes[proxy].height == 0
+		&& "Invalid proxy.");
+
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--proxyCount;
+}
+
+bool AabbTree2fx::Move(int32_t proxy, const Aabb2fx& aabb, const Vector2fx& displacement)
+{
+	FXMATH_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].height == 0 && "Invalid proxy.");
+
+	if (Aabb2fx::Contains(nodes[proxy].aabb, aabb))
+	{
+		return false;
+	}
+
+	// Stretch the fat box in the direction of travel
+	Aabb2fx fat = Aabb2fx::Expand(aabb, margin);
+	(displacement.x < fixed::Zero ? fat.min.x : fat.max.x) += displacement.x;
+	(displacement.y < fixed::Zero ? fat.min.y : fat.max.y) += displacement.y;
+
+	RemoveLeaf(proxy);
+	nodes[proxy].aabb = fat;
+	InsertLeaf(proxy);
+	return true;
+}
+
+void AabbTree2fx::InsertLeaf(int32_t leaf)
+{
+	if (root == NullNode)
+	{
+		root = leaf;
+		nodes[leaf].parent = NullNode;
+		return;
+	}
+
+	// Walk down picking the child that grows the least (surface area heuristic, perimeter in 2D)
+	const Aabb2fx leafAabb = nodes[leaf].aabb;
+	int32_t index = root;
+	while (!nodes[index].IsLeaf())
+	{
+		const Node& node = nodes[index];
+		const fixed perimeter = node.aabb.Perimeter();
+		const fixed combinedPerimeter = Aabb2fx::Union(node.aabb, leafAabb).Perimeter();
+
+		// Cost of making a new parent for this node and the leaf, and the minimum cost pushed onto any descendant
+		const fixed cost = combinedPerimeter << 1;
+		const fixed inheritanceCost = (combinedPerimeter - perimeter) << 1;
+
+		auto descendCost = [&](int32_t child) {
+			const Node& childNode = nodes[child];
+			fixed childCost = Aabb2fx::Union(childNode.aabb, leafAabb).Perimeter();
+			if (!childNode.IsLeaf())
+			{
+				childCost -= childNode.aabb.Perimeter();
+			}
+			return childCost + inheritanceCost;
+		};
+		const fixed cost1 = descendCost(node.child1);
+		const fixed cost2 = descendCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+		index = cost1 <= cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling = index;
+	const int32_t oldParent = nodes[sibling].parent;
+	const int32_t newParent = AllocateNode();
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].aabb = Aabb2fx::Union(leafAabb, nodes[sibling].aabb);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].child1 = sibling;
+	nodes[newParent].child2 = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent == NullNode)
+	{
+		root = newParent;
+	}
+	else if (nodes[oldParent].child1 == sibling)
+	{
+		nodes[oldParent].child1 = newParent;
+	}
+	else
+	{
+		nodes[oldParent].child2 = newParent;
+	}
+
+	Refit(nodes[leaf].parent);
+}
+
+void AabbTree2fx::RemoveLeaf(int32_t leaf)
+{
+	if (leaf == root)
+	{
+		root = NullNode;
+		return;
+	}
+
+	const int32_t parent = nodes[leaf].parent;
+	const int32_t grandParent = nodes[parent].parent;
+	const int32_t sibling = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	FreeNode(parent);
+	if (grandParent == NullNode)
+	{
+		root = sibling;
+		nodes[sibling].parent = NullNode;
+		return;
+	}
+
+	if (nodes[grandParent].child1 == parent)
+	{
+		nodes[grandParent].child1 = sibling;
+	}
+	else
+	{
+		nodes[grandParent].child2 = sibling;
+	}
+	nodes[sibling].parent = grandParent;
+	Refit(grandParent);
+}
+
+void AabbTree2fx::Refit(int32_t index)
+{
+	// Rebalance and recompute bounds from index up to the root
+	while (index != NullNode)
+	{
+		index = Balance(index);
+
+		Node& node = nodes[index];
+		const Node& child1 = nodes[node.child1];
+		const Node& child2 = nodes[node.child2];
+		node.height = 1 + std::max(child1.height, child2.height);
+		node.aabb = Aabb2fx::Union(child1.aabb, child2.aabb);
+
+		index = node.parent;
+	}
+}
+
+int32_t AabbTree2fx::Balance(int32_t iA)
+{
+	// If A's subtrees differ in height by more than one, rotate the taller child up to take A's place
+	Node& a = nodes[iA];
+	if (a.IsLeaf() || a.height < 2)
+	{
+		return iA;
+	}
+
+	const int32_t iB = a.child1;
+	const int32_t iC = a.child2;
+	Node& b = nodes[iB];
+	Node& c = nodes[iC];
+	const int32_t balance = c.height - b.height;
+
+	auto replaceInParent = [&](int32_t oldChild, int32_t newChild) {
+		const int32_t parent = nodes[newChild].parent;
+		if (parent == NullNode)
+		{
+			root = newChild;
+		}
+		else if (nodes[parent].child1 == oldChild)
+		{
+			nodes[parent].child1 = newChild;
+		}
+		else
+		{
+			nodes[parent].child2 = newChild;
+		}
+	};
+
+	if (balance > 1)
+	{
+		// Rotate C up
+		const int32_t iF = c.child1;
+		const int32_t iG = c.child2;
+		Node& f = nodes[iF];
+		Node& g = nodes[iG];
+
+		c.child1 = iA;
+		c.parent = a.parent;
+		a.parent = iC;
+		replaceInParent(iA, iC);
+
+		if (f.height > g.height)
+		{
+			c.child2 = iF;
+			a.child2 = iG;
+			g.parent = iA;
+			a.aabb = Aabb2fx::Union(b.aabb, g.aabb);
+			c.aabb = Aabb2fx::Union(a.aabb, f.aabb);
+			a.height = 1 + std::max(b.height, g.height);
+			c.height = 1 + std::max(a.height, f.height);
+		}
+		else
+		{
+			c.child2 = iG;
+			a.child2 = iF;
+			f.parent = iA;
+			a.aabb = Aabb2fx::Union(b.aabb, f.aabb);
+			c.aabb = Aabb2fx::Union(a.aabb, g.aabb);
+			a.height = 1 + std::max(b.height, f.height);
+			c.height = 1 + std::max(a.height, g.height);
+		}
+		return iC;
+	}
+
+	if (balance < -1)
+	{
+		// Rotate B up
+		const int32_t iD = b.child1;
+		const int32_t iE = b.child2;
+		Node& d = nodes[iD];
+		Node& e = nodes[iE];
+
+		b.child1 = iA;
+		b.parent = a.parent;
+		a.parent = iB;
+		replaceInParent(iA, iB);
+
+		if (d.height > e.height)
+		{
+			b.child2 = iD;
+			a.child1 = iE;
+			e.parent = iA;
+			a.aabb = Aabb2fx::Union(c.aabb, e.aabb);
+			b.aabb = Aabb2fx::Union(a.aabb, d.aabb);
+			a.height = 1 + std::max(c.height, e.height);
+			b.height = 1 + std::max(a.height, d.height);
+		}
+		else
+		{
+			b.child2 = iE;
+			a.child1 = iD;
+			d.parent = iA;
+			a.aabb = Aabb2fx::Union(c.aabb, d.aabb);
+			b.aabb = Aabb2fx::Union(a.aabb, e.aabb);
+			a.height = 1 + std::max(c.height, d.height);
+			b.height = 1 + std::max(a.height, e.height);
+		}
+		return iB;
+	}
+
+	return iA;
+}
+
+template <typename Callback>
+void AabbTree2fx::Query(const Aabb2fx& aabb, Callback&& callback) const
+{
+	if (root == NullNode)
+	{
+		return;
+	}
+
+	NodeStack stack;
+	stack.Push(root);
+	while (!stack.Empty())
+	{
+		const Node& node = nodes[stack.Pop()];
+		if (!Aabb2fx::Overlaps(node.aabb, aabb))
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (!callback(static_cast<int32_t>(&node - nodes.data())))
+			{
+				return;
+			}
+		}
+		else
+		{
+			stack.Push(node.child2);
+			stack.Push(node.child1);
+		}
+	}
+}
+
+void AabbTree2fx::Query(const Aabb2fx& aabb, std::vector<int32_t>& out) const
+{
+	Query(aabb, [&out](int32_t proxy) {
+		out.push_back(proxy);
+		return true;
+	});
+}
+
+template <typename Callback>
+void AabbTree2fx::RayCast(const Vector2fx& from, const Vector2fx& to, Callback&& callback) const
+{
+	if (root == NullNode)
+	{
+		return;
+	}
+
+	// A box misses the segment when it misses the segment's bounds or lies entirely on one side of the line,
+	// |dot(n, from - center)| > dot(|n|, extents) with n perpendicular to the segment. Everything is doubled so the
+	// center and extents stay exact, and the dot products are taken at full width.
+	const Aabb2fx segmentBounds = Aabb2fx::Union(Aabb2fx(from, from), to);
+	const int64_t nx = from.y.rawValue - to.y.rawValue;
+	const int64_t ny = to.x.rawValue - from.x.rawValue;
+	const int64_t absNx = nx < 0 ? -nx : nx;
+	const int64_t absNy = ny < 0 ? -ny : ny;
+	const int64_t fromX2 = from.x.rawValue * 2;
+	const int64_t fromY2 = from.y.rawValue * 2;
+
+	NodeStack stack;
+	stack.Push(root);
+	while (!stack.Empty())
+	{
+		const Node& node = nodes[stack.Pop()];
+		if (!Aabb2fx::Overlaps(node.aabb, segmentBounds))
+		{
+			continue;
+		}
+
+		const Int128 separation = Int128::Mul(nx, fromX2 - (node.aabb.min.x.rawValue + node.aabb.max.x.rawValue))
+			+ Int128::Mul(ny, fromY2 - (node.aabb.min.y.rawValue + node.aabb.max.y.rawValue));
+		const Int128 reach = Int128::Mul(absNx, node.aabb.max.x.rawValue - node.aabb.min.x.rawValue)
+			+ Int128::Mul(absNy, node.aabb.max.y.rawValue - node.aabb.min.y.rawValue);
+		if ((separation.IsNegative() ? -separation : separation) > reach)
+		{
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (!callback(static_cast<int32_t>(&node - nodes.data())))
+			{
+				return;
+			}
+		}
+		else
+		{
+			stack.Push(node.child2);
+			stack.Push(node.child1);
+		}
+	}
+}
+
+void AabbTree2fx::RayCast(const Vector2fx& from, const Vector2fx& to, std::vector<int32_t>& out) const
+{
+	RayCast(from, to, [&out](int32_t proxy) {
+		out.push_back(proxy);
+		return true;
+	});
+}
+
+void AabbTree2fx::OverlapPairs(std::vector<std::pair<int32_t, int32_t>>& out) const
+{
+	// Query every leaf against the tree in pool order, keeping only pairs where the other proxy is larger
+	for (int32_t proxy = 0; proxy < static_cast<int32_t>(nodes.size()); ++proxy)
+	{
+		if (nodes[proxy].height != 0)
+		{
+			continue;
+		}
+
+		Query(nodes[proxy].aabb, [&out, proxy](int32_t other) {
+			if (other > proxy)
+			{
+				out.emplace_back(proxy, other);
+			}
+			return true;
+		});
+	}
+}
+
+bool AabbTree2fx::Validate() const
+{
+	if (root == NullNode)
+	{
+		return proxyCount == 0;
+	}
+
+	size_t leaves = 0;
+	for (const Node& node : nodes)
+	{
+		leaves += node.height == 0 ? 1 : 0;
+	}
+	return leaves == proxyCount && nodes[root].parent == NullNode && ValidateNode(root, NullNode);
+}
+
+bool AabbTree2fx::ValidateNode(int32_t index, int32_t parent) const
+{
+	const Node& node = nodes[index];
+	if (node.parent != parent)
+	{
+		return false;
+	}
+	if (node.IsLeaf())
+	{
+		return node.height == 0;
+	}
+
+	const Node& child1 = nodes[node.child1];
+	const Node& child2 = nodes[node.child2];
+	return node.height == 1 + std::max(child1.height, child2.height)
+		&& node.aabb == Aabb2fx::Union(child1.aabb, child2.aabb)
+		&& ValidateNode(node.child1, index)
+		&& ValidateNode(node.child2, index);
+}
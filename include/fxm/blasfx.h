@@ -0,0 +1,385 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+
+// BLAS level 1 kernels over spans of fixed point values. Sums are taken over the exact products or magnitudes at full
+// width and rounded and saturated once at the end, so every result is independent of the order of the terms and
+// bit-identical with or without AVX2. fixed32 and fixed64 have AVX2 paths, other types run the scalar loops.
+namespace Mathfx
+{
+	namespace internal
+	{
+		template <typename T>
+		constexpr std::make_unsigned_t<T> RawMagnitude(T raw)
+		{
+			using uraw = std::make_unsigned_t<T>;
+			return raw < 0 ? static_cast<uraw>(static_cast<uraw>(0) - static_cast<uraw>(raw)) : static_cast<uraw>(raw);
+		}
+
+#if FXMATH_AVX2
+		// |x| per fixed64 lane as unsigned, MinValue gives 2^63
+		inline __m256i RawMagnitude4(__m256i x)
+		{
+			const __m256i sign = _mm256_cmpgt_epi64(_mm256_setzero_si256(), x);
+			return _mm256_sub_epi64(_mm256_xor_si256(x, sign), sign);
+		}
+
+		// Unsigned per lane maximum of four 64 bit values
+		inline __m256i MaxUnsigned4(__m256i a, __m256i b)
+		{
+			return _mm256_blendv_epi8(b, a, Mathfx::simd::GreaterEqualUnsigned4(a, b));
+		}
+
+		// Adds the low and high 32 bit halves of four unsigned 64 bit values to separate 64 bit lane sums,
+		// low + (high << 32) is then the exact total as long as there are fewer than 2^31 values per lane
+		inline void AddSplit4(__m256i& low, __m256i& high, __m256i x)
+		{
+			low = _mm256_add_epi64(low, _mm256_and_si256(x, _mm256_set1_epi64x(0xFFFFFFFF)));
+			high = _mm256_add_epi64(high, _mm256_srli_epi64(x, 32));
+		}
+
+		inline Int128 CombineSplit4(__m256i low, __m256i high)
+		{
+			uint64_t lows[4];
+			uint64_t highs[4];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lows), low);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(highs), high);
+			Int128 sum;
+			for (int i = 0; i < 4; ++i)
+			{
+				sum += Int128(0, lows[i]);
+				sum += Int128(highs[i] >> 32, highs[i] << 32);
+			}
+			return sum;
+		}
+#endif
+	}
+
+	/**
+	 * \brief Sum of x[i] * y[i], exact in 128 bits until the one rounding towards negative infinity and saturation at the
+	 * end, a full scale fixed32 product is already 2^62 so the sum can't be kept in 64 bits.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Dot(std::span<const Fixed<T, F>> x, std::span<const Fixed<T, F>> y)
+	{
+		static_assert(sizeof(T) <= 8, "Dot sums products in 128 bits.");
+		FXMATH_ASSERT(x.size() == y.size() && "Spans must be the same length.");
+
+		using fixed = Fixed<T, F>;
+
+		Int128 sum;
+		size_t i = 0;
+#if FXMATH_AVX2
+		// fixed64 products need 128 bits, which AVX2 can't multiply, so only fixed32 has a vector path
+		if constexpr (std::is_same_v<fixed, fixed32>)
+		{
+			__m256i low = _mm256_setzero_si256();
+			__m256i high = _mm256_setzero_si256();
+			for (; i + 8 <= x.size(); i += 8)
+			{
+				Mathfx::simd::WideMulAdd8(low, high, Mathfx::simd::Load8(&x[i]), Mathfx::simd::Load8(&y[i]));
+			}
+			sum = Mathfx::simd::CombineSplitSigned4(low, high);
+		}
+#endif
+		for (; i < x.size(); ++i)
+		{
+			sum += Int128::Mul(x[i].rawValue, y[i].rawValue);
+		}
+		sum >>= F;
+		if (sum > Int128(static_cast<int64_t>(fixed::RawMaxValue)))
+		{
+			return fixed::MaxValue;
+		}
+		if (sum < Int128(static_cast<int64_t>(fixed::RawMinValue)))
+		{
+			return fixed::MinValue;
+		}
+		return fixed(static_cast<typename fixed::raw>(sum.Low()));
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Dot(std::span<Fixed<T, F>> x, std::span<Fixed<T, F>> y)
+	{
+		return Dot(std::span<const Fixed<T, F>>(x), std::span<const Fixed<T, F>>(y));
+	}
+
+	/**
+	 * \brief y[i] += a * x[i], bit-identical to the same loop written with operator* and operator+=.
+	 */
+	template <typename T, int F>
+	void Axpy(Fixed<T, F> a, std::type_identity_t<std::span<const Fixed<T, F>>> x, std::span<Fixed<T, F>> y)
+	{
+		FXMATH_ASSERT(x.size() == y.size() && "Spans must be the same length.");
+
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			const __m256i scale = Mathfx::simd::Splat8(a);
+			for (; i + 8 <= x.size(); i += 8)
+			{
+				Mathfx::simd::Store8(&y[i], _mm256_add_epi32(Mathfx::simd::Load8(&y[i]), Mathfx::simd::FastMul8(scale, Mathfx::simd::Load8(&x[i]))));
+			}
+		}
+		else if constexpr (std::is_same_v<Fixed<T, F>, fixed64>)
+		{
+			const __m256i scale = Mathfx::simd::Splat4(a);
+			for (; i + 4 <= x.size(); i += 4)
+			{
+				Mathfx::simd::Store4(&y[i], _mm256_add_epi64(Mathfx::simd::Load4(&y[i]), Mathfx::simd::FastMul4(scale, Mathfx::simd::Load4(&x[i]))));
+			}
+		}
+#endif
+		for (; i < x.size(); ++i)
+		{
+			y[i] += a * x[i];
+		}
+	}
+
+	/**
+	 * \brief x[i] = a * x[i], bit-identical to operator*.
+	 */
+	template <typename T, int F>
+	void Scal(Fixed<T, F> a, std::span<Fixed<T, F>> x)
+	{
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			const __m256i scale = Mathfx::simd::Splat8(a);
+			for (; i + 8 <= x.size(); i += 8)
+			{
+				Mathfx::simd::Store8(&x[i], Mathfx::simd::FastMul8(scale, Mathfx::simd::Load8(&x[i])));
+			}
+		}
+		else if constexpr (std::is_same_v<Fixed<T, F>, fixed64>)
+		{
+			const __m256i scale = Mathfx::simd::Splat4(a);
+			for (; i + 4 <= x.size(); i += 4)
+			{
+				Mathfx::simd::Store4(&x[i], Mathfx::simd::FastMul4(scale, Mathfx::simd::Load4(&x[i])));
+			}
+		}
+#endif
+		for (; i < x.size(); ++i)
+		{
+			x[i] = a * x[i];
+		}
+	}
+
+	/**
+	 * \brief Euclidean norm sqrt(sum x[i]^2) rounded down, the generalization of Hypot: the squares are summed exactly in
+	 * 128 bits and only the square root is rounded, so nothing overflows on the way and only a norm past MaxValue
+	 * saturates. No scaling pass is needed like with floating point.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Nrm2(std::span<const Fixed<T, F>> x)
+	{
+		static_assert(sizeof(T) <= 8, "Nrm2 sums squares in 128 bits.");
+
+		Int128 sum;
+		size_t i = 0;
+		if constexpr (sizeof(T) == 8)
+		{
+			// Squares are below 2^126, once the sum reaches 2^126 the norm is past the range anyway and stopping there
+			// also keeps the unsigned sum from wrapping
+			for (; i < x.size(); ++i)
+			{
+				sum += Int128::Mul(x[i].rawValue, x[i].rawValue);
+				if (sum.hi >= (static_cast<uint64_t>(1) << 62))
+				{
+					return Fixed<T, F>::MaxValue;
+				}
+			}
+		}
+		else
+		{
+#if FXMATH_AVX2
+			if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+			{
+				__m256i low = _mm256_setzero_si256();
+				__m256i high = _mm256_setzero_si256();
+				for (; i + 8 <= x.size(); i += 8)
+				{
+					const __m256i values = Mathfx::simd::Load8(&x[i]);
+					const __m256i odd = _mm256_srli_epi64(values, 32);
+					internal::AddSplit4(low, high, _mm256_mul_epi32(values, values));
+					internal::AddSplit4(low, high, _mm256_mul_epi32(odd, odd));
+				}
+				sum = internal::CombineSplit4(low, high);
+			}
+#endif
+			for (; i < x.size(); ++i)
+			{
+				sum += Int128(static_cast<int64_t>(x[i].rawValue) * x[i].rawValue);
+			}
+		}
+		return WideSqrt<T, F>(sum);
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Nrm2(std::span<Fixed<T, F>> x)
+	{
+		return Nrm2(std::span<const Fixed<T, F>>(x));
+	}
+
+	/**
+	 * \brief Sum of |x[i]|, exact and saturated once to MaxValue.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Asum(std::span<const Fixed<T, F>> x)
+	{
+		static_assert(sizeof(T) <= 8, "Asum sums magnitudes in 128 bits.");
+
+		using fixed = Fixed<T, F>;
+
+		Int128 sum;
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<fixed, fixed32>)
+		{
+			// abs of MinValue stays 0x80000000, which read as unsigned is the right magnitude
+			const __m256i lowMask = _mm256_set1_epi64x(0xFFFFFFFF);
+			__m256i lanes = _mm256_setzero_si256();
+			for (; i + 8 <= x.size(); i += 8)
+			{
+				const __m256i magnitudes = _mm256_abs_epi32(Mathfx::simd::Load8(&x[i]));
+				lanes = _mm256_add_epi64(lanes, _mm256_and_si256(magnitudes, lowMask));
+				lanes = _mm256_add_epi64(lanes, _mm256_srli_epi64(magnitudes, 32));
+			}
+			sum = Int128(Mathfx::simd::HorizontalSum4(lanes));
+		}
+		else if constexpr (std::is_same_v<fixed, fixed64>)
+		{
+			__m256i low = _mm256_setzero_si256();
+			__m256i high = _mm256_setzero_si256();
+			for (; i + 4 <= x.size(); i += 4)
+			{
+				internal::AddSplit4(low, high, internal::RawMagnitude4(Mathfx::simd::Load4(&x[i])));
+			}
+			sum = internal::CombineSplit4(low, high);
+		}
+#endif
+		for (; i < x.size(); ++i)
+		{
+			sum += Int128(0, static_cast<uint64_t>(internal::RawMagnitude(x[i].rawValue)));
+		}
+		return sum > Int128(static_cast<int64_t>(fixed::RawMaxValue)) ? fixed::MaxValue : fixed(static_cast<typename fixed::raw>(sum.Low()));
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Asum(std::span<Fixed<T, F>> x)
+	{
+		return Asum(std::span<const Fixed<T, F>>(x));
+	}
+
+	/**
+	 * \brief Index of the first value with the largest magnitude, MinValue counts as larger than MaxValue.
+	 * \param x Must not be empty
+	 */
+	template <typename T, int F>
+	size_t IAmax(std::span<const Fixed<T, F>> x)
+	{
+		using uraw = typename Fixed<T, F>::uraw;
+
+		FXMATH_ASSERT(!x.empty() && "IAmax needs at least one value.");
+
+		// The vector paths find the largest magnitude first and then search for its first occurrence, which keeps the
+		// lanes independent and still gives the first index like the scalar loop
+		uraw largest = 0;
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			__m256i lanes = _mm256_setzero_si256();
+			for (; i + 8 <= x.size(); i += 8)
+			{
+				lanes = _mm256_max_epu32(lanes, _mm256_abs_epi32(Mathfx::simd::Load8(&x[i])));
+			}
+			alignas(32) uint32_t values[8];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(values), lanes);
+			largest = *std::max_element(std::begin(values), std::end(values));
+		}
+		else if constexpr (std::is_same_v<Fixed<T, F>, fixed64>)
+		{
+			__m256i lanes = _mm256_setzero_si256();
+			for (; i + 4 <= x.size(); i += 4)
+			{
+				lanes = internal::MaxUnsigned4(lanes, internal::RawMagnitude4(Mathfx::simd::Load4(&x[i])));
+			}
+			alignas(32) uint64_t values[4];
+			_mm256_store_si256(reinterpret_cast<__m256i*>(values), lanes);
+			largest = *std::max_element(std::begin(values), std::end(values));
+		}
+		if (i > 0)
+		{
+			for (; i < x.size(); ++i)
+			{
+				largest = std::max(largest, internal::RawMagnitude(x[i].rawValue));
+			}
+
+			i = 0;
+			if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+			{
+				const __m256i target = _mm256_set1_epi32(static_cast<int32_t>(largest));
+				for (; i + 8 <= x.size(); i += 8)
+				{
+					const __m256i equal = _mm256_cmpeq_epi32(_mm256_abs_epi32(Mathfx::simd::Load8(&x[i])), target);
+					const int mask = _mm256_movemask_ps(_mm256_castsi256_ps(equal));
+					if (mask != 0)
+					{
+						return i + std::countr_zero(static_cast<unsigned>(mask));
+					}
+				}
+			}
+			else if constexpr (std::is_same_v<Fixed<T, F>, fixed64>)
+			{
+				const __m256i target = _mm256_set1_epi64x(static_cast<int64_t>(largest));
+				for (; i + 4 <= x.size(); i += 4)
+				{
+					const __m256i equal = _mm256_cmpeq_epi64(internal::RawMagnitude4(Mathfx::simd::Load4(&x[i])), target);
+					const int mask = _mm256_movemask_pd(_mm256_castsi256_pd(equal));
+					if (mask != 0)
+					{
+						return i + std::countr_zero(static_cast<unsigned>(mask));
+					}
+				}
+			}
+			for (; i < x.size(); ++i)
+			{
+				if (internal::RawMagnitude(x[i].rawValue) == largest)
+				{
+					return i;
+				}
+			}
+		}
+#endif
+		size_t index = 0;
+		for (i = 0; i < x.size(); ++i)
+		{
+			const uraw magnitude = internal::RawMagnitude(x[i].rawValue);
+			if (magnitude > largest)
+			{
+				largest = magnitude;
+				index = i;
+			}
+		}
+		return index;
+	}
+
+	template <typename T, int F>
+	size_t IAmax(std::span<Fixed<T, F>> x)
+	{
+		return IAmax(std::span<const Fixed<T, F>>(x));
+	}
+}
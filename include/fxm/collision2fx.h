@@ -0,0 +1,486 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+#include "rotation2fx.h"
+#include "predicates2fx.h"
+#include "shapes2fx.h"
+
+namespace Mathfx
+{
+	namespace internal
+	{
+		using Projection2fx = FixedAccumulator<int64_t, 32>;
+
+		// Dot(axis, point) with both products kept at full width, projections of far away points onto an axis can be
+		// compared and subtracted without overflowing or rounding, only the final separation is truncated
+		inline Projection2fx Project(const Vector2fx& axis, const Vector2fx& point)
+		{
+			Projection2fx projection;
+			projection.MulAdd(axis.x, point.x);
+			projection.MulAdd(axis.y, point.y);
+			return projection;
+		}
+
+		// Square root of a squared length made by Project. Squared lengths from 1 up to what fits in fixed64 go through FastSqrt
+		// like Vector2fx::Magnitude. Larger ones would overflow and smaller ones lose most of their bits when truncated, those get
+		// the exact square root of the 128 bit value instead.
+		inline fixed64 Length(const Projection2fx& squared)
+		{
+			if ((squared.value >> 32).FitsInt64() && squared.Result() >= fixed64::One)
+			{
+				return FastSqrt(squared.Result());
+			}
+
+			return WideSqrt<int64_t, 32>(squared.value);
+		}
+
+		inline Projection2fx Separation(const Projection2fx& projection, const Projection2fx& plane)
+		{
+			Projection2fx separation = projection;
+			separation.value -= plane.value;
+			return separation;
+		}
+	}
+}
+
+/**
+ * \brief Convex polygon with counter clockwise vertices, up to MaxVertices of them.
+ * Everything the separating axis tests need per polygon is computed once here: the outward unit normal of every edge
+ * and every edge's plane offset Dot(normal, vertex) at full width. Build the world space polygon once per tick with
+ * Transform and reuse it for all of its collision tests.
+ */
+struct Polygon2fx
+{
+	using fixed = fixed64;
+	using Projection = Mathfx::internal::Projection2fx;
+
+	static constexpr int MaxVertices = 8;
+
+	// Edge i goes from vertices[i] to vertices[i + 1], normals[i] and planes[i] belong to it
+	std::array<Vector2fx, MaxVertices> vertices {};
+	std::array<Vector2fx, MaxVertices> normals {};
+	std::array<Projection, MaxVertices> planes {};
+	int count = 0;
+
+	// constructors
+	Polygon2fx() = default;
+
+	/**
+	 * \param points Between 3 and MaxVertices points of a strictly convex polygon in counter clockwise order.
+	 */
+	explicit Polygon2fx(std::span<const Vector2fx> points);
+
+	// static methods
+	static Polygon2fx Box(const Vector2fx& halfExtents);
+	static Polygon2fx FromAabb(const Aabb2fx& box);
+
+	/**
+	 * \brief Rotates then translates the polygon. Normals are rotated rather than recomputed from the rotated edges,
+	 * which keeps them exactly as long as the rotation's sin and cos allow.
+	 */
+	static Polygon2fx Transform(const Polygon2fx& polygon, const Rotation2fx& rotation, const Vector2fx& translation);
+
+	// instance methods
+	/**
+	 * \brief Index of the vertex furthest along \p direction, the lowest index on ties.
+	 */
+	int Support(const Vector2fx& direction) const;
+	Aabb2fx Bounds() const;
+
+private:
+	void UpdatePlanes();
+};
+
+/**
+ * \brief Result of a collision test between shape a and shape b.
+ * The normal is a unit vector pointing from a to b, moving b by normal * depth separates the shapes.
+ * Contact points lie on the incident feature, the part of one shape that reaches into the other, each with its own depth.
+ */
+struct Manifold2fx
+{
+	using fixed = fixed64;
+
+	struct Point
+	{
+		Vector2fx position;
+		fixed depth;
+
+		// Which features produced the point, the same from tick to tick while they stay in contact so solvers can match
+		// points up for warm starting
+		uint32_t id = 0;
+	};
+
+	Vector2fx normal;
+	fixed depth;
+	std::array<Point, 2> points {};
+	int pointCount = 0;
+};
+
+/**
+ * \brief Separating axis collision tests between convex polygons and circles.
+ * Every axis projection is made with full width products, so there is no intermediate overflow or rounding in the
+ * separation tests themselves and the result is the same on every platform. Touching shapes count as colliding.
+ */
+struct Collision2fx
+{
+	using fixed = fixed64;
+
+	// A face of b only becomes the reference face when it separates more than a face of a by this much, which stops the
+	// reference face from flip-flopping between ticks when two faces are almost parallel. 2^-10, about a thousandth of a unit
+	static constexpr fixed ReferenceFaceTolerance = fixed(static_cast<int64_t>(1) << 22);
+
+	/**
+	 * \brief Fills \p manifold and returns true when the shapes overlap, \p manifold is left untouched otherwise.
+	 */
+	static bool Collide(const Polygon2fx& a, const Polygon2fx& b, Manifold2fx& manifold);
+	static bool Collide(const Polygon2fx& a, const Circle2fx& b, Manifold2fx& manifold);
+	static bool Collide(const Circle2fx& a, const Polygon2fx& b, Manifold2fx& manifold);
+	static bool Collide(const Circle2fx& a, const Circle2fx& b, Manifold2fx& manifold);
+
+private:
+	using Projection = Mathfx::internal::Projection2fx;
+
+	struct ClipVertex
+	{
+		Vector2fx position;
+		uint32_t id;
+	};
+
+	static Projection MaxSeparation(const Polygon2fx& a, const Polygon2fx& b, int& edge);
+	static int ClipSegment(const std::array<ClipVertex, 2>& in, std::array<ClipVertex, 2>& out, const Vector2fx& normal,
+		const Projection& offset, uint32_t clipId);
+};
+
+Polygon2fx::Polygon2fx(std::span<const Vector2fx> points)
+{
+	FXMATH_ASSERT(points.size() >= 3 && points.size() <= MaxVertices && "Polygon needs between 3 and MaxVertices vertices.");
+
+	count = static_cast<int>(points.size());
+	for (int i = 0; i < count; ++i)
+	{
+		vertices[i] = points[i];
+	}
+	for (int i = 0; i < count; ++i)
+	{
+		FXMATH_ASSERT(Mathfx::Orient2D(vertices[i], vertices[(i + 1) % count], vertices[(i + 2) % count]) > 0
+			&& "Polygon must be strictly convex and counter clockwise.");
+
+		// Edge rotated clockwise points out of a counter clockwise polygon
+		Vector2fx edge = vertices[(i + 1) % count] - vertices[i];
+		normals[i] = Vector2fx::Normalize(Vector2fx(edge.y, -edge.x));
+	}
+	UpdatePlanes();
+}
+
+Polygon2fx Polygon2fx::Box(const Vector2fx& halfExtents)
+{
+	return FromAabb(Aabb2fx(-halfExtents, halfExtents));
+}
+
+Polygon2fx Polygon2fx::FromAabb(const Aabb2fx& box)
+{
+	// Axis aligned normals are exact, no need to normalize
+	Polygon2fx polygon;
+	polygon.count = 4;
+	polygon.vertices = { box.min, Vector2fx(box.max.x, box.min.y), box.max, Vector2fx(box.min.x, box.max.y) };
+	polygon.normals = { Vector2fx::Down, Vector2fx::Right, Vector2fx::Up, Vector2fx::Left };
+	polygon.UpdatePlanes();
+	return polygon;
+}
+
+Polygon2fx Polygon2fx::Transform(const Polygon2fx& polygon, const Rotation2fx& rotation, const Vector2fx& translation)
+{
+	Polygon2fx result;
+	result.count = polygon.count;
+	for (int i = 0; i < polygon.count; ++i)
+	{
+		result.vertices[i] = Rotation2fx::Rotate(rotation, polygon.vertices[i]) + translation;
+		result.normals[i] = Rotation2fx::Rotate(rotation, polygon.normals[i]);
+	}
+	result.UpdatePlanes();
+	return result;
+}
+
+void Polygon2fx::UpdatePlanes()
+{
+	for (int i = 0; i < count; ++i)
+	{
+		planes[i] = Mathfx::internal::Project(normals[i], vertices[i]);
+	}
+}
+
+int Polygon2fx::Support(const Vector2fx& direction) const
+{
+	int best = 0;
+	Projection bestProjection = Mathfx::internal::Project(direction, vertices[0]);
+	for (int i = 1; i < count; ++i)
+	{
+		Projection projection = Mathfx::internal::Project(direction, vertices[i]);
+		if (projection.value > bestProjection.value)
+		{
+			best = i;
+			bestProjection = projection;
+		}
+	}
+	return best;
+}
+
+Aabb2fx Polygon2fx::Bounds() const
+{
+	Aabb2fx bounds(vertices[0], vertices[0]);
+	for (int i = 1; i < count; ++i)
+	{
+		bounds = Aabb2fx::Union(bounds, vertices[i]);
+	}
+	return bounds;
+}
+
+Collision2fx::Projection Collision2fx::MaxSeparation(const Polygon2fx& a, const Polygon2fx& b, int& edge)
+{
+	// Separation along a face normal of a is how far the deepest vertex of b is in front of that face
+	Projection best;
+	for (int i = 0; i < a.count; ++i)
+	{
+		Projection separation = Mathfx::internal::Project(a.normals[i], b.vertices[0]);
+		for (int j = 1; j < b.count; ++j)
+		{
+			Projection projection = Mathfx::internal::Project(a.normals[i], b.vertices[j]);
+			if (projection.value < separation.value)
+			{
+				separation = projection;
+			}
+		}
+		separation.value -= a.planes[i].value;
+
+		if (i == 0 || separation.value > best.value)
+		{
+			best = separation;
+			edge = i;
+		}
+	}
+	return best;
+}
+
+int Collision2fx::ClipSegment(const std::array<ClipVertex, 2>& in, std::array<ClipVertex, 2>& out, const Vector2fx& normal,
+	const Projection& offset, uint32_t clipId)
+{
+	// Keeps the part of the segment behind the plane Dot(normal, p) = offset
+	const fixed distance0 = Mathfx::internal::Separation(Mathfx::internal::Project(normal, in[0].position), offset).Result();
+	const fixed distance1 = Mathfx::internal::Separation(Mathfx::internal::Project(normal, in[1].position), offset).Result();
+
+	int count = 0;
+	if (distance0 <= fixed::Zero)
+	{
+		out[count++] = in[0];
+	}
+	if (distance1 <= fixed::Zero)
+	{
+		out[count++] = in[1];
+	}
+
+	if ((distance0 < fixed::Zero && distance1 > fixed::Zero) || (distance0 > fixed::Zero && distance1 < fixed::Zero))
+	{
+		const fixed t = distance0 / (distance0 - distance1);
+		out[count++] = ClipVertex { in[0].position + (in[1].position - in[0].position) * t, clipId };
+	}
+	return count;
+}
+
+bool Collision2fx::Collide(const Polygon2fx& a, const Polygon2fx& b, Manifold2fx& manifold)
+{
+	FXMATH_ASSERT(a.count >= 3 && b.count >= 3 && "Polygons must have at least 3 vertices.");
+
+	int edgeA = 0;
+	const Projection separationA = MaxSeparation(a, b, edgeA);
+	if (separationA.value > Int128(0))
+	{
+		return false;
+	}
+
+	int edgeB = 0;
+	const Projection separationB = MaxSeparation(b, a, edgeB);
+	if (separationB.value > Int128(0))
+	{
+		return false;
+	}
+
+	// The face that separates the most is the reference face, the other polygon's most opposing face is the incident one
+	Projection tolerance;
+	tolerance.Add(ReferenceFaceTolerance);
+	const bool flip = separationB.value > separationA.value + tolerance.value;
+	const Polygon2fx& reference = flip ? b : a;
+	const Polygon2fx& incident = flip ? a : b;
+	const int referenceEdge = flip ? edgeB : edgeA;
+	const Vector2fx& normal = reference.normals[referenceEdge];
+
+	int incidentEdge = 0;
+	Projection minDot = Mathfx::internal::Project(normal, incident.normals[0]);
+	for (int i = 1; i < incident.count; ++i)
+	{
+		Projection dot = Mathfx::internal::Project(normal, incident.normals[i]);
+		if (dot.value < minDot.value)
+		{
+			minDot = dot;
+			incidentEdge = i;
+		}
+	}
+
+	// Point ids are the reference edge in the low byte, then the incident vertex or the side plane that clipped the point,
+	// then whether it was clipped and whether a and b swapped roles
+	const uint32_t baseId = static_cast<uint32_t>(referenceEdge) | (flip ? 0x20000u : 0u);
+	const int incidentNext = (incidentEdge + 1) % incident.count;
+	const std::array<ClipVertex, 2> incidentPoints = {
+		ClipVertex { incident.vertices[incidentEdge], baseId | (static_cast<uint32_t>(incidentEdge) << 8) },
+		ClipVertex { incident.vertices[incidentNext], baseId | (static_cast<uint32_t>(incidentNext) << 8) },
+	};
+
+	// Clip the incident edge to the side planes of the reference face, the tangent runs along the reference edge
+	const int referenceNext = (referenceEdge + 1) % reference.count;
+	const Vector2fx tangent(-normal.y, normal.x);
+	std::array<ClipVertex, 2> clipped1 {};
+	std::array<ClipVertex, 2> clipped2 {};
+	Projection sideStart = Mathfx::internal::Project(tangent, reference.vertices[referenceEdge]);
+	sideStart.value = -sideStart.value;
+	if (ClipSegment(incidentPoints, clipped1, -tangent, sideStart, baseId | 0x10000u) < 2)
+	{
+		return false;
+	}
+	const Projection sideEnd = Mathfx::internal::Project(tangent, reference.vertices[referenceNext]);
+	if (ClipSegment(clipped1, clipped2, tangent, sideEnd, baseId | 0x10000u | 0x100u) < 2)
+	{
+		return false;
+	}
+
+	// Keep the clipped points that are behind the reference face
+	Manifold2fx result;
+	result.normal = flip ? -normal : normal;
+	result.depth = -(flip ? separationB : separationA).Result();
+	for (const ClipVertex& vertex : clipped2)
+	{
+		const Projection separation = Mathfx::internal::Separation(Mathfx::internal::Project(normal, vertex.position), reference.planes[referenceEdge]);
+		if (separation.value <= Int128(0))
+		{
+			result.points[result.pointCount++] = Manifold2fx::Point { vertex.position, -separation.Result(), vertex.id };
+		}
+	}
+	if (result.pointCount == 0)
+	{
+		return false;
+	}
+
+	manifold = result;
+	return true;
+}
+
+bool Collision2fx::Collide(const Polygon2fx& a, const Circle2fx& b, Manifold2fx& manifold)
+{
+	FXMATH_ASSERT(a.count >= 3 && "Polygon must have at least 3 vertices.");
+
+	// Face the circle center is furthest in front of
+	int edge = 0;
+	Projection separation = Mathfx::internal::Separation(Mathfx::internal::Project(a.normals[0], b.center), a.planes[0]);
+	for (int i = 1; i < a.count; ++i)
+	{
+		Projection candidate = Mathfx::internal::Separation(Mathfx::internal::Project(a.normals[i], b.center), a.planes[i]);
+		if (candidate.value > separation.value)
+		{
+			separation = candidate;
+			edge = i;
+		}
+	}
+
+	Projection radius;
+	radius.Add(b.radius);
+	if (separation.value > radius.value)
+	{
+		return false;
+	}
+
+	Vector2fx normal = a.normals[edge];
+	fixed depth = b.radius - separation.Result();
+	uint32_t id = static_cast<uint32_t>(edge);
+
+	// A center outside the polygon can be closest to one of the face's end points rather than the face itself
+	if (separation.value > Int128(0))
+	{
+		const int next = (edge + 1) % a.count;
+		const Vector2fx& vertex1 = a.vertices[edge];
+		const Vector2fx& vertex2 = a.vertices[next];
+		const Vector2fx* corner = nullptr;
+		if (Mathfx::internal::Project(b.center - vertex1, vertex2 - vertex1).value <= Int128(0))
+		{
+			corner = &vertex1;
+			id = static_cast<uint32_t>(edge) | 0x10000u;
+		}
+		else if (Mathfx::internal::Project(b.center - vertex2, vertex1 - vertex2).value <= Int128(0))
+		{
+			corner = &vertex2;
+			id = static_cast<uint32_t>(next) | 0x10000u;
+		}
+
+		if (corner)
+		{
+			const Vector2fx offset = b.center - *corner;
+			Projection radiusSquared;
+			radiusSquared.MulAdd(b.radius, b.radius);
+			if (Mathfx::internal::Project(offset, offset).value > radiusSquared.value)
+			{
+				return false;
+			}
+
+			const fixed distance = Mathfx::internal::Length(Mathfx::internal::Project(offset, offset));
+			if (distance > fixed::Zero)
+			{
+				normal = offset / distance;
+			}
+			depth = b.radius - distance;
+		}
+	}
+
+	manifold.normal = normal;
+	manifold.depth = depth;
+	manifold.points[0] = Manifold2fx::Point { b.center - normal * b.radius, depth, id };
+	manifold.pointCount = 1;
+	return true;
+}
+
+bool Collision2fx::Collide(const Circle2fx& a, const Polygon2fx& b, Manifold2fx& manifold)
+{
+	if (!Collide(b, a, manifold))
+	{
+		return false;
+	}
+	manifold.normal = -manifold.normal;
+	manifold.points[0].id |= 0x20000u;
+	return true;
+}
+
+bool Collision2fx::Collide(const Circle2fx& a, const Circle2fx& b, Manifold2fx& manifold)
+{
+	const Vector2fx offset = b.center - a.center;
+	const fixed radii = a.radius + b.radius;
+	const Projection distanceSquared = Mathfx::internal::Project(offset, offset);
+	Projection radiiSquared;
+	radiiSquared.MulAdd(radii, radii);
+	if (distanceSquared.value > radiiSquared.value)
+	{
+		return false;
+	}
+
+	// Concentric circles have no preferred direction, push along x
+	const fixed distance = Mathfx::internal::Length(distanceSquared);
+	const Vector2fx normal = distance > fixed::Zero ? offset / distance : Vector2fx::Right;
+
+	manifold.normal = normal;
+	manifold.depth = radii - distance;
+	manifold.points[0] = Manifold2fx::Point { b.center - normal * b.radius, manifold.depth, 0 };
+	manifold.pointCount = 1;
+	return true;
+}
@@ -0,0 +1,315 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+#include "parallelfx.h"
+
+namespace Mathfx
+{
+	/**
+	 * \brief What a convolution reads past the edges of the grid.
+	 */
+	enum class BorderMode
+	{
+		// Repeats the edge value
+		Clamp,
+		// Reads from the opposite edge, for grids that tile
+		Wrap,
+		// Reflects about the edge, the edge value itself repeats once: c b a | a b c | c b a
+		Mirror,
+		// Reads zero
+		Zero,
+	};
+
+	/**
+	 * \brief destination = source convolved with kernel, for row-major width x height grids and a row-major
+	 * kernelWidth x kernelHeight kernel with odd sides, centered on the output.
+	 * A true convolution, the kernel is flipped: output (x, y) weighs source (x + rx - i, y + ry - j) by kernel (i, j) where
+	 * rx and ry are the kernel radii, so an impulse comes out as the kernel. Symmetric kernels give the same as correlation.
+	 * Every output is the sum of the full products in 64 bits, rounded towards negative infinity and saturated once, so
+	 * results are the same on every machine, thread count and with or without AVX2. The sum is exact while
+	 * kernelWidth * kernelHeight * max|tap| * max|value| stays below 2^63 in raw units, a single product of full scale
+	 * fixed32 values is already 2^62. Past that the sum wraps modulo 2^64, the same way on every path. Bands of rows are
+	 * spread over the pool.
+	 * \param source Must not overlap \p destination.
+	 * \tparam T Backing type, 16 and 32 bit types only, wider values would need 128 bit sums
+	 */
+	template <typename T, int F>
+	void Convolve2D(size_t width, size_t height, std::type_identity_t<std::span<const Fixed<T, F>>> source, std::span<Fixed<T, F>> destination,
+		size_t kernelWidth, size_t kernelHeight, std::type_identity_t<std::span<const Fixed<T, F>>> kernel,
+		BorderMode border = BorderMode::Clamp, ThreadPool& pool = DefaultThreadPool());
+
+	/**
+	 * \brief Convolution with the kernel vertical x horizontal, a horizontal pass over the rows followed by a vertical one.
+	 * That is kernelWidth + kernelHeight products per output instead of kernelWidth * kernelHeight. Each pass rounds and
+	 * saturates its outputs like Convolve2D, so results can be a few ulps off the general convolution with the product
+	 * kernel. \p source and \p destination may be the same span.
+	 */
+	template <typename T, int F>
+	void ConvolveSeparable(size_t width, size_t height, std::type_identity_t<std::span<const Fixed<T, F>>> source, std::span<Fixed<T, F>> destination,
+		std::type_identity_t<std::span<const Fixed<T, F>>> horizontal, std::type_identity_t<std::span<const Fixed<T, F>>> vertical,
+		BorderMode border = BorderMode::Clamp, ThreadPool& pool = DefaultThreadPool());
+
+	namespace internal
+	{
+		// Rows of output per pool chunk
+		constexpr size_t ConvolveBandRows = 16;
+
+		// Index actually read for position i of a line of length n, -1 when the border reads zero
+		inline ptrdiff_t BorderIndex(ptrdiff_t i, ptrdiff_t n, BorderMode border)
+		{
+			if (i >= 0 && i < n)
+			{
+				return i;
+			}
+			switch (border)
+			{
+			case BorderMode::Clamp:
+				return i < 0 ? 0 : n - 1;
+			case BorderMode::Wrap:
+				return ((i % n) + n) % n;
+			case BorderMode::Mirror:
+			{
+				const ptrdiff_t period = 2 * n;
+				const ptrdiff_t m = ((i % period) + period) % period;
+				return m < n ? m : period - 1 - m;
+			}
+			default:
+				return -1;
+			}
+		}
+
+		// sum + tap * value, unsigned so it wraps like the vector lanes do instead of overflowing
+		template <typename T, int F>
+		int64_t ConvolveMulAdd(int64_t sum, Fixed<T, F> tap, Fixed<T, F> value)
+		{
+			const int64_t product = static_cast<int64_t>(tap.rawValue) * value.rawValue;
+			return static_cast<int64_t>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(product));
+		}
+
+		/**
+		 * \brief out[i] = sum taps[t] * sources[t][i] for i < count, every source already points at the value for out[0].
+		 * The sum over all taps is what every convolution pass reduces to once its border has been resolved.
+		 */
+		template <typename T, int F>
+		void ConvolveSpan(const Fixed<T, F>* const* sources, const Fixed<T, F>* taps, size_t tapCount, size_t count, Fixed<T, F>* out)
+		{
+			size_t i = 0;
+#if FXMATH_AVX2
+			if constexpr (sizeof(T) == 4 || sizeof(T) == 2)
+			{
+				// Values are widened to 32 bit lanes and the even and odd lanes multiplied into separate 64 bit sums,
+				// which are exactly the sums the scalar loop makes
+				auto load = [](const Fixed<T, F>* p) {
+					if constexpr (sizeof(T) == 4)
+					{
+						return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+					}
+					else
+					{
+						return _mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+					}
+				};
+
+				// Sums that shift into the type's range, MinValue * 2^F up to just below (MaxValue + 1) * 2^F
+				const __m256i lowest = _mm256_set1_epi64x(static_cast<int64_t>(Fixed<T, F>::RawMinValue) * (static_cast<int64_t>(1) << F));
+				const __m256i highest = _mm256_set1_epi64x((static_cast<int64_t>(Fixed<T, F>::RawMaxValue) + 1) * (static_cast<int64_t>(1) << F) - 1);
+
+				for (; i + 8 <= count; i += 8)
+				{
+					__m256i even = _mm256_setzero_si256();
+					__m256i odd = _mm256_setzero_si256();
+					for (size_t t = 0; t < tapCount; ++t)
+					{
+						const __m256i tap = _mm256_set1_epi32(taps[t].rawValue);
+						const __m256i values = load(sources[t] + i);
+						even = _mm256_add_epi64(even, _mm256_mul_epi32(tap, values));
+						odd = _mm256_add_epi64(odd, _mm256_mul_epi32(tap, _mm256_srli_epi64(values, 32)));
+					}
+					// Saturating before the shift leaves every result in the low 32 bits of its lane, where a logical shift
+					// puts the same bits as the arithmetic one WideToFixedSaturated uses
+					even = _mm256_srli_epi64(_mm256_blendv_epi8(_mm256_blendv_epi8(even, lowest, _mm256_cmpgt_epi64(lowest, even)), highest, _mm256_cmpgt_epi64(even, highest)), F);
+					odd = _mm256_srli_epi64(_mm256_blendv_epi8(_mm256_blendv_epi8(odd, lowest, _mm256_cmpgt_epi64(lowest, odd)), highest, _mm256_cmpgt_epi64(odd, highest)), F);
+					const __m256i results = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+					if constexpr (sizeof(T) == 4)
+					{
+						_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), results);
+					}
+					else
+					{
+						_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(_mm256_castsi256_si128(results), _mm256_extracti128_si256(results, 1)));
+					}
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				int64_t sum = 0;
+				for (size_t t = 0; t < tapCount; ++t)
+				{
+					sum = ConvolveMulAdd(sum, taps[t], sources[t][i]);
+				}
+				out[i] = WideToFixedSaturated<T, F>(sum);
+			}
+		}
+
+		// One output of a row near its left or right edge, columns are resolved one tap at a time
+		template <typename T, int F>
+		Fixed<T, F> ConvolveEdge(const Fixed<T, F>* const* rows, const Fixed<T, F>* const* rowTaps, size_t rowCount, size_t kernelWidth,
+			size_t width, ptrdiff_t x, BorderMode border)
+		{
+			const ptrdiff_t radius = static_cast<ptrdiff_t>(kernelWidth / 2);
+			int64_t sum = 0;
+			for (size_t r = 0; r < rowCount; ++r)
+			{
+				for (size_t k = 0; k < kernelWidth; ++k)
+				{
+					const ptrdiff_t column = BorderIndex(x + static_cast<ptrdiff_t>(k) - radius, static_cast<ptrdiff_t>(width), border);
+					if (column >= 0)
+					{
+						sum = ConvolveMulAdd(sum, rowTaps[r][kernelWidth - 1 - k], rows[r][column]);
+					}
+				}
+			}
+			return WideToFixedSaturated<T, F>(sum);
+		}
+
+		/**
+		 * \brief One output row of a kernel with kernelWidth columns applied to the given source rows, rows[r] is weighed by
+		 * rowTaps[r][0, kernelWidth) in reverse, which flips the kernel horizontally. The columns that need the border go
+		 * through ConvolveEdge, the rest through ConvolveSpan.
+		 */
+		template <typename T, int F>
+		void ConvolveRow(const Fixed<T, F>* const* rows, const Fixed<T, F>* const* rowTaps, size_t rowCount, size_t kernelWidth,
+			size_t width, BorderMode border, Fixed<T, F>* out, std::vector<const Fixed<T, F>*>& sources, std::vector<Fixed<T, F>>& taps)
+		{
+			const size_t radius = kernelWidth / 2;
+			const size_t interiorBegin = std::min(radius, width);
+			const size_t interiorEnd = width > radius ? std::max(width - radius, interiorBegin) : interiorBegin;
+
+			if (interiorEnd > interiorBegin)
+			{
+				sources.clear();
+				taps.clear();
+				for (size_t r = 0; r < rowCount; ++r)
+				{
+					for (size_t k = 0; k < kernelWidth; ++k)
+					{
+						sources.push_back(rows[r] + interiorBegin + k - radius);
+						taps.push_back(rowTaps[r][kernelWidth - 1 - k]);
+					}
+				}
+				ConvolveSpan(sources.data(), taps.data(), taps.size(), interiorEnd - interiorBegin, out + interiorBegin);
+			}
+
+			for (size_t x = 0; x < interiorBegin; ++x)
+			{
+				out[x] = ConvolveEdge(rows, rowTaps, rowCount, kernelWidth, width, static_cast<ptrdiff_t>(x), border);
+			}
+			for (size_t x = interiorEnd; x < width; ++x)
+			{
+				out[x] = ConvolveEdge(rows, rowTaps, rowCount, kernelWidth, width, static_cast<ptrdiff_t>(x), border);
+			}
+		}
+
+		// Source rows read by output row y of a kernel with kernelHeight rows, each paired with its kernel row counted from the
+		// bottom so the kernel is flipped vertically. Rows the border reads as zero are left out
+		template <typename T, int F>
+		size_t ConvolveSourceRows(const Fixed<T, F>* source, size_t width, size_t height, size_t y, size_t kernelHeight,
+			const Fixed<T, F>* kernel, size_t kernelWidth, BorderMode border, std::vector<const Fixed<T, F>*>& rows, std::vector<const Fixed<T, F>*>& rowTaps)
+		{
+			const ptrdiff_t radius = static_cast<ptrdiff_t>(kernelHeight / 2);
+			rows.clear();
+			rowTaps.clear();
+			for (size_t k = 0; k < kernelHeight; ++k)
+			{
+				const ptrdiff_t row = BorderIndex(static_cast<ptrdiff_t>(y + k) - radius, static_cast<ptrdiff_t>(height), border);
+				if (row >= 0)
+				{
+					rows.push_back(source + static_cast<size_t>(row) * width);
+					rowTaps.push_back(kernel + (kernelHeight - 1 - k) * kernelWidth);
+				}
+			}
+			return rows.size();
+		}
+	}
+
+	template <typename T, int F>
+	void Convolve2D(size_t width, size_t height, std::type_identity_t<std::span<const Fixed<T, F>>> source, std::span<Fixed<T, F>> destination,
+		size_t kernelWidth, size_t kernelHeight, std::type_identity_t<std::span<const Fixed<T, F>>> kernel, BorderMode border, ThreadPool& pool)
+	{
+		static_assert(sizeof(T) <= 4, "Convolution accumulates in 64 bits and only supports 16 and 32 bit backing types.");
+		FXMATH_ASSERT(source.size() == width * height && destination.size() == width * height && "Grid spans must match the dimensions.");
+		FXMATH_ASSERT(kernelWidth % 2 == 1 && kernelHeight % 2 == 1 && kernel.size() == kernelWidth * kernelHeight && "Kernel sides must be odd and match the span.");
+		FXMATH_ASSERT((source.data() + source.size() <= destination.data() || destination.data() + destination.size() <= source.data())
+			&& "Source and destination must not overlap.");
+
+		using fixed = Fixed<T, F>;
+
+		const size_t bandCount = (height + internal::ConvolveBandRows - 1) / internal::ConvolveBandRows;
+		pool.ParallelFor(bandCount, [&](size_t band) {
+			std::vector<const fixed*> rows;
+			std::vector<const fixed*> rowTaps;
+			std::vector<const fixed*> sources;
+			std::vector<fixed> taps;
+			const size_t end = std::min((band + 1) * internal::ConvolveBandRows, height);
+			for (size_t y = band * internal::ConvolveBandRows; y < end; ++y)
+			{
+				const size_t rowCount = internal::ConvolveSourceRows(source.data(), width, height, y, kernelHeight, kernel.data(), kernelWidth, border, rows, rowTaps);
+				internal::ConvolveRow(rows.data(), rowTaps.data(), rowCount, kernelWidth, width, border, destination.data() + y * width, sources, taps);
+			}
+		});
+	}
+
+	template <typename T, int F>
+	void ConvolveSeparable(size_t width, size_t height, std::type_identity_t<std::span<const Fixed<T, F>>> source, std::span<Fixed<T, F>> destination,
+		std::type_identity_t<std::span<const Fixed<T, F>>> horizontal, std::type_identity_t<std::span<const Fixed<T, F>>> vertical,
+		BorderMode border, ThreadPool& pool)
+	{
+		static_assert(sizeof(T) <= 4, "Convolution accumulates in 64 bits and only supports 16 and 32 bit backing types.");
+		FXMATH_ASSERT(source.size() == width * height && destination.size() == width * height && "Grid spans must match the dimensions.");
+		FXMATH_ASSERT(horizontal.size() % 2 == 1 && vertical.size() % 2 == 1 && "Kernel sizes must be odd.");
+
+		using fixed = Fixed<T, F>;
+
+		std::vector<fixed> rowsDone(width * height);
+		const size_t bandCount = (height + internal::ConvolveBandRows - 1) / internal::ConvolveBandRows;
+		pool.ParallelFor(bandCount, [&](size_t band) {
+			std::vector<const fixed*> sources;
+			std::vector<fixed> taps;
+			const fixed* kernel = horizontal.data();
+			const size_t end = std::min((band + 1) * internal::ConvolveBandRows, height);
+			for (size_t y = band * internal::ConvolveBandRows; y < end; ++y)
+			{
+				const fixed* row = source.data() + y * width;
+				internal::ConvolveRow(&row, &kernel, 1, horizontal.size(), width, border, rowsDone.data() + y * width, sources, taps);
+			}
+		});
+
+		// The vertical pass reads whole rows, so no column ever needs the border
+		pool.ParallelFor(bandCount, [&](size_t band) {
+			std::vector<const fixed*> rows;
+			std::vector<const fixed*> rowTaps;
+			std::vector<fixed> taps;
+			const size_t end = std::min((band + 1) * internal::ConvolveBandRows, height);
+			for (size_t y = band * internal::ConvolveBandRows; y < end; ++y)
+			{
+				const size_t rowCount = internal::ConvolveSourceRows<T, F>(rowsDone.data(), width, height, y, vertical.size(), vertical.data(), 1, border, rows, rowTaps);
+				taps.resize(rowCount);
+				for (size_t r = 0; r < rowCount; ++r)
+				{
+					taps[r] = *rowTaps[r];
+				}
+				internal::ConvolveSpan(rows.data(), taps.data(), rowCount, width, destination.data() + y * width);
+			}
+		});
+	}
+}
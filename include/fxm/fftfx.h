@@ -0,0 +1,336 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedsimd.h"
+
+/**
+ * \brief Complex number with fixed point real and imaginary parts, multiplication truncates like FastMul.
+ */
+template <typename T, int F>
+struct Complexfx
+{
+	using fixed = Fixed<T, F>;
+
+	fixed re;
+	fixed im;
+
+	// constructors
+	constexpr Complexfx() : re(), im() {}
+	constexpr Complexfx(fixed re, fixed im) : re(re), im(im) {}
+
+	Complexfx& operator+=(const Complexfx& other)
+	{
+		re += other.re;
+		im += other.im;
+		return *this;
+	}
+
+	Complexfx& operator-=(const Complexfx& other)
+	{
+		re -= other.re;
+		im -= other.im;
+		return *this;
+	}
+
+	Complexfx& operator*=(const Complexfx& other)
+	{
+		fixed real = re * other.re - im * other.im;
+		im = re * other.im + im * other.re;
+		re = real;
+		return *this;
+	}
+};
+
+template <typename T, int F> Complexfx<T, F> operator+(Complexfx<T, F> a, const Complexfx<T, F>& b) { return a += b; }
+template <typename T, int F> Complexfx<T, F> operator-(Complexfx<T, F> a, const Complexfx<T, F>& b) { return a -= b; }
+template <typename T, int F> Complexfx<T, F> operator*(Complexfx<T, F> a, const Complexfx<T, F>& b) { return a *= b; }
+template <typename T, int F> bool operator==(const Complexfx<T, F>& a, const Complexfx<T, F>& b) { return a.re == b.re && a.im == b.im; }
+template <typename T, int F> bool operator!=(const Complexfx<T, F>& a, const Complexfx<T, F>& b) { return !(a == b); }
+
+/**
+ * \brief Radix-2 decimation in time FFT of a fixed power of two size, transforms in place.
+ * Uses block floating point: before every stage the whole block is shifted right just enough to leave the two bits of
+ * headroom a butterfly can grow into, and the shifts are returned as a block exponent, the true transform is
+ * data * 2^exponent. Nothing overflows whatever the input, and small signals keep all of their precision.
+ *
+ * Twiddle factors are computed once per plan from Mathfx::Sin and Mathfx::Cos on fixed64 angles, so they come from the
+ * sin lookup table like every other trig result. The table itself is filled with std::sin during static initialization,
+ * it can't be made constexpr without replacing its values with those of a different sine and changing every Sin result,
+ * but since the twiddles are built once per plan nothing is evaluated per transform anyway.
+ *
+ * The first two stages only multiply by 1 and -i and are done without multiplies. fixed32 butterflies use AVX2, four
+ * complex values at a time, and give exactly the scalar result.
+ */
+template <typename T, int F>
+struct Fftfx
+{
+	using fixed = Fixed<T, F>;
+	using complex = Complexfx<T, F>;
+
+	/**
+	 * \param size Number of points, a power of two of at least 2.
+	 */
+	explicit Fftfx(size_t size);
+
+	/**
+	 * \brief X[k] = sum x[n] e^(-2 pi i k n / N), in natural order.
+	 * \return Block exponent, the transform is \p data * 2^exponent.
+	 */
+	int Forward(std::span<complex> data) const;
+
+	/**
+	 * \brief x[n] = 1 / N sum X[k] e^(2 pi i k n / N), the 1 / N is folded into the returned block exponent.
+	 */
+	int Inverse(std::span<complex> data) const;
+
+	/**
+	 * \brief Multiplies every value by 2^exponent, saturating, e.g. to bring a transform back to a common scale.
+	 */
+	static void ApplyExponent(std::span<complex> data, int exponent);
+
+	size_t Size() const { return size; }
+
+private:
+	size_t size;
+	int log2Size;
+
+	// Index pairs swapped by the bit reversal permutation
+	std::vector<std::pair<uint32_t, uint32_t>> swaps;
+
+	// The stage combining blocks of half size h uses twiddles[h - 1 + k] = e^(-pi i k / h) for k < h
+	std::vector<complex> twiddles;
+
+	int Transform(std::span<complex> data) const;
+	static int ScaleToHeadroom(std::span<complex> data);
+	void Butterflies(std::span<complex> data, size_t half) const;
+};
+
+template <typename T, int F>
+Fftfx<T, F>::Fftfx(size_t size) : size(size), log2Size(std::countr_zero(size))
+{
+	FXMATH_ASSERT(size >= 2 && std::has_single_bit(size) && "FFT size must be a power of two of at least 2.");
+
+	for (uint32_t i = 0; i < size; ++i)
+	{
+		uint32_t reversed = 0;
+		for (int bit = 0; bit < log2Size; ++bit)
+		{
+			reversed |= ((i >> bit) & 1) << (log2Size - 1 - bit);
+		}
+		if (i < reversed)
+		{
+			swaps.emplace_back(i, reversed);
+		}
+	}
+
+	// e^(-2 pi i k / size) for k < size / 2 on the largest stage. The second quarter turn is the first one rotated by -i,
+	// so the quarter points are exact and every stage sees exactly the same values at the same angles.
+	const size_t quarter = size / 4;
+	std::vector<complex> largest(size / 2);
+	largest[0] = complex(fixed::One, fixed::Zero);
+	for (size_t k = 1; k < std::max<size_t>(quarter, 1); ++k)
+	{
+		const fixed64 angle = fixed64::TwoPi * fixed64::Int(static_cast<int>(k)) / fixed64::Int(static_cast<int>(size));
+		const fixed64 values[2] = { Mathfx::Cos(angle), -Mathfx::Sin(angle) };
+		fixed parts[2];
+		for (int i = 0; i < 2; ++i)
+		{
+			if constexpr (F < fixed64::FractionShift)
+			{
+				constexpr int shift = fixed64::FractionShift - F;
+				parts[i] = fixed(static_cast<T>((values[i].rawValue + (static_cast<int64_t>(1) << (shift - 1))) >> shift));
+			}
+			else
+			{
+				parts[i] = fixed(static_cast<T>(static_cast<T>(values[i].rawValue) << (F - fixed64::FractionShift)));
+			}
+		}
+		largest[k] = complex(parts[0], parts[1]);
+	}
+	for (size_t k = quarter; k < size / 2 && quarter > 0; ++k)
+	{
+		largest[k] = complex(largest[k - quarter].im, -largest[k - quarter].re);
+	}
+
+	twiddles.resize(size - 1);
+	for (size_t half = 1; half < size; half <<= 1)
+	{
+		const size_t stride = size / (2 * half);
+		for (size_t k = 0; k < half; ++k)
+		{
+			twiddles[half - 1 + k] = largest[k * stride];
+		}
+	}
+}
+
+template <typename T, int F>
+int Fftfx<T, F>::ScaleToHeadroom(std::span<complex> data)
+{
+	using uraw = typename fixed::uraw;
+
+	// A butterfly output is at most (1 + sqrt(2)) times the largest input, keeping inputs below a quarter of the range
+	// keeps outputs below 0.61 of it
+	constexpr uraw limit = static_cast<uraw>(fixed::RawMaxValue) >> 2;
+	uraw largest = 0;
+	for (const complex& value : data)
+	{
+		for (T raw : { value.re.rawValue, value.im.rawValue })
+		{
+			const uraw magnitude = raw < 0 ? static_cast<uraw>(0) - static_cast<uraw>(raw) : static_cast<uraw>(raw);
+			largest = std::max(largest, magnitude);
+		}
+	}
+
+	int shift = 0;
+	while ((largest >> shift) >= limit)
+	{
+		++shift;
+	}
+	if (shift > 0)
+	{
+		for (complex& value : data)
+		{
+			value.re >>= shift;
+			value.im >>= shift;
+		}
+	}
+	return shift;
+}
+
+template <typename T, int F>
+void Fftfx<T, F>::Butterflies(std::span<complex> data, size_t half) const
+{
+	if (half == 1)
+	{
+		for (size_t i = 0; i < size; i += 2)
+		{
+			const complex a = data[i];
+			data[i] = a + data[i + 1];
+			data[i + 1] = a - data[i + 1];
+		}
+		return;
+	}
+	if (half == 2)
+	{
+		// Twiddles 1 and -i, b * -i = (b.im, -b.re)
+		for (size_t i = 0; i < size; i += 4)
+		{
+			const complex a0 = data[i];
+			const complex a1 = data[i + 1];
+			const complex b0 = data[i + 2];
+			const complex b1(data[i + 3].im, -data[i + 3].re);
+			data[i] = a0 + b0;
+			data[i + 2] = a0 - b0;
+			data[i + 1] = a1 + b1;
+			data[i + 3] = a1 - b1;
+		}
+		return;
+	}
+
+	const complex* stageTwiddles = &twiddles[half - 1];
+	for (size_t start = 0; start < size; start += 2 * half)
+	{
+		complex* a = &data[start];
+		complex* b = &data[start + half];
+		size_t k = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<fixed, fixed32>)
+		{
+			// Four interleaved complex values per register, even lanes real and odd lanes imaginary
+			for (; k + 4 <= half; k += 4)
+			{
+				const __m256i x = Mathfx::simd::Load8(&a[k].re);
+				const __m256i y = Mathfx::simd::Load8(&b[k].re);
+				const __m256i w = Mathfx::simd::Load8(&stageTwiddles[k].re);
+				const __m256i yImag = _mm256_srli_epi64(y, 32);
+				const __m256i wImag = _mm256_srli_epi64(w, 32);
+				const __m256i real = _mm256_sub_epi32(Mathfx::simd::FastMulEven8(y, w), Mathfx::simd::FastMulEven8(yImag, wImag));
+				const __m256i imag = _mm256_add_epi32(Mathfx::simd::FastMulEven8(y, wImag), Mathfx::simd::FastMulEven8(yImag, w));
+				const __m256i product = _mm256_blend_epi32(real, _mm256_slli_epi64(imag, 32), 0xAA);
+				Mathfx::simd::Store8(&a[k].re, _mm256_add_epi32(x, product));
+				Mathfx::simd::Store8(&b[k].re, _mm256_sub_epi32(x, product));
+			}
+		}
+#endif
+		for (; k < half; ++k)
+		{
+			const complex product = b[k] * stageTwiddles[k];
+			b[k] = a[k] - product;
+			a[k] += product;
+		}
+	}
+}
+
+template <typename T, int F>
+int Fftfx<T, F>::Transform(std::span<complex> data) const
+{
+	for (const auto& [i, j] : swaps)
+	{
+		std::swap(data[i], data[j]);
+	}
+
+	int exponent = 0;
+	for (size_t half = 1; half < size; half <<= 1)
+	{
+		exponent += ScaleToHeadroom(data);
+		Butterflies(data, half);
+	}
+	return exponent;
+}
+
+template <typename T, int F>
+int Fftfx<T, F>::Forward(std::span<complex> data) const
+{
+	FXMATH_ASSERT(data.size() == size && "Data length must match the FFT size.");
+	return Transform(data);
+}
+
+template <typename T, int F>
+int Fftfx<T, F>::Inverse(std::span<complex> data) const
+{
+	FXMATH_ASSERT(data.size() == size && "Data length must match the FFT size.");
+
+	// Swapping real and imaginary parts before and after a forward transform gives the unscaled inverse
+	for (complex& value : data)
+	{
+		std::swap(value.re, value.im);
+	}
+	const int exponent = Transform(data);
+	for (complex& value : data)
+	{
+		std::swap(value.re, value.im);
+	}
+	return exponent - log2Size;
+}
+
+template <typename T, int F>
+void Fftfx<T, F>::ApplyExponent(std::span<complex> data, int exponent)
+{
+	using raw = typename fixed::raw;
+
+	for (complex& value : data)
+	{
+		for (fixed* part : { &value.re, &value.im })
+		{
+			if (exponent < 0)
+			{
+				*part >>= std::min(-exponent, fixed::NumBits - 1);
+			}
+			else if (exponent > 0)
+			{
+				const int shift = std::min(exponent, fixed::NumBits - 1);
+				const raw limit = fixed::RawMaxValue >> shift;
+				*part = part->rawValue > limit ? fixed::MaxValue : (part->rawValue < -limit - 1 ? fixed::MinValue : fixed(static_cast<raw>(part->rawValue << shift)));
+			}
+		}
+	}
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+
+/**
+ * \brief Streaming FIR filter, y[n] = sum taps[k] * x[n - k], with any number of taps.
+ * Every output is accumulated from the full products in a 128 bit FixedAccumulator and rounded towards negative infinity
+ * and saturated once, so it doesn't depend on how the input is split into blocks or on whether AVX2 is enabled.
+ * The last taps - 1 inputs are kept between calls, Process never allocates.
+ */
+template <typename T, int F>
+struct FirFilterfx
+{
+	using fixed = Fixed<T, F>;
+
+	// constructors
+	explicit FirFilterfx(std::span<const fixed> taps);
+
+	// instance methods
+
+	/**
+	 * \brief Filters one block, \p input and \p output may be the same span.
+	 */
+	void Process(std::span<const fixed> input, std::span<fixed> output);
+	fixed Process(fixed sample);
+
+	/**
+	 * \brief Clears the history back to silence.
+	 */
+	void Reset();
+
+	size_t TapCount() const { return taps.size(); }
+
+private:
+	std::vector<fixed> taps;
+
+	// Every sample is written at position and position + TapCount so the last TapCount samples are always contiguous,
+	// newest first, starting at position
+	std::vector<fixed> history;
+	size_t position = 0;
+};
+
+template <typename T, int F>
+FirFilterfx<T, F>::FirFilterfx(std::span<const fixed> taps) : taps(taps.begin(), taps.end()), history(2 * taps.size())
+{
+	FXMATH_ASSERT(!taps.empty() && "A FIR filter needs at least one tap.");
+}
+
+template <typename T, int F>
+void FirFilterfx<T, F>::Process(std::span<const fixed> input, std::span<fixed> output)
+{
+	FXMATH_ASSERT(input.size() == output.size() && "Input and output spans must be the same length.");
+
+	for (size_t i = 0; i < input.size(); ++i)
+	{
+		output[i] = Process(input[i]);
+	}
+}
+
+template <typename T, int F>
+Fixed<T, F> FirFilterfx<T, F>::Process(fixed sample)
+{
+	const size_t count = taps.size();
+	position = position == 0 ? count - 1 : position - 1;
+	history[position] = sample;
+	history[position + count] = sample;
+
+	const fixed* window = &history[position];
+	FixedAccumulator<T, F> sum;
+	size_t k = 0;
+#if FXMATH_AVX2
+	if constexpr (std::is_same_v<fixed, fixed32>)
+	{
+		// Full scale products are 2^62, the lanes keep split sums so the total stays exact past 64 bits
+		__m256i low = _mm256_setzero_si256();
+		__m256i high = _mm256_setzero_si256();
+		for (; k + 8 <= count; k += 8)
+		{
+			Mathfx::simd::WideMulAdd8(low, high, Mathfx::simd::Load8(&taps[k]), Mathfx::simd::Load8(&window[k]));
+		}
+		sum.value = Mathfx::simd::CombineSplitSigned4(low, high);
+	}
+#endif
+	for (; k < count; ++k)
+	{
+		sum.MulAdd(taps[k], window[k]);
+	}
+	return sum.SaturatedResult();
+}
+
+template <typename T, int F>
+void FirFilterfx<T, F>::Reset()
+{
+	std::fill(history.begin(), history.end(), fixed::Zero);
+	position = 0;
+}
+
+/**
+ * \brief Cascade of second order IIR sections, each y[n] = b0 x[n] + b1 x[n - 1] + b2 x[n - 2] - a1 y[n - 1] - a2 y[n - 2].
+ * Sections are direct form I: all five products of a section are accumulated at full precision and rounded and saturated
+ * once, and only inputs and outputs are kept as state so there are no internal nodes that can overflow. The state is kept
+ * between calls, Process never allocates.
+ * The recursion makes every output depend on the one before, so unlike the FIR there is no vector path, filter several
+ * channels on separate threads instead.
+ */
+template <typename T, int F>
+struct BiquadFilterfx
+{
+	using fixed = Fixed<T, F>;
+
+	/**
+	 * \brief Coefficients of one section normalized so a0 is one.
+	 */
+	struct Coefficients
+	{
+		fixed b0;
+		fixed b1;
+		fixed b2;
+		fixed a1;
+		fixed a2;
+	};
+
+	// constructors
+	explicit BiquadFilterfx(std::span<const Coefficients> sections);
+
+	// instance methods
+
+	/**
+	 * \brief Filters one block through every section, \p input and \p output may be the same span.
+	 */
+	void Process(std::span<const fixed> input, std::span<fixed> output);
+	fixed Process(fixed sample);
+
+	/**
+	 * \brief Clears the state of every section back to silence.
+	 */
+	void Reset();
+
+	size_t SectionCount() const { return sections.size(); }
+
+private:
+	struct State
+	{
+		fixed x1;
+		fixed x2;
+		fixed y1;
+		fixed y2;
+	};
+
+	std::vector<Coefficients> sections;
+	std::vector<State> states;
+
+	static fixed Step(const Coefficients& c, State& state, fixed x);
+};
+
+template <typename T, int F>
+BiquadFilterfx<T, F>::BiquadFilterfx(std::span<const Coefficients> sections) : sections(sections.begin(), sections.end()), states(sections.size())
+{
+	FXMATH_ASSERT(!sections.empty() && "A biquad cascade needs at least one section.");
+}
+
+template <typename T, int F>
+Fixed<T, F> BiquadFilterfx<T, F>::Step(const Coefficients& c, State& state, fixed x)
+{
+	FixedAccumulator<T, F> sum;
+	sum.MulAdd(c.b0, x);
+	sum.MulAdd(c.b1, state.x1);
+	sum.MulAdd(c.b2, state.x2);
+	sum.MulSub(c.a1, state.y1);
+	sum.MulSub(c.a2, state.y2);
+	const fixed y = sum.SaturatedResult();
+
+	state.x2 = state.x1;
+	state.x1 = x;
+	state.y2 = state.y1;
+	state.y1 = y;
+	return y;
+}
+
+template <typename T, int F>
+void BiquadFilterfx<T, F>::Process(std::span<const fixed> input, std::span<fixed> output)
+{
+	FXMATH_ASSERT(input.size() == output.size() && "Input and output spans must be the same length.");
+
+	// A whole block through one section at a time keeps that section's coefficients and state in registers,
+	// the first section reads the input and the rest filter the output in place
+	for (size_t s = 0; s < sections.size(); ++s)
+	{
+		const Coefficients c = sections[s];
+		State state = states[s];
+		const std::span<const fixed> source = s == 0 ? input : std::span<const fixed>(output);
+		for (size_t i = 0; i < output.size(); ++i)
+		{
+			output[i] = Step(c, state, source[i]);
+		}
+		states[s] = state;
+	}
+}
+
+template <typename T, int F>
+Fixed<T, F> BiquadFilterfx<T, F>::Process(fixed sample)
+{
+	for (size_t s = 0; s < sections.size(); ++s)
+	{
+		sample = Step(sections[s], states[s], sample);
+	}
+	return sample;
+}
+
+template <typename T, int F>
+void BiquadFilterfx<T, F>::Reset()
+{
+	std::fill(states.begin(), states.end(), State());
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+
+namespace Mathfx
+{
+	// Batch kernels deduce the fixed point type from the output span, the input converts to it,
+	// so call them as FastSqrtBatch(values, std::span(results)).
+
+	/**
+	 * \brief FastSqrt over a span, out[i] == FastSqrt(in[i]) bit for bit.
+	 * fixed64 runs four square roots at once across AVX2 lanes when available, everything else falls back to the scalar loop.
+	 * \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void FastSqrtBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed64>)
+		{
+			for (; i + 4 <= in.size(); i += 4)
+			{
+				simd::Store4(&out[i], simd::FastSqrt4(simd::Load4(&in[i])));
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = FastSqrt(in[i]);
+		}
+	}
+
+	template <typename T, int F>
+	void FastSqrtBatch(std::span<Fixed<T, F>> values)
+	{
+		FastSqrtBatch<T, F>(values, values);
+	}
+
+	/**
+	 * \brief Sin over a span, out[i] == Sin(in[i]). Scalar, but gives Sin the same batch shape as the other kernels
+	 * so it can be handed to ParallelBatch. \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void SinBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = Sin(in[i]);
+		}
+	}
+
+	/**
+	 * \brief Cos over a span, out[i] == Cos(in[i]). \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void CosBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = Cos(in[i]);
+		}
+	}
+
+	/**
+	 * \brief Tanh over a span, out[i] == Tanh(in[i]) bit for bit.
+	 * fixed32 runs eight lanes at once with table gathers when AVX2 is available. \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void TanhBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			for (; i + 8 <= in.size(); i += 8)
+			{
+				simd::Store8(&out[i], simd::Tanh8(simd::Load8(&in[i])));
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = Tanh(in[i]);
+		}
+	}
+
+	/**
+	 * \brief Sigmoid over a span, out[i] == Sigmoid(in[i]) bit for bit. \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void SigmoidBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			for (; i + 8 <= in.size(); i += 8)
+			{
+				simd::Store8(&out[i], simd::Sigmoid8(simd::Load8(&in[i])));
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = Sigmoid(in[i]);
+		}
+	}
+
+	/**
+	 * \brief FastExp over a span, out[i] == FastExp(in[i]) bit for bit. \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void FastExpBatch(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		size_t i = 0;
+#if FXMATH_AVX2
+		if constexpr (std::is_same_v<Fixed<T, F>, fixed32>)
+		{
+			for (; i + 8 <= in.size(); i += 8)
+			{
+				simd::Store8(&out[i], simd::FastExp8(simd::Load8(&in[i])));
+			}
+		}
+#endif
+		for (; i < in.size(); ++i)
+		{
+			out[i] = FastExp(in[i]);
+		}
+	}
+
+	/**
+	 * \brief out[i] = e^in[i] / sum of e^in[j], computed as FastExp(in[i] - max) so nothing overflows and the largest
+	 * input always contributes exactly one. The sum is exact and every quotient is rounded like operator/ through a
+	 * single FixedDivisor, so the result doesn't depend on the order of the inputs' other elements or on AVX2.
+	 * \p in and \p out may be the same span.
+	 */
+	template <typename T, int F>
+	void Softmax(std::type_identity_t<std::span<const Fixed<T, F>>> in, std::span<Fixed<T, F>> out)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+		if (in.empty())
+		{
+			return;
+		}
+
+		raw largest = fixed::RawMinValue;
+		for (const fixed& value : in)
+		{
+			largest = std::max(largest, value.rawValue);
+		}
+
+		// Differences below MinValue saturate, FastExp is zero long before that
+		const raw lowest = largest > 0 ? static_cast<raw>(fixed::RawMinValue + largest) : fixed::RawMinValue;
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			out[i] = in[i].rawValue < lowest ? fixed::MinValue : fixed(static_cast<raw>(in[i].rawValue - largest));
+		}
+		FastExpBatch<T, F>(out, out);
+
+		// Every term is at most one, so the sum fits easily and is at least one
+		int64_t sum = 0;
+		for (const fixed& value : out)
+		{
+			sum += value.rawValue;
+		}
+		const FixedDivisor<int64_t, F> divisor { Fixed<int64_t, F>(sum) };
+		for (fixed& value : out)
+		{
+			value = fixed(static_cast<raw>(divisor.Divide(Fixed<int64_t, F>(static_cast<int64_t>(value.rawValue))).rawValue));
+		}
+	}
+}
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedsimd.h"
+#include "fixedwide.h"
+#include "splinefx.h"
+
+namespace Mathfx
+{
+	enum class CurveInterpolation
+	{
+		// Straight lines between the points
+		Linear,
+
+		// Monotone cubic Hermite, smooth through every point without overshooting between them
+		Smooth,
+	};
+}
+
+/**
+ * \brief Response curve baked into a table over [Min, Max], e.g. a falloff, acceleration or experience curve.
+ * Table entries are a power of two raw step apart, so Evaluate is a clamp, a shift, one table read of two neighbouring
+ * entries and one FastMul to interpolate between them, whatever the function behind it cost. Inputs outside the domain
+ * clamp to its ends.
+ * The table is sampled only inside [Min, Max]. When Max isn't on the grid the last entry is extrapolated through the value
+ * at Max, so both ends of the domain evaluate to their exact values.
+ * Curves baked from control points or from functions of fixed values only use fixed point arithmetic and come out
+ * identical on every platform, functions of doubles are as portable as the math library behind them.
+ */
+template <typename T, int F>
+struct FixedCurve
+{
+	using fixed = Fixed<T, F>;
+	using raw = typename fixed::raw;
+	using uraw = typename fixed::uraw;
+
+	struct Point
+	{
+		fixed x;
+		fixed y;
+	};
+
+	// constructors
+
+	/**
+	 * \brief Curve through \p samples evenly spaced from \p min to \p max, both ends included.
+	 * The samples are used as the table when their raw spacing is a power of two, otherwise they're linearly resampled
+	 * onto a power of two grid of up to twice as many intervals.
+	 */
+	FixedCurve(fixed min, fixed max, std::span<const fixed> samples);
+
+	// static methods
+
+	/**
+	 * \brief Bakes \p function over [\p min, \p max] at \p resolution to twice \p resolution intervals.
+	 * \p function takes and returns either fixed or double, results out of range saturate.
+	 */
+	template <typename Function>
+	static FixedCurve FromFunction(fixed min, fixed max, size_t resolution, Function&& function);
+
+	/**
+	 * \brief Bakes the curve through \p points, which need increasing x, at \p resolution to twice \p resolution intervals.
+	 * The domain runs from the first to the last point.
+	 */
+	static FixedCurve FromPoints(std::span<const Point> points, size_t resolution, Mathfx::CurveInterpolation interpolation = Mathfx::CurveInterpolation::Linear);
+
+	/**
+	 * \brief Curve over a table made by MakeLookupTable from \p Proj, Proj(i, Size) is the value at min + i (max - min) / (Size - 1).
+	 */
+	template <fixed(*Proj)(int, size_t), size_t Size>
+	static FixedCurve FromLookupTable(fixed min, fixed max);
+
+	// instance methods
+	fixed Evaluate(fixed x) const;
+	fixed operator()(fixed x) const { return Evaluate(x); }
+
+	/**
+	 * \brief Evaluates every element of \p x into \p out bit for bit like Evaluate, \p x and \p out may be the same span.
+	 */
+	void Evaluate(std::span<const fixed> x, std::span<fixed> out) const;
+	void Evaluate(std::span<fixed> values) const { Evaluate(values, values); }
+
+	fixed Min() const { return fixed(min); }
+	fixed Max() const { return fixed(max); }
+
+	// Number of table intervals from Min to the first grid point at or past Max
+	size_t Resolution() const { return table.size() - 2; }
+
+private:
+	raw min;
+	raw max;
+
+	// log2 of the raw distance between entries
+	int shift;
+
+	// The position within an interval has shift bits, moving it up by up and down by down gives the F bits of a fixed
+	int up;
+	int down;
+
+	// One entry per grid point up to the first at or past Max, then that entry again so the interval Max is in always
+	// has two ends to read
+	std::vector<fixed> table;
+
+	FixedCurve(fixed min, fixed max, size_t resolution);
+
+	// Fills the table from sampler(x) for grid points up to Max and extrapolates the last entry through sampler(Max)
+	template <typename Sampler>
+	void Bake(Sampler&& sampler);
+
+	static fixed Saturate(double value);
+	static fixed Saturate(const Int128& value);
+};
+
+template <typename T, int F>
+FixedCurve<T, F>::FixedCurve(fixed min, fixed max, size_t resolution) : min(min.rawValue), max(max.rawValue)
+{
+	FXMATH_ASSERT(min < max && resolution > 0 && "A curve needs a domain and at least one interval.");
+
+	// The largest power of two step that gives at least resolution intervals
+	const uraw width = static_cast<uraw>(static_cast<uraw>(max.rawValue) - static_cast<uraw>(min.rawValue));
+	const uint64_t step = std::max(std::bit_floor(static_cast<uint64_t>(width) / resolution), static_cast<uint64_t>(1));
+	shift = std::countr_zero(step);
+	up = std::max(F - shift, 0);
+	down = std::max(shift - F, 0);
+	table.resize(static_cast<size_t>(static_cast<uint64_t>(width) >> shift) + ((static_cast<uint64_t>(width) & (step - 1)) != 0 ? 1 : 0) + 2);
+}
+
+template <typename T, int F>
+FixedCurve<T, F>::FixedCurve(fixed min, fixed max, std::span<const fixed> samples) : FixedCurve(min, max, samples.size() - 1)
+{
+	FXMATH_ASSERT(samples.size() >= 2 && "A curve needs at least a sample at each end.");
+
+	const uraw width = static_cast<uraw>(static_cast<uraw>(max.rawValue) - static_cast<uraw>(min.rawValue));
+	if ((static_cast<uint64_t>(samples.size() - 1) << shift) == static_cast<uint64_t>(width))
+	{
+		std::copy(samples.begin(), samples.end(), table.begin());
+		table.back() = samples.back();
+		return;
+	}
+
+	// Sample i sits at min + i * width / (size - 1), the grid point at offset lies offset * (size - 1) / width samples in
+	const uint64_t intervals = samples.size() - 1;
+	Bake([&](uraw offset) {
+		const Int128 position = Int128::MulUnsigned(static_cast<uint64_t>(offset), intervals);
+		uint64_t remainder = 0;
+		const size_t index = static_cast<size_t>(Int128::DivUnsigned(position, static_cast<uint64_t>(width), &remainder).Low());
+		if (index >= intervals)
+		{
+			return samples.back();
+		}
+
+		// Neighbouring samples are close enough for their difference to fit, as Evaluate needs anyway
+		const int64_t delta = static_cast<int64_t>((samples[index + 1] - samples[index]).rawValue);
+		const uint64_t magnitude = delta < 0 ? static_cast<uint64_t>(0) - static_cast<uint64_t>(delta) : static_cast<uint64_t>(delta);
+		const Int128 along = Int128::DivUnsigned(Int128::MulUnsigned(magnitude, remainder), static_cast<uint64_t>(width));
+		return Saturate(delta < 0 ? Int128(static_cast<int64_t>(samples[index].rawValue)) - along : Int128(static_cast<int64_t>(samples[index].rawValue)) + along);
+	});
+}
+
+template <typename T, int F>
+template <typename Function>
+FixedCurve<T, F> FixedCurve<T, F>::FromFunction(fixed min, fixed max, size_t resolution, Function&& function)
+{
+	FixedCurve curve(min, max, resolution);
+	curve.Bake([&](uraw offset) {
+		const fixed x = fixed(static_cast<raw>(static_cast<uraw>(min.rawValue) + offset));
+		if constexpr (std::is_invocable_r_v<fixed, Function, fixed>)
+		{
+			return static_cast<fixed>(function(x));
+		}
+		else
+		{
+			return Saturate(static_cast<double>(function(static_cast<double>(x))));
+		}
+	});
+	return curve;
+}
+
+template <typename T, int F>
+FixedCurve<T, F> FixedCurve<T, F>::FromPoints(std::span<const Point> points, size_t resolution, Mathfx::CurveInterpolation interpolation)
+{
+	FXMATH_ASSERT(points.size() >= 2 && "A curve needs at least two points.");
+	FXMATH_ASSERT(std::ranges::adjacent_find(points, [](const Point& a, const Point& b) { return !(a.x < b.x); }) == points.end() && "Curve points need increasing x.");
+
+	// Slopes of the chords and, for the smooth curve, Fritsch-Carlson tangents at the points: the average of the chords
+	// around the point, zero at a turning point and limited to three times the smaller chord so no segment overshoots
+	const size_t count = points.size();
+	std::vector<fixed> tangents(count, fixed::Zero);
+	if (interpolation == Mathfx::CurveInterpolation::Smooth)
+	{
+		std::vector<fixed> chords(count - 1);
+		for (size_t k = 0; k + 1 < count; ++k)
+		{
+			chords[k] = (points[k + 1].y - points[k].y) / (points[k + 1].x - points[k].x);
+		}
+		tangents[0] = chords[0];
+		tangents[count - 1] = chords[count - 2];
+		for (size_t k = 1; k + 1 < count; ++k)
+		{
+			const fixed before = chords[k - 1];
+			const fixed after = chords[k];
+			if ((before < fixed::Zero) != (after < fixed::Zero) || before == fixed::Zero || after == fixed::Zero)
+			{
+				continue;
+			}
+			const fixed limit = Mathfx::Min(Mathfx::Abs(before), Mathfx::Abs(after)) * fixed::Int(3);
+			const fixed average = Mathfx::Clamp((before >> 1) + (after >> 1), -limit, limit);
+			tangents[k] = average;
+		}
+	}
+
+	FixedCurve curve(points.front().x, points.back().x, resolution);
+	size_t segment = 0;
+	curve.Bake([&](uraw offset) {
+		const fixed x = fixed(static_cast<raw>(static_cast<uraw>(curve.min) + offset));
+		while (segment + 2 < count && points[segment + 1].x <= x)
+		{
+			++segment;
+		}
+		const Point& a = points[segment];
+		const Point& b = points[segment + 1];
+		const fixed width = b.x - a.x;
+		const fixed t = Mathfx::Clamp((x - a.x) / width, fixed::Zero, fixed::One);
+		if (interpolation == Mathfx::CurveInterpolation::Linear)
+		{
+			return Mathfx::Lerp(a.y, b.y, t);
+		}
+		return CubicSplinefx<fixed>::Hermite(a.y, tangents[segment] * width, b.y, tangents[segment + 1] * width).Evaluate(t);
+	});
+	return curve;
+}
+
+template <typename T, int F>
+template <Fixed<T, F>(*Proj)(int, size_t), size_t Size>
+FixedCurve<T, F> FixedCurve<T, F>::FromLookupTable(fixed min, fixed max)
+{
+	static const std::array<fixed, Size> samples = MakeLookupTable<fixed, Proj, Size>();
+	return FixedCurve(min, max, std::span<const fixed>(samples));
+}
+
+template <typename T, int F>
+template <typename Sampler>
+void FixedCurve<T, F>::Bake(Sampler&& sampler)
+{
+	const uraw width = static_cast<uraw>(static_cast<uraw>(max) - static_cast<uraw>(min));
+	const size_t last = table.size() - 2;
+	for (size_t i = 0; i < last; ++i)
+	{
+		table[i] = sampler(static_cast<uraw>(static_cast<uraw>(i) << shift));
+	}
+
+	// The last grid point is at or past Max, extend the line from the grid point before it through the value at Max
+	const fixed end = sampler(width);
+	const uint64_t past = static_cast<uint64_t>(width) - (static_cast<uint64_t>(last - 1) << shift);
+	const uint64_t step = static_cast<uint64_t>(1) << shift;
+	if (past == step)
+	{
+		table[last] = end;
+	}
+	else
+	{
+		const Int128 rise = Int128(static_cast<int64_t>(end.rawValue)) - Int128(static_cast<int64_t>(table[last - 1].rawValue));
+		const Int128 slope = Int128::DivFloor(rise << shift, past);
+		table[last] = Saturate(Int128(static_cast<int64_t>(table[last - 1].rawValue)) + slope);
+	}
+	table[last + 1] = table[last];
+}
+
+template <typename T, int F>
+Fixed<T, F> FixedCurve<T, F>::Saturate(double value)
+{
+	const double scaled = std::round(value * fixed::RawOne);
+	if (!(scaled < -static_cast<double>(fixed::RawMinValue)))
+	{
+		return fixed::MaxValue;
+	}
+	if (scaled < static_cast<double>(fixed::RawMinValue))
+	{
+		return fixed::MinValue;
+	}
+	return fixed(static_cast<raw>(scaled));
+}
+
+template <typename T, int F>
+Fixed<T, F> FixedCurve<T, F>::Saturate(const Int128& value)
+{
+	if (value > Int128(static_cast<int64_t>(fixed::RawMaxValue)))
+	{
+		return fixed::MaxValue;
+	}
+	if (value < Int128(static_cast<int64_t>(fixed::RawMinValue)))
+	{
+		return fixed::MinValue;
+	}
+	return fixed(static_cast<raw>(value.Low()));
+}
+
+template <typename T, int F>
+Fixed<T, F> FixedCurve<T, F>::Evaluate(fixed x) const
+{
+	const uraw offset = static_cast<uraw>(static_cast<uraw>(std::clamp(x.rawValue, min, max)) - static_cast<uraw>(min));
+	const size_t index = static_cast<size_t>(offset >> shift);
+	const uraw within = static_cast<uraw>(offset & ((static_cast<uraw>(1) << shift) - 1));
+	const fixed t = fixed(static_cast<raw>(static_cast<uraw>(within << up) >> down));
+	return table[index] + (table[index + 1] - table[index]) * t;
+}
+
+template <typename T, int F>
+void FixedCurve<T, F>::Evaluate(std::span<const fixed> x, std::span<fixed> out) const
+{
+	FXMATH_ASSERT(x.size() == out.size() && "Input and output spans must be the same length.");
+
+	size_t i = 0;
+#if FXMATH_AVX2
+	if constexpr (std::is_same_v<fixed, fixed32>)
+	{
+		using namespace Mathfx::simd;
+
+		const int* base = reinterpret_cast<const int*>(table.data());
+		const __m256i low = _mm256_set1_epi32(min);
+		const __m256i high = _mm256_set1_epi32(max);
+		const __m256i mask = _mm256_set1_epi32(static_cast<int>((static_cast<uint32_t>(1) << shift) - 1));
+		const __m128i shiftCount = _mm_cvtsi32_si128(shift);
+		const __m128i upCount = _mm_cvtsi32_si128(up);
+		const __m128i downCount = _mm_cvtsi32_si128(down);
+		for (; i + 8 <= x.size(); i += 8)
+		{
+			__m256i offset = _mm256_sub_epi32(_mm256_min_epi32(_mm256_max_epi32(Load8(&x[i]), low), high), low);
+			__m256i index = _mm256_srl_epi32(offset, shiftCount);
+			__m256i t = _mm256_srl_epi32(_mm256_sll_epi32(_mm256_and_si256(offset, mask), upCount), downCount);
+			__m256i left = _mm256_i32gather_epi32(base, index, 4);
+			__m256i right = _mm256_i32gather_epi32(base, _mm256_add_epi32(index, _mm256_set1_epi32(1)), 4);
+			Store8(&out[i], _mm256_add_epi32(left, FastMul8(_mm256_sub_epi32(right, left), t)));
+		}
+	}
+#endif
+	for (; i < x.size(); ++i)
+	{
+		out[i] = Evaluate(x[i]);
+	}
+}
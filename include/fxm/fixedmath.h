@@ -1,6 +1,7 @@
 #pragma once
 
 #include "fixedtype.h"
+#include "fixedwide.h"
 
 namespace Mathfx
 {
@@ -268,6 +269,13 @@ namespace Mathfx
 		return FastMul(Log2(x), fixed::Ln2);
 	}
 
+	template <typename T, int F>
+	Fixed<T, F> Exp(Fixed<T, F> x)
+	{
+		using fixed = Fixed<T, F>;
+		return Pow2(x / fixed::Ln2);
+	}
+
 	template <typename T, int F>
 	Fixed<T, F> Pow(Fixed<T, F> base, Fixed<T, F> exp)
 	{
@@ -293,6 +301,89 @@ namespace Mathfx
 		return result;
 	}
 
+	namespace internal
+	{
+		// Linear interpolation in a table with 2^StepBits intervals per unit, 0 <= x below the last entry's position.
+		// Rounds towards negative infinity like FastMul, the batch kernels reproduce it exactly.
+		template <int StepBits, typename T, int F, size_t Size>
+		constexpr Fixed<T, F> InterpolateLookup(const std::array<Fixed<T, F>, Size>& table, T x)
+		{
+			// Table slopes stay below 2, so delta * fraction stays below 2^(2 * (F - StepBits) + 1)
+			static_assert(F - StepBits <= 30, "Too many fractional bits per table interval to interpolate in 64 bits.");
+
+			if constexpr (F > StepBits)
+			{
+				constexpr int shift = F - StepBits;
+				const size_t index = static_cast<size_t>(x >> shift);
+				const int64_t fraction = x & ((static_cast<T>(1) << shift) - 1);
+				const int64_t delta = static_cast<int64_t>(table[index + 1].rawValue) - table[index].rawValue;
+				return Fixed<T, F>(static_cast<T>(table[index].rawValue + ((delta * fraction) >> shift)));
+			}
+			else
+			{
+				return table[static_cast<size_t>(x) << (StepBits - F)];
+			}
+		}
+	}
+
+	/**
+	 * \brief Hyperbolic tangent interpolated from TanhLookupTable, accurate to about 4e-7 plus rounding.
+	 * Odd like tanh, saturates to +-tanh(8) beyond the table.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Tanh(Fixed<T, F> x)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+		using uraw = typename fixed::uraw;
+
+		constexpr uraw limit = static_cast<uraw>(fixed::TanhLookupRange) << fixed::FractionShift;
+		constexpr int stepBits = std::countr_zero((fixed::ActivationLookupTableSize - 1) / fixed::TanhLookupRange);
+
+		const bool negative = x.rawValue < 0;
+		const uraw magnitude = negative ? static_cast<uraw>(0) - static_cast<uraw>(x.rawValue) : static_cast<uraw>(x.rawValue);
+		const fixed value = magnitude >= limit ? fixed::TanhLookupTable.back() : internal::InterpolateLookup<stepBits>(fixed::TanhLookupTable, static_cast<raw>(magnitude));
+		return negative ? fixed(static_cast<raw>(-value.rawValue)) : value;
+	}
+
+	/**
+	 * \brief Logistic function 1 / (1 + e^-x), computed as (1 + Tanh(x / 2)) / 2 from the same table.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Sigmoid(Fixed<T, F> x)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+		return fixed(static_cast<raw>((fixed::RawOne + Tanh(x >> 1).rawValue) >> 1));
+	}
+
+	/**
+	 * \brief e^x as 2^(x log2(e)), the integer part of the exponent is a shift and the fraction is interpolated from
+	 * Exp2LookupTable, relative error about 1e-8 plus the rounding of x log2(e). Saturates to MaxValue, underflows to zero.
+	 * Much cheaper than Exp, which sums a series and divides for negative arguments.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> FastExp(Fixed<T, F> x)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		const fixed exponent = WideToFixedSaturated<T, F>(WideMul(x, fixed::Log2E));
+		const raw whole = exponent.rawValue >> fixed::FractionShift;
+		if (whole > fixed::NumBits - fixed::FractionShift - 2)
+		{
+			return fixed::MaxValue;
+		}
+
+		constexpr int stepBits = std::countr_zero(fixed::ActivationLookupTableSize - 1);
+		const raw mantissa = internal::InterpolateLookup<stepBits>(fixed::Exp2LookupTable, static_cast<raw>(exponent.rawValue & fixed::FractionMask)).rawValue;
+		if (whole >= 0)
+		{
+			return fixed(static_cast<raw>(mantissa << whole));
+		}
+		return -whole >= fixed::NumBits ? fixed::Zero : fixed(static_cast<raw>(mantissa >> -whole));
+	}
+
 	template <typename T, int F>
 	Fixed<T, F> Sqrt(Fixed<T, F> x)
 	{
@@ -445,6 +536,55 @@ namespace Mathfx
 		return result;
 	}
 
+	/**
+	 * \brief Calculates 1 / sqrt(x) without going through the long division in SafeDiv.
+	 * Seeds Newton-Raphson with a power of two within a factor of sqrt(2) of the answer and iterates until it stops changing,
+	 * so the result only depends on the input and is identical on every machine.
+	 * Relative error is around 1e-9 for fixed64, gets worse for tiny inputs where x * y runs out of fractional bits.
+	 * \param x Number to take the inverse square root of, must be greater than zero.
+	 * \return 1 / sqrt(\p x)
+	 */
+	template <typename T, int F>
+	Fixed<T, F> InvSqrt(Fixed<T, F> x)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+		using uraw = typename fixed::uraw;
+
+		raw xr = x.rawValue;
+		FXMATH_ASSERT(xr > 0 && "Invalid argument.");
+
+		// x = m * 2^exponent with m in [1, 2), seed = 2^-ceil(exponent / 2) puts x * seed^2 in [0.5, 2)
+		int exponent = (fixed::NumBits - 1 - std::countl_zero(static_cast<uraw>(xr))) - fixed::FractionShift;
+		int seedShift = fixed::FractionShift - ((exponent + 1) >> 1);
+		fixed y(static_cast<raw>(static_cast<raw>(1) << seedShift));
+
+		constexpr int maxIterations = 8;
+		for (int i = 0; i < maxIterations; ++i)
+		{
+			// y' = y * (3 - x * y * y) / 2, multiply x by y first so y * y can't overflow for small x
+			fixed xyy = FastMul(FastMul(x, y), y);
+			fixed next(static_cast<raw>(FastMul(y, fixed(static_cast<raw>(fixed::RawThree - xyy.rawValue))).rawValue >> 1));
+			if (next == y)
+			{
+				break;
+			}
+			y = next;
+		}
+
+		return y;
+	}
+
+	/**
+	 * \brief sqrt(x * x + y * y) rounded down, exact for every input. The squares are kept at full width so nothing
+	 * overflows on the way, only a result past MaxValue saturates.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> Hypot(Fixed<T, F> x, Fixed<T, F> y)
+	{
+		return WideSqrt<T, F>(Int128::Mul(x.rawValue, x.rawValue) + Int128::Mul(y.rawValue, y.rawValue));
+	}
+
 	namespace internal
 	{
 		template <typename T, int F>
@@ -0,0 +1,303 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <limits>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+
+// Define FXMATH_NO_SIMD to force the scalar fallbacks, they produce bit-identical results to the vector paths
+#if !defined(FXMATH_NO_SIMD) && defined(__AVX2__)
+#define FXMATH_AVX2 1
+#include <immintrin.h>
+#else
+#define FXMATH_AVX2 0
+#endif
+
+/**
+ * \brief Allocator for std::vector that aligns storage to \p Alignment bytes so SIMD kernels can use aligned loads.
+ * \tparam T Element type
+ * \tparam Alignment Alignment in bytes, must be a power of two.
+ */
+template <typename T, size_t Alignment = 64>
+struct AlignedAllocator
+{
+	using value_type = T;
+
+	static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+	static_assert(Alignment >= alignof(T), "Alignment must be at least the natural alignment of T.");
+
+	template <typename U>
+	struct rebind
+	{
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	constexpr AlignedAllocator() noexcept = default;
+
+	template <typename U>
+	constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+	T* allocate(size_t count)
+	{
+		if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+		{
+			throw std::bad_array_new_length();
+		}
+		return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+	}
+
+	void deallocate(T* ptr, size_t) noexcept
+	{
+		::operator delete(ptr, std::align_val_t(Alignment));
+	}
+
+	template <typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+	template <typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+namespace Mathfx
+{
+	namespace simd
+	{
+#if FXMATH_AVX2
+		static_assert(fixed64::FractionShift == 32, "FastMul4 splits lanes at 32 bits and relies on fixed64 having 32 fractional bits.");
+
+		inline __m256i Load4(const fixed64* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+		inline void Store4(fixed64* ptr, __m256i value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+		inline __m256i Splat4(fixed64 value) { return _mm256_set1_epi64x(value.rawValue); }
+
+		/**
+		 * \brief Four lane fixed64 multiply, bit-identical to fixed64::FastMul in every lane.
+		 * AVX2 has no 64 bit multiply so this follows the same 32 bit split as FastMul, using unsigned 32x32 multiplies
+		 * and correcting the two mixed terms for negative operands.
+		 */
+		inline __m256i FastMul4(__m256i x, __m256i y)
+		{
+			const __m256i zero = _mm256_setzero_si256();
+			__m256i xhi = _mm256_srli_epi64(x, 32);
+			__m256i yhi = _mm256_srli_epi64(y, 32);
+
+			__m256i lolo = _mm256_mul_epu32(x, y);
+			__m256i lohi = _mm256_mul_epu32(x, yhi);
+			__m256i hilo = _mm256_mul_epu32(xhi, y);
+			__m256i hihi = _mm256_mul_epu32(xhi, yhi);
+
+			// The high halves are signed, an unsigned multiply of a negative half is off by (other low half << 32)
+			__m256i xNegative = _mm256_cmpgt_epi64(zero, x);
+			__m256i yNegative = _mm256_cmpgt_epi64(zero, y);
+			lohi = _mm256_sub_epi64(lohi, _mm256_and_si256(yNegative, _mm256_slli_epi64(x, 32)));
+			hilo = _mm256_sub_epi64(hilo, _mm256_and_si256(xNegative, _mm256_slli_epi64(y, 32)));
+
+			__m256i sum = _mm256_srli_epi64(lolo, 32);
+			sum = _mm256_add_epi64(sum, lohi);
+			sum = _mm256_add_epi64(sum, hilo);
+			sum = _mm256_add_epi64(sum, _mm256_slli_epi64(hihi, 32));
+			return sum;
+		}
+
+		// Unsigned a >= b per lane, AVX2 only has a signed compare so flip the sign bits first
+		inline __m256i GreaterEqualUnsigned4(__m256i a, __m256i b)
+		{
+			const __m256i signBit = _mm256_set1_epi64x(static_cast<int64_t>(0x8000000000000000ull));
+			__m256i bGreater = _mm256_cmpgt_epi64(_mm256_xor_si256(b, signBit), _mm256_xor_si256(a, signBit));
+			return _mm256_xor_si256(bGreater, _mm256_set1_epi64x(-1));
+		}
+
+		/**
+		 * \brief Four lane fixed64 square root, bit-identical to Mathfx::FastSqrt in every lane.
+		 * FastSqrt always runs the same number of iterations regardless of input, so the only per lane difference is
+		 * whether each step subtracts, which becomes a mask instead of a branch.
+		 */
+		inline __m256i FastSqrt4(__m256i x)
+		{
+			__m256i r = x;
+			__m256i q = _mm256_setzero_si256();
+			for (uint64_t bit = 0x4000000000000000ull; bit > 0x40; bit >>= 1)
+			{
+				const __m256i b = _mm256_set1_epi64x(static_cast<int64_t>(bit));
+				__m256i t = _mm256_add_epi64(q, b);
+				__m256i take = GreaterEqualUnsigned4(r, t);
+				r = _mm256_sub_epi64(r, _mm256_and_si256(take, t));
+				q = _mm256_blendv_epi8(q, _mm256_add_epi64(t, b), take);
+				r = _mm256_slli_epi64(r, 1);
+			}
+			return _mm256_srli_epi64(q, 16);
+		}
+
+		/**
+		 * \brief Loads four interleaved Vector2fx as separate x and y registers.
+		 * Lanes come out in element order 0, 2, 1, 3, StoreInterleaved4 and Unshuffle4 undo it.
+		 */
+		inline void LoadDeinterleaved4(const fixed64* ptr, __m256i& x, __m256i& y)
+		{
+			__m256i a = Load4(ptr);
+			__m256i b = Load4(ptr + 4);
+			x = _mm256_unpacklo_epi64(a, b);
+			y = _mm256_unpackhi_epi64(a, b);
+		}
+
+		inline void StoreInterleaved4(fixed64* ptr, __m256i x, __m256i y)
+		{
+			Store4(ptr, _mm256_unpacklo_epi64(x, y));
+			Store4(ptr + 4, _mm256_unpackhi_epi64(x, y));
+		}
+
+		// Puts lanes loaded by LoadDeinterleaved4 back into element order 0, 1, 2, 3
+		inline __m256i Unshuffle4(__m256i v)
+		{
+			return _mm256_permute4x64_epi64(v, 0xD8);
+		}
+
+		// Transposes four rows of four values in place, e.g. four Aabb2fx loaded whole become min.x, min.y, max.x, max.y registers
+		inline void Transpose4x4(__m256i& r0, __m256i& r1, __m256i& r2, __m256i& r3)
+		{
+			__m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+			__m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+			__m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+			__m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+			r0 = _mm256_permute2x128_si256(t0, t2, 0x20);
+			r1 = _mm256_permute2x128_si256(t1, t3, 0x20);
+			r2 = _mm256_permute2x128_si256(t0, t2, 0x31);
+			r3 = _mm256_permute2x128_si256(t1, t3, 0x31);
+		}
+
+		static_assert(fixed32::FractionShift == 16, "FastMul8 shifts products by 16 and relies on fixed32 having 16 fractional bits.");
+
+		inline __m256i Load8(const fixed32* ptr) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); }
+		inline void Store8(fixed32* ptr, __m256i value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), value); }
+		inline __m256i Splat8(fixed32 value) { return _mm256_set1_epi32(value.rawValue); }
+
+		/**
+		 * \brief fixed32 FastMul of the even 32 bit lanes, the results land in the even lanes and the odd lanes hold garbage.
+		 * FastMul keeps the low 32 bits of the full product shifted right by 16, which a logical 64 bit shift gives just as well.
+		 */
+		inline __m256i FastMulEven8(__m256i x, __m256i y)
+		{
+			return _mm256_srli_epi64(_mm256_mul_epi32(x, y), 16);
+		}
+
+		/**
+		 * \brief Eight lane fixed32 multiply, bit-identical to fixed32::FastMul in every lane.
+		 */
+		inline __m256i FastMul8(__m256i x, __m256i y)
+		{
+			__m256i even = FastMulEven8(x, y);
+			__m256i odd = FastMulEven8(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32));
+			return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+		}
+
+		/**
+		 * \brief Adds four signed 64 bit values to a pair of lane sums, the low 32 bits as unsigned to \p low and the value
+		 * shifted down by 32 to \p high. CombineSplitSigned4 then gives the exact total while each lane has taken fewer than
+		 * 2^32 values.
+		 */
+		inline void AddSplitSigned4(__m256i& low, __m256i& high, __m256i x)
+		{
+			low = _mm256_add_epi64(low, _mm256_and_si256(x, _mm256_set1_epi64x(0xFFFFFFFF)));
+			// AVX2 has no 64 bit arithmetic shift, the odd 32 bit lanes take the sign of the high half instead
+			high = _mm256_add_epi64(high, _mm256_blend_epi32(_mm256_srli_epi64(x, 32), _mm256_srai_epi32(x, 31), 0xAA));
+		}
+
+		inline Int128 CombineSplitSigned4(__m256i low, __m256i high)
+		{
+			uint64_t lows[4];
+			int64_t highs[4];
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(lows), low);
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(highs), high);
+			Int128 sum;
+			for (int i = 0; i < 4; ++i)
+			{
+				sum += Int128(0, lows[i]);
+				sum += Int128(highs[i]) << 32;
+			}
+			return sum;
+		}
+
+		/**
+		 * \brief Adds the eight full 64 bit fixed32 products x * y to split lane sums, CombineSplitSigned4 of them is exactly
+		 * the 128 bit sum FixedAccumulator<int32_t, 16>::MulAdd makes of the same products.
+		 */
+		inline void WideMulAdd8(__m256i& low, __m256i& high, __m256i x, __m256i y)
+		{
+			AddSplitSigned4(low, high, _mm256_mul_epi32(x, y));
+			AddSplitSigned4(low, high, _mm256_mul_epi32(_mm256_srli_epi64(x, 32), _mm256_srli_epi64(y, 32)));
+		}
+
+		inline int64_t HorizontalSum4(__m256i x)
+		{
+			__m128i sum = _mm_add_epi64(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+			return _mm_cvtsi128_si64(sum) + _mm_extract_epi64(sum, 1);
+		}
+
+		/**
+		 * \brief Eight lane Mathfx::internal::InterpolateLookup for fixed32 tables with 2^(16 - Shift) intervals per unit.
+		 * Both ends of every lane's interval are gathered, the caller keeps x inside the table.
+		 */
+		template <int Shift>
+		inline __m256i InterpolateLookup8(const fixed32* table, __m256i x)
+		{
+			const int* base = reinterpret_cast<const int*>(table);
+			__m256i index = _mm256_srli_epi32(x, Shift);
+			__m256i fraction = _mm256_and_si256(x, _mm256_set1_epi32((1 << Shift) - 1));
+			__m256i low = _mm256_i32gather_epi32(base, index, 4);
+			__m256i high = _mm256_i32gather_epi32(base, _mm256_add_epi32(index, _mm256_set1_epi32(1)), 4);
+			return _mm256_add_epi32(low, _mm256_srai_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(high, low), fraction), Shift));
+		}
+
+		/**
+		 * \brief Eight lane fixed32 tanh, bit-identical to Mathfx::Tanh in every lane.
+		 */
+		inline __m256i Tanh8(__m256i x)
+		{
+			constexpr int shift = fixed32::FractionShift - std::countr_zero((fixed32::ActivationLookupTableSize - 1) / fixed32::TanhLookupRange);
+			const __m256i limit = _mm256_set1_epi32(fixed32::TanhLookupRange << fixed32::FractionShift);
+
+			// abs of MinValue stays 0x80000000, which the unsigned min still sees as past the limit
+			__m256i magnitude = _mm256_abs_epi32(x);
+			__m256i inside = _mm256_cmpgt_epi32(limit, _mm256_min_epu32(magnitude, limit));
+			magnitude = _mm256_min_epu32(magnitude, _mm256_sub_epi32(limit, _mm256_set1_epi32(1)));
+			__m256i value = InterpolateLookup8<shift>(fixed32::TanhLookupTable.data(), magnitude);
+			value = _mm256_blendv_epi8(Splat8(fixed32::TanhLookupTable.back()), value, inside);
+			return _mm256_sign_epi32(value, x);
+		}
+
+		/**
+		 * \brief Eight lane fixed32 sigmoid, bit-identical to Mathfx::Sigmoid in every lane.
+		 */
+		inline __m256i Sigmoid8(__m256i x)
+		{
+			__m256i t = Tanh8(_mm256_srai_epi32(x, 1));
+			return _mm256_srai_epi32(_mm256_add_epi32(_mm256_set1_epi32(fixed32::RawOne), t), 1);
+		}
+
+		/**
+		 * \brief Eight lane fixed32 e^x, bit-identical to Mathfx::FastExp in every lane.
+		 */
+		inline __m256i FastExp8(__m256i x)
+		{
+			constexpr int shift = fixed32::FractionShift - std::countr_zero(fixed32::ActivationLookupTableSize - 1);
+			constexpr int maxWhole = fixed32::NumBits - fixed32::FractionShift - 2;
+
+			// Past +-64 the result has already saturated or underflowed, clamping keeps x * log2(e) from overflowing
+			const __m256i bound = _mm256_set1_epi32(64 << fixed32::FractionShift);
+			x = _mm256_max_epi32(_mm256_min_epi32(x, bound), _mm256_sub_epi32(_mm256_setzero_si256(), bound));
+			__m256i exponent = FastMul8(x, Splat8(fixed32::Log2E));
+			__m256i whole = _mm256_srai_epi32(exponent, fixed32::FractionShift);
+			__m256i fraction = _mm256_and_si256(exponent, _mm256_set1_epi32(fixed32::FractionMask));
+			__m256i mantissa = InterpolateLookup8<shift>(fixed32::Exp2LookupTable.data(), fraction);
+
+			// Variable shifts by 32 or more give zero, which is the underflow result
+			__m256i zero = _mm256_setzero_si256();
+			__m256i left = _mm256_sllv_epi32(mantissa, _mm256_max_epi32(whole, zero));
+			__m256i right = _mm256_srav_epi32(mantissa, _mm256_max_epi32(_mm256_sub_epi32(zero, whole), zero));
+			__m256i result = _mm256_blendv_epi8(right, left, _mm256_cmpgt_epi32(whole, _mm256_set1_epi32(-1)));
+			return _mm256_blendv_epi8(result, Splat8(fixed32::MaxValue), _mm256_cmpgt_epi32(whole, _mm256_set1_epi32(maxWhole)));
+		}
+#endif
+	}
+}
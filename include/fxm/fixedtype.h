@@ -94,6 +94,14 @@ struct Fixed
 	static const std::array<fixed, TrigLookupTableSize> SinLookupTable;
 	static const std::array<fixed, TrigLookupTableSize> TanLookupTable;
 
+	// Activation tables include both end points so interpolating the last interval never reads past the end
+	static constexpr size_t ActivationLookupTableSize = (1 << 12) + 1;
+	static constexpr int TanhLookupRange = 8;
+
+	// tanh over [0, TanhLookupRange] and 2^x over [0, 1], rounded to nearest
+	static const std::array<fixed, ActivationLookupTableSize> TanhLookupTable;
+	static const std::array<fixed, ActivationLookupTableSize> Exp2LookupTable;
+
 	// static Fixed constants
 	static const Fixed<T, F> Zero;
 	static const Fixed<T, F> One;
@@ -111,6 +119,7 @@ struct Fixed
 	static const Fixed<T, F> OneOverTwoPi;
 	static const Fixed<T, F> LargePi;
 	static const Fixed<T, F> Ln2;
+	static const Fixed<T, F> Log2E;
 	static const Fixed<T, F> LutSize;
 	static const Fixed<T, F> Deg2Rad;
 	static const Fixed<T, F> Rad2Deg;
@@ -123,7 +132,7 @@ struct Fixed
 	explicit constexpr Fixed(uraw value) : rawValue(static_cast<raw>(value)) {}
 
 	// Static methods for casting from other numerical types, explicitly not implemented as constructors to avoid ambiguity between intended raw value construction.
-	static constexpr fixed Int(int value) { return fixed(static_cast<T>(value) * RawOne); }
+	static constexpr fixed Int(int value) { return fixed(static_cast<T>(static_cast<T>(value) * RawOne)); }
 	static constexpr fixed Float(float value) { return fixed(static_cast<T>(value * RawOne)); }
 	static constexpr fixed Float(double value) { return fixed(static_cast<T>(value * RawOne)); }
 
@@ -243,10 +252,22 @@ private:
 		return fixed::Float(t);
 	}
 
-	template <fixed(*Proj)(int, size_t)>
+	static fixed MakeTanhLutEntry(int i, size_t n)
+	{
+		double x = (i * static_cast<double>(TanhLookupRange)) / (n - 1);
+		return fixed(static_cast<T>(std::llround(std::tanh(x) * RawOne)));
+	}
+
+	static fixed MakeExp2LutEntry(int i, size_t n)
+	{
+		double x = static_cast<double>(i) / (n - 1);
+		return fixed(static_cast<T>(std::llround(std::exp2(x) * RawOne)));
+	}
+
+	template <fixed(*Proj)(int, size_t), size_t Size = TrigLookupTableSize>
 	constexpr static auto MakeInternalLookupTable()
 	{
-		return MakeLookupTable<fixed, Proj, TrigLookupTableSize>();
+		return MakeLookupTable<fixed, Proj, Size>();
 	}
 };
 
@@ -267,8 +288,9 @@ template <typename T, int F> const Fixed<T, F> Fixed<T, F>::OneOverPi = fixed::F
 template <typename T, int F> const Fixed<T, F> Fixed<T, F>::OneOverTwoPi = fixed::Float(1.0 / (2 * std::numbers::pi_v<double>));
 template <typename T, int F> const Fixed<T, F> Fixed<T, F>::LargePi = fixed::Float(std::numbers::pi_v<double> *LargePiMulti);
 template <typename T, int F> const Fixed<T, F> Fixed<T, F>::Ln2 = fixed::Float(std::numbers::ln2_v<double>);
+template <typename T, int F> const Fixed<T, F> Fixed<T, F>::Log2E = fixed::Float(std::numbers::log2e_v<double>);
 template <typename T, int F> const Fixed<T, F> Fixed<T, F>::LutSize = fixed::Int(static_cast<int>(TrigLookupTableSize - 1));
-template <typename T, int F> const Fixed<T, F> Fixed<T, F>::Deg2Rad = fixed::Float(1.0 / 180.0) * TwoPi;
+template <typename T, int F> const Fixed<T, F> Fixed<T, F>::Deg2Rad = fixed::Float(std::numbers::pi_v<double> / 180.0);
 template <typename T, int F> const Fixed<T, F> Fixed<T, F>::Rad2Deg = OneOverTwoPi * fixed::Int(360);
 
 // Lookup Tables
@@ -278,6 +300,12 @@ const std::array<Fixed<T, F>, Fixed<T, F>::TrigLookupTableSize> Fixed<T, F>::Sin
 template <typename T, int F>
 const std::array<Fixed<T, F>, Fixed<T, F>::TrigLookupTableSize> Fixed<T, F>::TanLookupTable = MakeInternalLookupTable<&MakeTanLutEntry>();
 
+template <typename T, int F>
+const std::array<Fixed<T, F>, Fixed<T, F>::ActivationLookupTableSize> Fixed<T, F>::TanhLookupTable = MakeInternalLookupTable<&MakeTanhLutEntry, ActivationLookupTableSize>();
+
+template <typename T, int F>
+const std::array<Fixed<T, F>, Fixed<T, F>::ActivationLookupTableSize> Fixed<T, F>::Exp2LookupTable = MakeInternalLookupTable<&MakeExp2LutEntry, ActivationLookupTableSize>();
+
 // Mathematical functions
 template <typename T, int F>
 constexpr Fixed<T, F> Fixed<T, F>::SafeAdd(fixed x, fixed y)
@@ -451,13 +479,13 @@ constexpr Fixed<T, F> Fixed<T, F>::SafeMod(fixed x, fixed y)
 template <typename T, int F>
 constexpr Fixed<T, F> Fixed<T, F>::FastAdd(fixed x, fixed y)
 {
-	return fixed(x.rawValue + y.rawValue);
+	return fixed(static_cast<raw>(x.rawValue + y.rawValue));
 }
 
 template <typename T, int F>
 constexpr Fixed<T, F> Fixed<T, F>::FastSub(fixed x, fixed y)
 {
-	return fixed(x.rawValue - y.rawValue);
+	return fixed(static_cast<raw>(x.rawValue - y.rawValue));
 }
 
 template <typename T, int F>
@@ -510,14 +538,14 @@ template <typename T, int F> constexpr Fixed<T, F> operator/(Fixed<T, F> x, Fixe
 template <typename T, int F> constexpr Fixed<T, F> operator%(Fixed<T, F> x, Fixed<T, F> y) { return x %= y; }
 
 // Unary Negation
-template <typename T, int F> constexpr Fixed<T, F> operator-(Fixed<T, F> x) { return (x == Fixed<T, F>::MinValue) ? Fixed<T, F>::MaxValue : Fixed<T, F>(-x.rawValue); }
+template <typename T, int F> constexpr Fixed<T, F> operator-(Fixed<T, F> x) { return (x == Fixed<T, F>::MinValue) ? Fixed<T, F>::MaxValue : Fixed<T, F>(static_cast<T>(-x.rawValue)); }
 
 // Bitwise operators
 template <typename T, int F> constexpr Fixed<T, F> operator&(Fixed<T, F> x, Fixed<T, F> y) { return x &= y; }
 template <typename T, int F> constexpr Fixed<T, F> operator|(Fixed<T, F> x, Fixed<T, F> y) { return x |= y; }
 template <typename T, int F> constexpr Fixed<T, F> operator^(Fixed<T, F> x, Fixed<T, F> y) { return x ^= y; }
-template <typename T, int F> constexpr Fixed<T, F> operator<<(const Fixed<T, F>& x, int shift) { return x <<= shift; }
-template <typename T, int F> constexpr Fixed<T, F> operator>>(const Fixed<T, F>& x, int shift) { return x >>= shift; }
+template <typename T, int F> constexpr Fixed<T, F> operator<<(Fixed<T, F> x, int shift) { return x <<= shift; }
+template <typename T, int F> constexpr Fixed<T, F> operator>>(Fixed<T, F> x, int shift) { return x >>= shift; }
 template <typename T, int F> constexpr Fixed<T, F> operator~(const Fixed<T, F>& x) { return Fixed<T, F>(~x.rawValue); }
 
 // Comparison operators
@@ -0,0 +1,512 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "fixedtype.h"
+
+/**
+ * \brief Minimal two's complement 128 bit signed integer used to hold raw fixed64 products without truncation.
+ * Both halves are stored unsigned so all arithmetic wraps instead of hitting signed overflow, the value is signed when read.
+ */
+struct Int128
+{
+	uint64_t lo = 0;
+	uint64_t hi = 0;
+
+	constexpr Int128() = default;
+	constexpr Int128(int64_t value) : lo(static_cast<uint64_t>(value)), hi(value < 0 ? ~static_cast<uint64_t>(0) : 0) {}
+	constexpr Int128(uint64_t high, uint64_t low) : lo(low), hi(high) {}
+
+	static constexpr Int128 MulUnsigned(uint64_t a, uint64_t b);
+	static constexpr Int128 Mul(int64_t a, int64_t b);
+
+	// Quotient of x read as unsigned, the remainder goes to remainder when given
+	static constexpr Int128 DivUnsigned(const Int128& x, uint64_t divisor, uint64_t* remainder = nullptr);
+
+	// Signed x / divisor rounded towards negative infinity
+	static constexpr Int128 DivFloor(const Int128& x, uint64_t divisor);
+
+	constexpr int64_t High() const { return static_cast<int64_t>(hi); }
+	constexpr int64_t Low() const { return static_cast<int64_t>(lo); }
+	constexpr bool IsNegative() const { return static_cast<int64_t>(hi) < 0; }
+	constexpr int Sign() const { return IsNegative() ? -1 : ((hi | lo) != 0 ? 1 : 0); }
+
+	// True when the value survives truncation to 64 bits, i.e. the high half is just the sign extension of the low half
+	constexpr bool FitsInt64() const { return hi == (static_cast<int64_t>(lo) < 0 ? ~static_cast<uint64_t>(0) : 0); }
+
+	constexpr int64_t SaturateToInt64() const
+	{
+		if (FitsInt64())
+		{
+			return Low();
+		}
+		return IsNegative() ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+	}
+
+	constexpr Int128& operator+=(const Int128& other)
+	{
+		uint64_t sum = lo + other.lo;
+		hi += other.hi + (sum < lo ? 1 : 0);
+		lo = sum;
+		return *this;
+	}
+
+	constexpr Int128& operator-=(const Int128& other)
+	{
+		uint64_t diff = lo - other.lo;
+		hi -= other.hi + (diff > lo ? 1 : 0);
+		lo = diff;
+		return *this;
+	}
+
+	constexpr Int128& operator<<=(int shift)
+	{
+		if (shift >= 64)
+		{
+			hi = lo << (shift - 64);
+			lo = 0;
+		}
+		else if (shift > 0)
+		{
+			hi = (hi << shift) | (lo >> (64 - shift));
+			lo <<= shift;
+		}
+		return *this;
+	}
+
+	// Arithmetic shift, rounds towards negative infinity the same way >> does on the raw value of a Fixed
+	constexpr Int128& operator>>=(int shift)
+	{
+		if (shift >= 64)
+		{
+			lo = static_cast<uint64_t>(static_cast<int64_t>(hi) >> (shift - 64));
+			hi = static_cast<uint64_t>(static_cast<int64_t>(hi) >> 63);
+		}
+		else if (shift > 0)
+		{
+			lo = (lo >> shift) | (hi << (64 - shift));
+			hi = static_cast<uint64_t>(static_cast<int64_t>(hi) >> shift);
+		}
+		return *this;
+	}
+};
+
+constexpr Int128 Int128::MulUnsigned(uint64_t a, uint64_t b)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 product = static_cast<unsigned __int128>(a) * b;
+	return Int128(static_cast<uint64_t>(product >> 64), static_cast<uint64_t>(product));
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+	if (!std::is_constant_evaluated())
+	{
+		uint64_t high;
+		uint64_t low = _umul128(a, b, &high);
+		return Int128(high, low);
+	}
+#endif
+	constexpr uint64_t lowMask = 0xFFFFFFFFull;
+	uint64_t aLo = a & lowMask;
+	uint64_t aHi = a >> 32;
+	uint64_t bLo = b & lowMask;
+	uint64_t bHi = b >> 32;
+
+	uint64_t lolo = aLo * bLo;
+	uint64_t lohi = aLo * bHi;
+	uint64_t hilo = aHi * bLo;
+	uint64_t hihi = aHi * bHi;
+
+	uint64_t mid = (lolo >> 32) + (lohi & lowMask) + (hilo & lowMask);
+	uint64_t low = (mid << 32) | (lolo & lowMask);
+	uint64_t high = hihi + (lohi >> 32) + (hilo >> 32) + (mid >> 32);
+	return Int128(high, low);
+#endif
+}
+
+constexpr Int128 Int128::Mul(int64_t a, int64_t b)
+{
+	// Signed product is the unsigned product of the two's complement bit patterns with the high half corrected for each negative operand
+	Int128 result = MulUnsigned(static_cast<uint64_t>(a), static_cast<uint64_t>(b));
+	if (a < 0)
+	{
+		result.hi -= static_cast<uint64_t>(b);
+	}
+	if (b < 0)
+	{
+		result.hi -= static_cast<uint64_t>(a);
+	}
+	return result;
+}
+
+constexpr Int128 Int128::DivUnsigned(const Int128& x, uint64_t divisor, uint64_t* remainder)
+{
+#if defined(__SIZEOF_INT128__)
+	const unsigned __int128 value = (static_cast<unsigned __int128>(x.hi) << 64) | x.lo;
+	const unsigned __int128 quotient = value / divisor;
+	if (remainder)
+	{
+		*remainder = static_cast<uint64_t>(value % divisor);
+	}
+	return Int128(static_cast<uint64_t>(quotient >> 64), static_cast<uint64_t>(quotient));
+#else
+	// The high half divides in hardware, the low half is long division of (rest : lo) one bit at a time. rest stays below
+	// the divisor but can carry out of 64 bits when shifted, the carry means it's past the divisor too.
+	const uint64_t high = x.hi / divisor;
+	uint64_t rest = x.hi % divisor;
+	uint64_t low = 0;
+#if defined(_MSC_VER) && defined(_M_X64)
+	if (!std::is_constant_evaluated())
+	{
+		low = _udiv128(rest, x.lo, divisor, &rest);
+		if (remainder)
+		{
+			*remainder = rest;
+		}
+		return Int128(high, low);
+	}
+#endif
+	for (int bit = 63; bit >= 0; --bit)
+	{
+		const bool carry = (rest >> 63) != 0;
+		rest = (rest << 1) | ((x.lo >> bit) & 1);
+		low <<= 1;
+		if (carry || rest >= divisor)
+		{
+			rest -= divisor;
+			low |= 1;
+		}
+	}
+	if (remainder)
+	{
+		*remainder = rest;
+	}
+	return Int128(high, low);
+#endif
+}
+
+constexpr Int128 Int128::DivFloor(const Int128& x, uint64_t divisor)
+{
+	if (!x.IsNegative())
+	{
+		return DivUnsigned(x, divisor);
+	}
+
+	// floor(-a / d) = -ceil(a / d)
+	Int128 magnitude;
+	magnitude -= x;
+	uint64_t remainder = 0;
+	Int128 quotient = DivUnsigned(magnitude, divisor, &remainder);
+	if (remainder != 0)
+	{
+		quotient += Int128(1);
+	}
+	Int128 result;
+	result -= quotient;
+	return result;
+}
+
+constexpr Int128 operator+(Int128 a, const Int128& b) { return a += b; }
+constexpr Int128 operator-(Int128 a, const Int128& b) { return a -= b; }
+constexpr Int128 operator-(const Int128& a) { return Int128() - a; }
+constexpr Int128 operator<<(Int128 a, int shift) { return a <<= shift; }
+constexpr Int128 operator>>(Int128 a, int shift) { return a >>= shift; }
+constexpr bool operator==(const Int128& a, const Int128& b) { return a.hi == b.hi && a.lo == b.lo; }
+constexpr bool operator!=(const Int128& a, const Int128& b) { return !(a == b); }
+constexpr bool operator<(const Int128& a, const Int128& b) { return a.High() < b.High() || (a.hi == b.hi && a.lo < b.lo); }
+constexpr bool operator>(const Int128& a, const Int128& b) { return b < a; }
+constexpr bool operator<=(const Int128& a, const Int128& b) { return !(b < a); }
+constexpr bool operator>=(const Int128& a, const Int128& b) { return !(a < b); }
+
+/**
+ * \brief Integer type wide enough to hold the full product of two raw values of \p T.
+ * 32 bit and smaller backing types widen to int64_t, 64 bit backing types widen to Int128.
+ */
+template <typename T>
+struct WideRaw
+{
+	static_assert(sizeof(T) <= 4, "No wide type for backing type.");
+	using type = int64_t;
+};
+
+template <>
+struct WideRaw<int64_t>
+{
+	using type = Int128;
+};
+
+template <typename T>
+using WideRawT = typename WideRaw<T>::type;
+
+namespace Mathfx
+{
+	/**
+	 * \brief Full precision product of two raw fixed point values, the result has 2 * F fractional bits.
+	 */
+	template <typename T, int F>
+	constexpr WideRawT<T> WideMul(Fixed<T, F> x, Fixed<T, F> y)
+	{
+		if constexpr (sizeof(T) == 8)
+		{
+			return Int128::Mul(x.rawValue, y.rawValue);
+		}
+		else
+		{
+			return static_cast<int64_t>(x.rawValue) * static_cast<int64_t>(y.rawValue);
+		}
+	}
+
+	/**
+	 * \brief Widens a fixed point value to the same 2 * F fractional bit scale WideMul produces so it can be added to a product.
+	 */
+	template <typename T, int F>
+	constexpr WideRawT<T> Widen(Fixed<T, F> x)
+	{
+		return WideRawT<T>(static_cast<int64_t>(x.rawValue)) << F;
+	}
+
+	/**
+	 * \brief Drops the extra F fractional bits of a wide value and truncates back to Fixed.
+	 * Rounds towards negative infinity exactly like FastMul, so WideToFixed(WideMul(x, y)) == FastMul(x, y).
+	 * Wraps when the result doesn't fit, same as the Fast operations.
+	 */
+	template <typename T, int F>
+	constexpr Fixed<T, F> WideToFixed(WideRawT<T> wide)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		wide >>= F;
+		if constexpr (sizeof(T) == 8)
+		{
+			return fixed(static_cast<raw>(wide.Low()));
+		}
+		else
+		{
+			return fixed(static_cast<raw>(static_cast<typename fixed::uraw>(wide)));
+		}
+	}
+
+	/**
+	 * \brief Same as WideToFixed but clamps to MinValue/MaxValue instead of wrapping.
+	 */
+	template <typename T, int F>
+	constexpr Fixed<T, F> WideToFixedSaturated(WideRawT<T> wide)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		wide >>= F;
+		if constexpr (sizeof(T) == 8)
+		{
+			return fixed(static_cast<raw>(wide.SaturateToInt64()));
+		}
+		else
+		{
+			if (wide > static_cast<int64_t>(fixed::RawMaxValue))
+			{
+				return fixed::MaxValue;
+			}
+			if (wide < static_cast<int64_t>(fixed::RawMinValue))
+			{
+				return fixed::MinValue;
+			}
+			return fixed(static_cast<raw>(wide));
+		}
+	}
+
+	/**
+	 * \brief Square root of a sum of squared raw values rounded down, saturated to MaxValue.
+	 * Squares of raw values have 2 * F fractional bits, so the integer root of the sum is directly the raw result.
+	 * Integer Newton iterations only, so the result is identical on every machine and never touches floating point.
+	 * \param sumOfSquares Non-negative, compared as unsigned so sums of squares up to 2^128 are fine
+	 */
+	template <typename T, int F>
+	Fixed<T, F> WideSqrt(const Int128& sumOfSquares)
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		// Anything from 2^126 up has a root of at least 2^63, past every backing type's range
+		if (sumOfSquares.hi >= (static_cast<uint64_t>(1) << 62))
+		{
+			return fixed::MaxValue;
+		}
+		if ((sumOfSquares.hi | sumOfSquares.lo) == 0)
+		{
+			return fixed::Zero;
+		}
+
+		// Seed with 2^ceil(bits / 2), which is at or above the root. From above, root' = (root + sum / root) / 2 falls
+		// towards the root without ever passing below floor(sqrt(sum)), so the first step that doesn't fall ends on it.
+		// The quotient is never above the root and both fit 64 bits.
+		const int bits = sumOfSquares.hi != 0 ? 128 - std::countl_zero(sumOfSquares.hi) : 64 - std::countl_zero(sumOfSquares.lo);
+		uint64_t root = static_cast<uint64_t>(1) << ((bits + 1) >> 1);
+		while (true)
+		{
+			const uint64_t quotient = Int128::DivUnsigned(sumOfSquares, root).lo;
+			const uint64_t next = (root >> 1) + (quotient >> 1) + (root & quotient & 1);
+			if (next >= root)
+			{
+				break;
+			}
+			root = next;
+		}
+		return root > static_cast<uint64_t>(fixed::RawMaxValue) ? fixed::MaxValue : fixed(static_cast<raw>(root));
+	}
+}
+
+/**
+ * \brief Sum of fixed point values and products held at double the fractional precision.
+ * Products are added without truncation so a chain of multiply-adds only rounds once when the result is read,
+ * and because the wide sum is plain integer addition the result doesn't depend on the order values were added in.
+ * The sum is 128 bits for every backing type, a single product of full scale fixed32 values is already 2^62, so fixed32
+ * sums are exact for up to 2^65 products. Full scale fixed64 products are 2^126 and only a few fit, past 2^127 the sum
+ * wraps modulo 2^128.
+ * \tparam T Backing type of the fixed point values being accumulated
+ * \tparam F Fractional bits of the fixed point values being accumulated
+ */
+template <typename T, int F>
+struct FixedAccumulator
+{
+	using fixed = Fixed<T, F>;
+	using raw = typename fixed::raw;
+	using wide = Int128;
+
+	wide value;
+
+	constexpr void Add(fixed x) { value += wide(Mathfx::Widen(x)); }
+	constexpr void Sub(fixed x) { value -= wide(Mathfx::Widen(x)); }
+	constexpr void MulAdd(fixed x, fixed y) { value += wide(Mathfx::WideMul(x, y)); }
+	constexpr void MulSub(fixed x, fixed y) { value -= wide(Mathfx::WideMul(x, y)); }
+	constexpr void Merge(const FixedAccumulator& other) { value += other.value; }
+
+	// Truncates to the low bits of the type like WideToFixed
+	constexpr fixed Result() const { return fixed(static_cast<raw>((value >> F).Low())); }
+
+	constexpr fixed SaturatedResult() const
+	{
+		const wide shifted = value >> F;
+		if (shifted > wide(static_cast<int64_t>(fixed::RawMaxValue)))
+		{
+			return fixed::MaxValue;
+		}
+		if (shifted < wide(static_cast<int64_t>(fixed::RawMinValue)))
+		{
+			return fixed::MinValue;
+		}
+		return fixed(static_cast<raw>(shifted.Low()));
+	}
+};
+
+/**
+ * \brief Divides many values by the same fixed point divisor without running the long division loop for each of them.
+ * The constructor pays for one division to build a 64 bit reciprocal, after that Divide is two wide multiplies and a
+ * correction step, and gives exactly SafeDiv(x, divisor) including its rounding and saturation.
+ * \tparam T Backing type, only 64 bit types are supported since narrower ones already divide in hardware
+ */
+template <typename T, int F>
+struct FixedDivisor
+{
+	static_assert(sizeof(T) == 8, "FixedDivisor is only implemented for 64 bit backing types.");
+
+	using fixed = Fixed<T, F>;
+	using raw = typename fixed::raw;
+
+	constexpr FixedDivisor() = default;
+	explicit constexpr FixedDivisor(fixed divisor);
+
+	constexpr fixed Divide(fixed x) const;
+	constexpr fixed Divisor() const { return fixed(negative ? -static_cast<raw>(magnitude) : static_cast<raw>(magnitude)); }
+
+private:
+	// |divisor| = magnitude with bitLength significant bits, reciprocal = floor(2^(62 + bitLength) / magnitude) lies in (2^62, 2^63]
+	// Defaults divide by one
+	uint64_t magnitude = static_cast<uint64_t>(1) << F;
+	uint64_t reciprocal = static_cast<uint64_t>(1) << 63;
+	int shift = 63;
+	bool negative = false;
+};
+
+template <typename T, int F>
+constexpr FixedDivisor<T, F>::FixedDivisor(fixed divisor)
+{
+	FXMATH_ASSERT(divisor.rawValue != 0 && "Divide by zero");
+
+	negative = divisor.rawValue < 0;
+	magnitude = negative ? static_cast<uint64_t>(0) - static_cast<uint64_t>(divisor.rawValue) : static_cast<uint64_t>(divisor.rawValue);
+
+	// Restoring division of 2^(62 + bitLength) by magnitude, the remainder stays below magnitude so doubling it can't overflow
+	const int bitLength = 64 - std::countl_zero(magnitude);
+	const int numeratorBits = 62 + bitLength;
+	uint64_t remainder = 0;
+	reciprocal = 0;
+	for (int bit = numeratorBits; bit >= 0; --bit)
+	{
+		remainder = (remainder << 1) | (bit == numeratorBits ? 1 : 0);
+		if (remainder >= magnitude)
+		{
+			remainder -= magnitude;
+			if (bit < 64)
+			{
+				reciprocal |= static_cast<uint64_t>(1) << bit;
+			}
+		}
+	}
+	shift = numeratorBits - F;
+}
+
+template <typename T, int F>
+constexpr Fixed<T, F> FixedDivisor<T, F>::Divide(fixed x) const
+{
+	const bool resultNegative = (x.rawValue < 0) != negative;
+	const uint64_t dividend = x.rawValue < 0 ? static_cast<uint64_t>(0) - static_cast<uint64_t>(x.rawValue) : static_cast<uint64_t>(x.rawValue);
+
+	// The reciprocal is less than one below the exact value, which puts the estimate at most a couple below the truncated
+	// quotient whenever it is in range, the remainder of the exact numerator fixes that and gives the rounding bit.
+	// The numerator is below 2^(64 + F) and the estimate a quotient of it, so neither product can overflow 128 bits.
+	const Int128 estimate = Int128::MulUnsigned(dividend, reciprocal) >> shift;
+	if (estimate.hi != 0 || estimate.lo > static_cast<uint64_t>(fixed::RawMaxValue))
+	{
+		return resultNegative ? fixed::MinValue : fixed::MaxValue;
+	}
+
+	// The true remainder is below a few times magnitude, for divisors under 2^61 it fits in 64 bits and wrapping
+	// arithmetic gives it exactly, larger ones take the wide path
+	uint64_t quotient = estimate.lo;
+	if (magnitude < (static_cast<uint64_t>(1) << 61))
+	{
+		uint64_t remainder = (dividend << F) - quotient * magnitude;
+		while (remainder >= magnitude)
+		{
+			remainder -= magnitude;
+			++quotient;
+		}
+
+		// Round half away from zero like SafeDiv
+		quotient += remainder >= magnitude - remainder ? 1 : 0;
+	}
+	else
+	{
+		Int128 remainder = Int128(static_cast<uint64_t>(0), dividend) << F;
+		remainder -= Int128::MulUnsigned(quotient, magnitude);
+		const Int128 divisorWide(static_cast<uint64_t>(0), magnitude);
+		while (remainder >= divisorWide)
+		{
+			remainder -= divisorWide;
+			++quotient;
+		}
+		quotient += remainder >= divisorWide - remainder ? 1 : 0;
+	}
+	if (quotient > static_cast<uint64_t>(fixed::RawMaxValue))
+	{
+		return resultNegative ? fixed::MinValue : fixed::MaxValue;
+	}
+	return fixed(resultNegative ? -static_cast<raw>(quotient) : static_cast<raw>(quotient));
+}
@@ -2,4 +2,30 @@
 
 #include "fixedtype.h"
 #include "fixedmath.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+#include "fixedbatch.h"
 #include "vector2fx.h"
+#include "vector2fxsoa.h"
+#include "vector3fx.h"
+#include "quaternionfx.h"
+#include "matrixfx.h"
+#include "rotation2fx.h"
+#include "predicates2fx.h"
+#include "shapes2fx.h"
+#include "spatialgrid2fx.h"
+#include "aabbtree2fx.h"
+#include "sortfx.h"
+#include "parallelfx.h"
+#include "integrator2fx.h"
+#include "collision2fx.h"
+#include "ray2fx.h"
+#include "fftfx.h"
+#include "filterfx.h"
+#include "gemmfx.h"
+#include "blasfx.h"
+#include "solver2fx.h"
+#include "convolvefx.h"
+#include "statsfx.h"
+#include "splinefx.h"
+#include "fixedcurve.h"
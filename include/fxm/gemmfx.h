@@ -0,0 +1,198 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "fixedsimd.h"
+#include "parallelfx.h"
+
+namespace Mathfx
+{
+	enum class GemmActivation
+	{
+		None,
+		ReLU,
+		Clamp,
+		Tanh,
+	};
+
+	/**
+	 * \brief Work applied to every output of Gemm before it is stored: the bias is added to the exact sum before it is
+	 * rounded, the activation after.
+	 */
+	template <typename T, int F>
+	struct GemmEpilogue
+	{
+		using fixed = Fixed<T, F>;
+
+		// One value per output column, or empty for no bias
+		std::span<const fixed> bias = {};
+		GemmActivation activation = GemmActivation::None;
+
+		// Range for GemmActivation::Clamp
+		fixed clampMin = fixed::MinValue;
+		fixed clampMax = fixed::MaxValue;
+	};
+
+	/**
+	 * \brief c = activation(a * b + bias) for row-major matrices, a is m x k, b is k x n and c is m x n.
+	 * Every output is the exact sum of the full products held in 64 bits, rounded towards negative infinity and saturated
+	 * once like FixedAccumulator::SaturatedResult, so results are bit-identical on every machine, thread count and with or
+	 * without AVX2. The sum is exact while k * max|a| * max|b| + max|bias| * 2^F stays below 2^63 in raw units, a single
+	 * product of full scale fixed32 values is already 2^62. Past that the sum wraps modulo 2^64, the same way on every path.
+	 * B is packed once into panels of 8 columns, the 4 row by 8 column register tiles sweep all of k over one panel while
+	 * blocks of rows stay in cache. Row blocks are spread over the pool. Call with explicit template arguments,
+	 * e.g. Gemm<int32_t, 16>(m, n, k, a, b, c).
+	 * \tparam T Backing type, 16 and 32 bit types only, 64 bit values would need 128 bit sums
+	 */
+	template <typename T, int F>
+	void Gemm(size_t m, size_t n, size_t k, std::span<const Fixed<T, F>> a, std::span<const Fixed<T, F>> b, std::span<Fixed<T, F>> c,
+		const GemmEpilogue<T, F>& epilogue = {}, ThreadPool& pool = DefaultThreadPool());
+
+	namespace internal
+	{
+		constexpr size_t GemmTileRows = 4;
+		constexpr size_t GemmPanelColumns = 8;
+		constexpr size_t GemmBlockRows = 64;
+
+		// Panels store each row of 8 columns as c0, c4, c1, c5, c2, c6, c3, c7 so a 256 bit load has columns 0-3 in the even
+		// 32 bit lanes and columns 4-7 in the odd ones, which is what the 32 x 32 -> 64 bit lane multiply reads
+		constexpr size_t GemmPanelSlot(size_t column)
+		{
+			return column < 4 ? 2 * column : 2 * (column - 4) + 1;
+		}
+
+		// Exact 64 bit sums of one register tile, sums[r][column] in natural column order
+		template <size_t Rows, typename T, int F>
+		void GemmTile(const Fixed<T, F>* a, size_t lda, const int32_t* panel, size_t k, int64_t (&sums)[GemmTileRows][GemmPanelColumns])
+		{
+#if FXMATH_AVX2
+			__m256i low[Rows];
+			__m256i high[Rows];
+			for (size_t r = 0; r < Rows; ++r)
+			{
+				low[r] = _mm256_setzero_si256();
+				high[r] = _mm256_setzero_si256();
+			}
+			for (size_t p = 0; p < k; ++p)
+			{
+				const __m256i columns = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&panel[p * GemmPanelColumns]));
+				const __m256i highColumns = _mm256_srli_epi64(columns, 32);
+				for (size_t r = 0; r < Rows; ++r)
+				{
+					const __m256i value = _mm256_set1_epi32(a[r * lda + p].rawValue);
+					low[r] = _mm256_add_epi64(low[r], _mm256_mul_epi32(value, columns));
+					high[r] = _mm256_add_epi64(high[r], _mm256_mul_epi32(value, highColumns));
+				}
+			}
+			for (size_t r = 0; r < Rows; ++r)
+			{
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&sums[r][0]), low[r]);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&sums[r][4]), high[r]);
+			}
+#else
+			for (size_t r = 0; r < Rows; ++r)
+			{
+				std::fill(std::begin(sums[r]), std::end(sums[r]), 0);
+			}
+			for (size_t p = 0; p < k; ++p)
+			{
+				const int32_t* columns = &panel[p * GemmPanelColumns];
+				for (size_t r = 0; r < Rows; ++r)
+				{
+					const int64_t value = a[r * lda + p].rawValue;
+					for (size_t column = 0; column < GemmPanelColumns; ++column)
+					{
+						// Unsigned adds wrap like the vector lanes do instead of overflowing
+						const int64_t product = value * columns[GemmPanelSlot(column)];
+						sums[r][column] = static_cast<int64_t>(static_cast<uint64_t>(sums[r][column]) + static_cast<uint64_t>(product));
+					}
+				}
+			}
+#endif
+		}
+
+		template <typename T, int F>
+		Fixed<T, F> GemmOutput(int64_t sum, size_t column, const GemmEpilogue<T, F>& epilogue)
+		{
+			using fixed = Fixed<T, F>;
+
+			if (!epilogue.bias.empty())
+			{
+				sum = static_cast<int64_t>(static_cast<uint64_t>(sum) + static_cast<uint64_t>(Widen(epilogue.bias[column])));
+			}
+			fixed result = WideToFixedSaturated<T, F>(sum);
+			switch (epilogue.activation)
+			{
+			case GemmActivation::ReLU:
+				return Max(result, fixed::Zero);
+			case GemmActivation::Clamp:
+				return Clamp(result, epilogue.clampMin, epilogue.clampMax);
+			case GemmActivation::Tanh:
+				return Tanh(result);
+			default:
+				return result;
+			}
+		}
+	}
+
+	template <typename T, int F>
+	void Gemm(size_t m, size_t n, size_t k, std::span<const Fixed<T, F>> a, std::span<const Fixed<T, F>> b, std::span<Fixed<T, F>> c,
+		const GemmEpilogue<T, F>& epilogue, ThreadPool& pool)
+	{
+		static_assert(sizeof(T) <= 4, "Gemm accumulates in 64 bits and only supports 16 and 32 bit backing types.");
+		FXMATH_ASSERT(a.size() == m * k && b.size() == k * n && c.size() == m * n && "Matrix spans must match the dimensions.");
+		FXMATH_ASSERT((epilogue.bias.empty() || epilogue.bias.size() == n) && "Need one bias value per output column.");
+
+		using namespace internal;
+
+		// Zero padded columns past n just add zeros to sums that are never stored
+		const size_t panelCount = (n + GemmPanelColumns - 1) / GemmPanelColumns;
+		std::vector<int32_t> panels(panelCount * k * GemmPanelColumns, 0);
+		for (size_t p = 0; p < k; ++p)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				const size_t panel = j / GemmPanelColumns;
+				panels[(panel * k + p) * GemmPanelColumns + GemmPanelSlot(j % GemmPanelColumns)] = b[p * n + j].rawValue;
+			}
+		}
+
+		const size_t blockCount = (m + GemmBlockRows - 1) / GemmBlockRows;
+		pool.ParallelFor(blockCount, [&](size_t block) {
+			const size_t rowBegin = block * GemmBlockRows;
+			const size_t rowEnd = std::min(rowBegin + GemmBlockRows, m);
+			int64_t sums[GemmTileRows][GemmPanelColumns];
+			for (size_t panel = 0; panel < panelCount; ++panel)
+			{
+				const int32_t* packed = panels.data() + panel * k * GemmPanelColumns;
+				const size_t columnBegin = panel * GemmPanelColumns;
+				const size_t columns = std::min(GemmPanelColumns, n - columnBegin);
+				for (size_t row = rowBegin; row < rowEnd; row += GemmTileRows)
+				{
+					const size_t rows = std::min(GemmTileRows, rowEnd - row);
+					const Fixed<T, F>* rowData = a.data() + row * k;
+					switch (rows)
+					{
+					case 4: GemmTile<4>(rowData, k, packed, k, sums); break;
+					case 3: GemmTile<3>(rowData, k, packed, k, sums); break;
+					case 2: GemmTile<2>(rowData, k, packed, k, sums); break;
+					default: GemmTile<1>(rowData, k, packed, k, sums); break;
+					}
+					for (size_t r = 0; r < rows; ++r)
+					{
+						for (size_t column = 0; column < columns; ++column)
+						{
+							c[(row + r) * n + columnBegin + column] = GemmOutput(sums[r][column], columnBegin + column, epilogue);
+						}
+					}
+				}
+			}
+		});
+	}
+}
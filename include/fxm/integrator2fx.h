@@ -0,0 +1,160 @@
+#pragma once
+
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedsimd.h"
+#include "parallelfx.h"
+#include "vector2fx.h"
+#include "vector2fxsoa.h"
+
+/**
+ * \brief Fixed step integrators over structure of arrays entity state, updated in place.
+ * Every entity gets exactly the result of the per entity expression given for each stepper, with plain Vector2fx math,
+ * whatever the thread count or whether AVX2 is enabled. Work is split across the pool in ParallelChunkSize chunks.
+ */
+struct Integrator2fx
+{
+	using fixed = fixed64;
+
+	/**
+	 * \brief Per entity velocity retention for one step, factors[i] = Exp(-damping[i] * dt).
+	 * Exp is expensive, with a fixed timestep compute these once and pass them to every step.
+	 */
+	static void DampingFactors(std::span<const fixed> damping, fixed dt, std::span<fixed> factors,
+		Mathfx::ThreadPool& pool = Mathfx::DefaultThreadPool());
+
+	/**
+	 * \brief Semi-implicit Euler, per entity: v = (v + a * dt) * factor; p = p + v * dt.
+	 * \param dampingFactors One factor per entity from DampingFactors, or empty for no damping.
+	 */
+	static void SemiImplicitEuler(Vector2fxSoA& positions, Vector2fxSoA& velocities, const Vector2fxSoA& accelerations, fixed dt,
+		std::span<const fixed> dampingFactors = {}, Mathfx::ThreadPool& pool = Mathfx::DefaultThreadPool());
+
+	/**
+	 * \brief Position Verlet, per entity: next = p + (p - previous) * factor + a * (dt * dt); previous = p; p = next.
+	 * Velocity is implicit in the previous positions, seed them with p - v * dt.
+	 * \param dampingFactors One factor per entity from DampingFactors, or empty for no damping.
+	 */
+	static void Verlet(Vector2fxSoA& positions, Vector2fxSoA& previousPositions, const Vector2fxSoA& accelerations, fixed dt,
+		std::span<const fixed> dampingFactors = {}, Mathfx::ThreadPool& pool = Mathfx::DefaultThreadPool());
+
+private:
+	static void SemiImplicitEulerRange(fixed* px, fixed* py, fixed* vx, fixed* vy, const fixed* ax, const fixed* ay, const fixed* factors,
+		fixed dt, size_t begin, size_t end);
+	static void VerletRange(fixed* px, fixed* py, fixed* qx, fixed* qy, const fixed* ax, const fixed* ay, const fixed* factors,
+		fixed dtSquared, size_t begin, size_t end);
+};
+
+void Integrator2fx::DampingFactors(std::span<const fixed> damping, fixed dt, std::span<fixed> factors, Mathfx::ThreadPool& pool)
+{
+	Mathfx::ParallelTransform(damping, factors, [dt](fixed d) { return Mathfx::Exp(-(d * dt)); }, pool);
+}
+
+void Integrator2fx::SemiImplicitEuler(Vector2fxSoA& positions, Vector2fxSoA& velocities, const Vector2fxSoA& accelerations, fixed dt,
+	std::span<const fixed> dampingFactors, Mathfx::ThreadPool& pool)
+{
+	const size_t count = positions.Size();
+	FXMATH_ASSERT(velocities.Size() == count && accelerations.Size() == count && "Arrays must be the same length.");
+	FXMATH_ASSERT((dampingFactors.empty() || dampingFactors.size() == count) && "Need one damping factor per entity.");
+
+	const fixed* factors = dampingFactors.empty() ? nullptr : dampingFactors.data();
+	pool.ParallelFor(Mathfx::ParallelChunkCount(count), [&](size_t chunk) {
+		const size_t begin = chunk * Mathfx::ParallelChunkSize;
+		SemiImplicitEulerRange(positions.x.data(), positions.y.data(), velocities.x.data(), velocities.y.data(),
+			accelerations.x.data(), accelerations.y.data(), factors, dt, begin, std::min(begin + Mathfx::ParallelChunkSize, count));
+	});
+}
+
+void Integrator2fx::Verlet(Vector2fxSoA& positions, Vector2fxSoA& previousPositions, const Vector2fxSoA& accelerations, fixed dt,
+	std::span<const fixed> dampingFactors, Mathfx::ThreadPool& pool)
+{
+	const size_t count = positions.Size();
+	FXMATH_ASSERT(previousPositions.Size() == count && accelerations.Size() == count && "Arrays must be the same length.");
+	FXMATH_ASSERT((dampingFactors.empty() || dampingFactors.size() == count) && "Need one damping factor per entity.");
+
+	const fixed* factors = dampingFactors.empty() ? nullptr : dampingFactors.data();
+	const fixed dtSquared = dt * dt;
+	pool.ParallelFor(Mathfx::ParallelChunkCount(count), [&](size_t chunk) {
+		const size_t begin = chunk * Mathfx::ParallelChunkSize;
+		VerletRange(positions.x.data(), positions.y.data(), previousPositions.x.data(), previousPositions.y.data(),
+			accelerations.x.data(), accelerations.y.data(), factors, dtSquared, begin, std::min(begin + Mathfx::ParallelChunkSize, count));
+	});
+}
+
+void Integrator2fx::SemiImplicitEulerRange(fixed* px, fixed* py, fixed* vx, fixed* vy, const fixed* ax, const fixed* ay, const fixed* factors,
+	fixed dt, size_t begin, size_t end)
+{
+	size_t i = begin;
+#if FXMATH_AVX2
+	const __m256i step = Mathfx::simd::Splat4(dt);
+	for (; i + 4 <= end; i += 4)
+	{
+		__m256i velocityX = _mm256_add_epi64(Mathfx::simd::Load4(&vx[i]), Mathfx::simd::FastMul4(Mathfx::simd::Load4(&ax[i]), step));
+		__m256i velocityY = _mm256_add_epi64(Mathfx::simd::Load4(&vy[i]), Mathfx::simd::FastMul4(Mathfx::simd::Load4(&ay[i]), step));
+		if (factors)
+		{
+			__m256i factor = Mathfx::simd::Load4(&factors[i]);
+			velocityX = Mathfx::simd::FastMul4(velocityX, factor);
+			velocityY = Mathfx::simd::FastMul4(velocityY, factor);
+		}
+		Mathfx::simd::Store4(&vx[i], velocityX);
+		Mathfx::simd::Store4(&vy[i], velocityY);
+		Mathfx::simd::Store4(&px[i], _mm256_add_epi64(Mathfx::simd::Load4(&px[i]), Mathfx::simd::FastMul4(velocityX, step)));
+		Mathfx::simd::Store4(&py[i], _mm256_add_epi64(Mathfx::simd::Load4(&py[i]), Mathfx::simd::FastMul4(velocityY, step)));
+	}
+#endif
+	for (; i < end; ++i)
+	{
+		Vector2fx velocity = Vector2fx(vx[i], vy[i]) + Vector2fx(ax[i], ay[i]) * dt;
+		if (factors)
+		{
+			velocity *= factors[i];
+		}
+		vx[i] = velocity.x;
+		vy[i] = velocity.y;
+		px[i] += velocity.x * dt;
+		py[i] += velocity.y * dt;
+	}
+}
+
+void Integrator2fx::VerletRange(fixed* px, fixed* py, fixed* qx, fixed* qy, const fixed* ax, const fixed* ay, const fixed* factors,
+	fixed dtSquared, size_t begin, size_t end)
+{
+	size_t i = begin;
+#if FXMATH_AVX2
+	const __m256i step = Mathfx::simd::Splat4(dtSquared);
+	for (; i + 4 <= end; i += 4)
+	{
+		__m256i positionX = Mathfx::simd::Load4(&px[i]);
+		__m256i positionY = Mathfx::simd::Load4(&py[i]);
+		__m256i deltaX = _mm256_sub_epi64(positionX, Mathfx::simd::Load4(&qx[i]));
+		__m256i deltaY = _mm256_sub_epi64(positionY, Mathfx::simd::Load4(&qy[i]));
+		if (factors)
+		{
+			__m256i factor = Mathfx::simd::Load4(&factors[i]);
+			deltaX = Mathfx::simd::FastMul4(deltaX, factor);
+			deltaY = Mathfx::simd::FastMul4(deltaY, factor);
+		}
+		Mathfx::simd::Store4(&qx[i], positionX);
+		Mathfx::simd::Store4(&qy[i], positionY);
+		Mathfx::simd::Store4(&px[i], _mm256_add_epi64(_mm256_add_epi64(positionX, deltaX), Mathfx::simd::FastMul4(Mathfx::simd::Load4(&ax[i]), step)));
+		Mathfx::simd::Store4(&py[i], _mm256_add_epi64(_mm256_add_epi64(positionY, deltaY), Mathfx::simd::FastMul4(Mathfx::simd::Load4(&ay[i]), step)));
+	}
+#endif
+	for (; i < end; ++i)
+	{
+		const Vector2fx position(px[i], py[i]);
+		Vector2fx delta = position - Vector2fx(qx[i], qy[i]);
+		if (factors)
+		{
+			delta *= factors[i];
+		}
+		const Vector2fx next = position + delta + Vector2fx(ax[i], ay[i]) * dtSquared;
+		qx[i] = position.x;
+		qy[i] = position.y;
+		px[i] = next.x;
+		py[i] = next.y;
+	}
+}
@@ -0,0 +1,413 @@
+#pragma once
+
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+#include "vector3fx.h"
+
+/**
+ * \brief Row major N x N fixed64 matrix, use the Matrix2fx/Matrix3fx/Matrix4fx aliases.
+ * Every element of a product is accumulated at double precision and truncated once, so the result of a multiply
+ * doesn't depend on the order of the dot product terms and doesn't lose a bit of precision per term like chained FastMul does.
+ * \tparam N Number of rows and columns, 2 to 4.
+ */
+template <int N>
+struct Matrixfx
+{
+	using fixed = fixed64;
+	using matrix = Matrixfx<N>;
+
+	static_assert(N >= 2 && N <= 4, "Only 2x2, 3x3 and 4x4 matrices are supported.");
+
+	static constexpr int Size = N;
+
+	fixed m[N][N] = {};
+
+	static matrix Identity()
+	{
+		matrix result;
+		for (int i = 0; i < N; ++i)
+		{
+			result.m[i][i] = fixed::One;
+		}
+		return result;
+	}
+
+	fixed* operator[](int row) { return m[row]; }
+	const fixed* operator[](int row) const { return m[row]; }
+
+	matrix& operator*=(const matrix& other)
+	{
+		*this = Multiply(*this, other);
+		return *this;
+	}
+
+	static matrix Multiply(const matrix& a, const matrix& b)
+	{
+		matrix result;
+		for (int row = 0; row < N; ++row)
+		{
+			for (int col = 0; col < N; ++col)
+			{
+				FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+				for (int k = 0; k < N; ++k)
+				{
+					sum.MulAdd(a.m[row][k], b.m[k][col]);
+				}
+				result.m[row][col] = sum.Result();
+			}
+		}
+		return result;
+	}
+
+	static matrix Transpose(const matrix& a)
+	{
+		matrix result;
+		for (int row = 0; row < N; ++row)
+		{
+			for (int col = 0; col < N; ++col)
+			{
+				result.m[col][row] = a.m[row][col];
+			}
+		}
+		return result;
+	}
+
+	static fixed Determinant(const matrix& a);
+	static matrix Inverse(const matrix& a);
+	static bool ApproxEqual(const matrix& a, const matrix& b, int ignoreBits = fixed::EpsilonBits);
+
+	matrix Transposed() const { return Transpose(*this); }
+	matrix Inverted() const { return Inverse(*this); }
+
+private:
+	// Cofactor of element (row, col): signed determinant of the matrix with that row and column removed
+	static fixed Cofactor(const matrix& a, int row, int col)
+	{
+		if constexpr (N == 2)
+		{
+			fixed value = a.m[1 - row][1 - col];
+			return ((row + col) & 1) ? -value : value;
+		}
+		else
+		{
+			Matrixfx<N - 1> minor;
+			for (int r = 0, mr = 0; r < N; ++r)
+			{
+				if (r == row)
+				{
+					continue;
+				}
+				for (int c = 0, mc = 0; c < N; ++c)
+				{
+					if (c == col)
+					{
+						continue;
+					}
+					minor.m[mr][mc++] = a.m[r][c];
+				}
+				++mr;
+			}
+			fixed value = Matrixfx<N - 1>::Determinant(minor);
+			return ((row + col) & 1) ? -value : value;
+		}
+	}
+};
+
+using Matrix2fx = Matrixfx<2>;
+using Matrix3fx = Matrixfx<3>;
+using Matrix4fx = Matrixfx<4>;
+
+template <int N>
+fixed64 Matrixfx<N>::Determinant(const matrix& a)
+{
+	if constexpr (N == 2)
+	{
+		FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+		sum.MulAdd(a.m[0][0], a.m[1][1]);
+		sum.MulSub(a.m[0][1], a.m[1][0]);
+		return sum.Result();
+	}
+	else
+	{
+		// Laplace expansion along the first row, each cofactor is itself a single rounding
+		FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+		for (int col = 0; col < N; ++col)
+		{
+			sum.MulAdd(a.m[0][col], Cofactor(a, 0, col));
+		}
+		return sum.Result();
+	}
+}
+
+template <int N>
+Matrixfx<N> Matrixfx<N>::Inverse(const matrix& a)
+{
+	// Inverse is the transposed cofactor matrix over the determinant, reuse the cofactors for the determinant as well
+	matrix cofactors;
+	for (int row = 0; row < N; ++row)
+	{
+		for (int col = 0; col < N; ++col)
+		{
+			cofactors.m[row][col] = Cofactor(a, row, col);
+		}
+	}
+
+	FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+	for (int col = 0; col < N; ++col)
+	{
+		sum.MulAdd(a.m[0][col], cofactors.m[0][col]);
+	}
+	fixed determinant = sum.Result();
+
+	FXMATH_ASSERT(determinant != fixed::Zero && "Matrix is not invertible.");
+
+	matrix result;
+	for (int row = 0; row < N; ++row)
+	{
+		for (int col = 0; col < N; ++col)
+		{
+			result.m[col][row] = fixed::SafeDiv(cofactors.m[row][col], determinant);
+		}
+	}
+	return result;
+}
+
+template <int N>
+bool Matrixfx<N>::ApproxEqual(const matrix& a, const matrix& b, int ignoreBits)
+{
+	for (int row = 0; row < N; ++row)
+	{
+		for (int col = 0; col < N; ++col)
+		{
+			if (!Mathfx::ApproxEqual(a.m[row][col], b.m[row][col], ignoreBits))
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <int N> Matrixfx<N> operator*(Matrixfx<N> a, const Matrixfx<N>& b) { return a *= b; }
+
+template <int N>
+bool operator==(const Matrixfx<N>& a, const Matrixfx<N>& b)
+{
+	for (int row = 0; row < N; ++row)
+	{
+		for (int col = 0; col < N; ++col)
+		{
+			if (a.m[row][col] != b.m[row][col])
+			{
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <int N> bool operator!=(const Matrixfx<N>& a, const Matrixfx<N>& b) { return !(a == b); }
+
+inline Vector2fx operator*(const Matrix2fx& a, const Vector2fx& v)
+{
+	FixedAccumulator<fixed::raw, fixed::FractionShift> x, y;
+	x.MulAdd(a.m[0][0], v.x);
+	x.MulAdd(a.m[0][1], v.y);
+	y.MulAdd(a.m[1][0], v.x);
+	y.MulAdd(a.m[1][1], v.y);
+	return Vector2fx(x.Result(), y.Result());
+}
+
+inline Vector3fx operator*(const Matrix3fx& a, const Vector3fx& v)
+{
+	Vector3fx result;
+	for (int row = 0; row < 3; ++row)
+	{
+		FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+		sum.MulAdd(a.m[row][0], v.x);
+		sum.MulAdd(a.m[row][1], v.y);
+		sum.MulAdd(a.m[row][2], v.z);
+		result[row] = sum.Result();
+	}
+	return result;
+}
+
+/**
+ * \brief Transforms a point by a 4x4 matrix treating it as (x, y, z, 1), the projective row is ignored.
+ */
+inline Vector3fx TransformPoint(const Matrix4fx& a, const Vector3fx& v)
+{
+	Vector3fx result;
+	for (int row = 0; row < 3; ++row)
+	{
+		FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+		sum.MulAdd(a.m[row][0], v.x);
+		sum.MulAdd(a.m[row][1], v.y);
+		sum.MulAdd(a.m[row][2], v.z);
+		sum.Add(a.m[row][3]);
+		result[row] = sum.Result();
+	}
+	return result;
+}
+
+/**
+ * \brief Transforms a direction by a 4x4 matrix treating it as (x, y, z, 0), translation doesn't apply.
+ */
+inline Vector3fx TransformVector(const Matrix4fx& a, const Vector3fx& v)
+{
+	Vector3fx result;
+	for (int row = 0; row < 3; ++row)
+	{
+		FixedAccumulator<fixed::raw, fixed::FractionShift> sum;
+		sum.MulAdd(a.m[row][0], v.x);
+		sum.MulAdd(a.m[row][1], v.y);
+		sum.MulAdd(a.m[row][2], v.z);
+		result[row] = sum.Result();
+	}
+	return result;
+}
+
+/**
+ * \brief 2D affine transform, a 2x2 linear part followed by a translation. Equivalent to a 3x3 matrix with a bottom row of (0, 0, 1).
+ * Build it once from an angle with FromTranslationRotationScale and it can transform any number of points
+ * without evaluating Sin or Cos again.
+ */
+struct Affine2fx
+{
+	using fixed = fixed64;
+
+	Matrix2fx linear = Matrix2fx::Identity();
+	Vector2fx translation = Vector2fx::Zero;
+
+	static const Affine2fx Identity;
+
+	Affine2fx() = default;
+	Affine2fx(const Matrix2fx& linear, const Vector2fx& translation) : linear(linear), translation(translation) {}
+
+	Affine2fx& operator*=(const Affine2fx& other)
+	{
+		*this = Multiply(*this, other);
+		return *this;
+	}
+
+	static Affine2fx FromTranslation(const Vector2fx& translation);
+	static Affine2fx FromRotation(fixed radians);
+	static Affine2fx FromTranslationRotationScale(const Vector2fx& translation, fixed radians, const Vector2fx& scale);
+	static Affine2fx Multiply(const Affine2fx& a, const Affine2fx& b);
+	static Affine2fx Inverse(const Affine2fx& a);
+	static fixed Determinant(const Affine2fx& a);
+	static Vector2fx TransformPoint(const Affine2fx& a, const Vector2fx& point);
+	static Vector2fx TransformVector(const Affine2fx& a, const Vector2fx& vec);
+	static void TransformPoints(const Affine2fx& a, std::span<const Vector2fx> in, std::span<Vector2fx> out);
+	static void TransformPoints(const Affine2fx& a, std::span<Vector2fx> points);
+
+	Matrix3fx ToMatrix3() const;
+};
+
+const Affine2fx Affine2fx::Identity = Affine2fx();
+
+inline Affine2fx operator*(Affine2fx a, const Affine2fx& b) { return a *= b; }
+inline Vector2fx operator*(const Affine2fx& a, const Vector2fx& point) { return Affine2fx::TransformPoint(a, point); }
+inline bool operator==(const Affine2fx& a, const Affine2fx& b) { return a.linear == b.linear && a.translation == b.translation; }
+inline bool operator!=(const Affine2fx& a, const Affine2fx& b) { return !(a == b); }
+
+Affine2fx Affine2fx::FromTranslation(const Vector2fx& translation)
+{
+	return Affine2fx(Matrix2fx::Identity(), translation);
+}
+
+Affine2fx Affine2fx::FromRotation(fixed radians)
+{
+	return FromTranslationRotationScale(Vector2fx::Zero, radians, Vector2fx::One);
+}
+
+Affine2fx Affine2fx::FromTranslationRotationScale(const Vector2fx& translation, fixed radians, const Vector2fx& scale)
+{
+	fixed sin = Mathfx::Sin(radians);
+	fixed cos = Mathfx::Cos(radians);
+
+	Matrix2fx linear;
+	linear.m[0][0] = cos * scale.x;
+	linear.m[0][1] = -sin * scale.y;
+	linear.m[1][0] = sin * scale.x;
+	linear.m[1][1] = cos * scale.y;
+	return Affine2fx(linear, translation);
+}
+
+Affine2fx Affine2fx::Multiply(const Affine2fx& a, const Affine2fx& b)
+{
+	// (a * b)(p) == a(b(p)): linear parts multiply, b's translation goes through a
+	return Affine2fx(a.linear * b.linear, TransformPoint(a, b.translation));
+}
+
+Affine2fx Affine2fx::Inverse(const Affine2fx& a)
+{
+	Matrix2fx inverseLinear = Matrix2fx::Inverse(a.linear);
+	Vector2fx inverseTranslation = inverseLinear * a.translation;
+	return Affine2fx(inverseLinear, Vector2fx(-inverseTranslation.x, -inverseTranslation.y));
+}
+
+fixed64 Affine2fx::Determinant(const Affine2fx& a)
+{
+	return Matrix2fx::Determinant(a.linear);
+}
+
+Vector2fx Affine2fx::TransformPoint(const Affine2fx& a, const Vector2fx& point)
+{
+	FixedAccumulator<fixed::raw, fixed::FractionShift> x, y;
+	x.MulAdd(a.linear.m[0][0], point.x);
+	x.MulAdd(a.linear.m[0][1], point.y);
+	x.Add(a.translation.x);
+	y.MulAdd(a.linear.m[1][0], point.x);
+	y.MulAdd(a.linear.m[1][1], point.y);
+	y.Add(a.translation.y);
+	return Vector2fx(x.Result(), y.Result());
+}
+
+Vector2fx Affine2fx::TransformVector(const Affine2fx& a, const Vector2fx& vec)
+{
+	return a.linear * vec;
+}
+
+void Affine2fx::TransformPoints(const Affine2fx& a, std::span<const Vector2fx> in, std::span<Vector2fx> out)
+{
+	FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+	// Hoist the coefficients out of the loop, the per point work is four wide multiplies, two adds and two shifts
+	const fixed m00 = a.linear.m[0][0];
+	const fixed m01 = a.linear.m[0][1];
+	const fixed m10 = a.linear.m[1][0];
+	const fixed m11 = a.linear.m[1][1];
+	const auto tx = Mathfx::Widen(a.translation.x);
+	const auto ty = Mathfx::Widen(a.translation.y);
+
+	for (size_t i = 0; i < in.size(); ++i)
+	{
+		const Vector2fx p = in[i];
+		auto x = Mathfx::WideMul(m00, p.x) + Mathfx::WideMul(m01, p.y) + tx;
+		auto y = Mathfx::WideMul(m10, p.x) + Mathfx::WideMul(m11, p.y) + ty;
+		out[i] = Vector2fx(Mathfx::WideToFixed<fixed::raw, fixed::FractionShift>(x), Mathfx::WideToFixed<fixed::raw, fixed::FractionShift>(y));
+	}
+}
+
+void Affine2fx::TransformPoints(const Affine2fx& a, std::span<Vector2fx> points)
+{
+	TransformPoints(a, points, points);
+}
+
+Matrix3fx Affine2fx::ToMatrix3() const
+{
+	Matrix3fx result;
+	result.m[0][0] = linear.m[0][0];
+	result.m[0][1] = linear.m[0][1];
+	result.m[0][2] = translation.x;
+	result.m[1][0] = linear.m[1][0];
+	result.m[1][1] = linear.m[1][1];
+	result.m[1][2] = translation.y;
+	result.m[2][2] = fixed::One;
+	return result;
+}
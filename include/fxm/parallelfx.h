@@ -0,0 +1,332 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+
+namespace Mathfx
+{
+	/**
+	 * \brief Fork-join thread pool, the calling thread works alongside the pool threads and ParallelFor returns once every
+	 * chunk is done. Which thread runs which chunk varies from run to run, so anything built on it must make each chunk's
+	 * result independent of that, which is what the parallel Mathfx functions do.
+	 */
+	class ThreadPool
+	{
+	public:
+		/**
+		 * \param threadCount Total threads including the caller, 1 runs everything inline on the calling thread.
+		 */
+		explicit ThreadPool(size_t threadCount = std::max(1u, std::thread::hardware_concurrency()));
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		size_t ThreadCount() const { return workers.size() + 1; }
+
+		/**
+		 * \brief Calls \p fn(chunk) once for every chunk in [0, chunkCount) spread across the pool and waits for all of them.
+		 * Calls made from inside a running chunk run inline instead of deadlocking the pool. Calls from several outside
+		 * threads at once are safe, they take turns.
+		 */
+		template <typename Fn>
+		void ParallelFor(size_t chunkCount, Fn&& fn);
+
+	private:
+		using ChunkFn = void (*)(void*, size_t);
+
+		std::vector<std::thread> workers;
+
+		// Held by the caller for a whole ParallelFor, the pool runs one job at a time
+		std::mutex submitMutex;
+
+		std::mutex mutex;
+		std::condition_variable wake;
+		std::condition_variable finished;
+
+		// Current job, guarded by mutex except for nextChunk which workers claim chunks through
+		ChunkFn invoke = nullptr;
+		void* context = nullptr;
+		size_t chunkCount = 0;
+		std::atomic<size_t> nextChunk { 0 };
+		size_t generation = 0;
+		size_t busyWorkers = 0;
+		bool stopping = false;
+
+		static bool& InsidePool()
+		{
+			thread_local bool inside = false;
+			return inside;
+		}
+
+		void WorkerLoop();
+		void RunChunks(ChunkFn fn, void* ctx, size_t count);
+	};
+
+	inline ThreadPool::ThreadPool(size_t threadCount)
+	{
+		for (size_t i = 1; i < threadCount; ++i)
+		{
+			workers.emplace_back([this]() { WorkerLoop(); });
+		}
+	}
+
+	inline ThreadPool::~ThreadPool()
+	{
+		{
+			std::lock_guard lock(mutex);
+			stopping = true;
+		}
+		wake.notify_all();
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	inline void ThreadPool::RunChunks(ChunkFn fn, void* ctx, size_t count)
+	{
+		InsidePool() = true;
+		for (size_t chunk = nextChunk.fetch_add(1); chunk < count; chunk = nextChunk.fetch_add(1))
+		{
+			fn(ctx, chunk);
+		}
+		InsidePool() = false;
+	}
+
+	inline void ThreadPool::WorkerLoop()
+	{
+		size_t seenGeneration = 0;
+		while (true)
+		{
+			ChunkFn fn;
+			void* ctx;
+			size_t count;
+			{
+				std::unique_lock lock(mutex);
+				wake.wait(lock, [&]() { return stopping || generation != seenGeneration; });
+				if (stopping)
+				{
+					return;
+				}
+				seenGeneration = generation;
+				fn = invoke;
+				ctx = context;
+				count = chunkCount;
+			}
+
+			RunChunks(fn, ctx, count);
+
+			{
+				std::lock_guard lock(mutex);
+				--busyWorkers;
+			}
+			finished.notify_one();
+		}
+	}
+
+	template <typename Fn>
+	void ThreadPool::ParallelFor(size_t count, Fn&& fn)
+	{
+		if (workers.empty() || count <= 1 || InsidePool())
+		{
+			for (size_t chunk = 0; chunk < count; ++chunk)
+			{
+				fn(chunk);
+			}
+			return;
+		}
+
+		std::lock_guard submitLock(submitMutex);
+
+		using FnType = std::remove_reference_t<Fn>;
+		const ChunkFn trampoline = [](void* ctx, size_t chunk) { (*static_cast<FnType*>(ctx))(chunk); };
+		{
+			std::lock_guard lock(mutex);
+			invoke = trampoline;
+			context = const_cast<void*>(static_cast<const void*>(&fn));
+			chunkCount = count;
+			nextChunk.store(0);
+			busyWorkers = workers.size();
+			++generation;
+		}
+		wake.notify_all();
+
+		RunChunks(trampoline, const_cast<void*>(static_cast<const void*>(&fn)), count);
+
+		std::unique_lock lock(mutex);
+		finished.wait(lock, [this]() { return busyWorkers == 0; });
+	}
+
+	/**
+	 * \brief Pool shared by the parallel Mathfx functions when none is passed in, one thread per hardware thread.
+	 */
+	inline ThreadPool& DefaultThreadPool()
+	{
+		static ThreadPool pool;
+		return pool;
+	}
+
+	// Parallel work is always split into chunks of this many elements, never by thread count, so the chunk boundaries and
+	// therefore every per-chunk result are the same on any machine.
+	constexpr size_t ParallelChunkSize = 4096;
+
+	constexpr size_t ParallelChunkCount(size_t count)
+	{
+		return (count + ParallelChunkSize - 1) / ParallelChunkSize;
+	}
+
+	/**
+	 * \brief out[i] = op(in[i]) spread over the pool in ParallelChunkSize chunks.
+	 * For a pure \p op every element is computed exactly as it would be serially, so the output doesn't depend on the
+	 * thread count or scheduling. \p in and \p out may be the same span.
+	 */
+	template <typename In, typename Out, typename Op>
+	void ParallelTransform(std::span<In> in, std::span<Out> out, Op&& op, ThreadPool& pool = DefaultThreadPool())
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		pool.ParallelFor(ParallelChunkCount(in.size()), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			const size_t end = std::min(begin + ParallelChunkSize, in.size());
+			for (size_t i = begin; i < end; ++i)
+			{
+				out[i] = op(in[i]);
+			}
+		});
+	}
+
+	/**
+	 * \brief Runs a batch kernel over matching ParallelChunkSize subspans of \p in and \p out across the pool,
+	 * e.g. ParallelBatch(values, std::span(roots), [](auto in, auto out) { FastSqrtBatch<int64_t, 32>(in, out); }).
+	 * Batch kernels are element-wise and bit-identical to their scalar versions, so the output matches a single call
+	 * over the whole span. The chunk size is a multiple of every SIMD width so only the final chunk has a scalar tail.
+	 */
+	template <typename In, typename Out, typename Kernel>
+	void ParallelBatch(std::span<In> in, std::span<Out> out, Kernel&& kernel, ThreadPool& pool = DefaultThreadPool())
+	{
+		FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+		pool.ParallelFor(ParallelChunkCount(in.size()), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			const size_t length = std::min(ParallelChunkSize, in.size() - begin);
+			kernel(in.subspan(begin, length), out.subspan(begin, length));
+		});
+	}
+
+	/**
+	 * \brief Sum of all values, saturated to the range of Fixed only once at the end.
+	 * Each chunk sums into a 128 bit FixedAccumulator, integer addition is associative so merging the chunks in any grouping
+	 * gives exactly the serial FixedAccumulator sum, whatever the thread count. Partial sums can go far past the range, only
+	 * the total saturates.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> ParallelSum(std::span<const Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		std::vector<FixedAccumulator<T, F>> partials(ParallelChunkCount(values.size()));
+		pool.ParallelFor(partials.size(), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			const size_t end = std::min(begin + ParallelChunkSize, values.size());
+			FixedAccumulator<T, F> sum;
+			for (size_t i = begin; i < end; ++i)
+			{
+				sum.Add(values[i]);
+			}
+			partials[chunk] = sum;
+		});
+
+		FixedAccumulator<T, F> total;
+		for (const FixedAccumulator<T, F>& partial : partials)
+		{
+			total.Merge(partial);
+		}
+		return total.SaturatedResult();
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> ParallelSum(std::span<Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		return ParallelSum(std::span<const Fixed<T, F>>(values), pool);
+	}
+
+	/**
+	 * \brief Dot product of two spans, every product kept at full precision and rounded and saturated once at the end.
+	 */
+	template <typename T, int F>
+	Fixed<T, F> ParallelDot(std::span<const Fixed<T, F>> a, std::span<const Fixed<T, F>> b, ThreadPool& pool = DefaultThreadPool())
+	{
+		FXMATH_ASSERT(a.size() == b.size() && "Spans must be the same length.");
+
+		std::vector<FixedAccumulator<T, F>> partials(ParallelChunkCount(a.size()));
+		pool.ParallelFor(partials.size(), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			const size_t end = std::min(begin + ParallelChunkSize, a.size());
+			FixedAccumulator<T, F> sum;
+			for (size_t i = begin; i < end; ++i)
+			{
+				sum.MulAdd(a[i], b[i]);
+			}
+			partials[chunk] = sum;
+		});
+
+		FixedAccumulator<T, F> total;
+		for (const FixedAccumulator<T, F>& partial : partials)
+		{
+			total.Merge(partial);
+		}
+		return total.SaturatedResult();
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> ParallelDot(std::span<Fixed<T, F>> a, std::span<Fixed<T, F>> b, ThreadPool& pool = DefaultThreadPool())
+	{
+		return ParallelDot(std::span<const Fixed<T, F>>(a), std::span<const Fixed<T, F>>(b), pool);
+	}
+
+	/**
+	 * \brief Smallest and largest value, { MaxValue, MinValue } for an empty span.
+	 */
+	template <typename T, int F>
+	std::pair<Fixed<T, F>, Fixed<T, F>> ParallelMinMax(std::span<const Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		using fixed = Fixed<T, F>;
+
+		std::vector<std::pair<fixed, fixed>> partials(ParallelChunkCount(values.size()));
+		pool.ParallelFor(partials.size(), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			const size_t end = std::min(begin + ParallelChunkSize, values.size());
+			T low = fixed::RawMaxValue;
+			T high = fixed::RawMinValue;
+			for (size_t i = begin; i < end; ++i)
+			{
+				low = std::min(low, values[i].rawValue);
+				high = std::max(high, values[i].rawValue);
+			}
+			partials[chunk] = { fixed(low), fixed(high) };
+		});
+
+		std::pair<fixed, fixed> result { fixed::MaxValue, fixed::MinValue };
+		for (const auto& [low, high] : partials)
+		{
+			result.first = std::min(result.first, low);
+			result.second = std::max(result.second, high);
+		}
+		return result;
+	}
+
+	template <typename T, int F>
+	std::pair<Fixed<T, F>, Fixed<T, F>> ParallelMinMax(std::span<Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		return ParallelMinMax(std::span<const Fixed<T, F>>(values), pool);
+	}
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+
+namespace Mathfx
+{
+	// Exact geometric predicates. Vector2fx::Cross truncates both products and can overflow, so orientation tests built on it
+	// flip for nearly collinear or far away points. These keep every raw product at full width and only look at the sign,
+	// so there is no rounding anywhere and no epsilon to tune.
+	//
+	// Coordinate differences have to fit in 64 bits, so every raw coordinate must satisfy |rawValue| < 2^62
+	// (about +-1 billion units for fixed64). That is checked with FXMATH_ASSERT.
+
+	namespace internal
+	{
+		constexpr int64_t PredicateRawLimit = static_cast<int64_t>(1) << 62;
+
+		inline bool InPredicateRange(const Vector2fx& p)
+		{
+			return p.x.rawValue < PredicateRawLimit && p.x.rawValue > -PredicateRawLimit
+				&& p.y.rawValue < PredicateRawLimit && p.y.rawValue > -PredicateRawLimit;
+		}
+
+		// (b - a) x (c - a) on raw values, each product is below 2^126 so the difference fits in an Int128
+		inline Int128 WideOrient(int64_t abx, int64_t aby, int64_t acx, int64_t acy)
+		{
+			return Int128::Mul(abx, acy) - Int128::Mul(aby, acx);
+		}
+
+		// Magnitude of an Int128 whose absolute value is below 2^127
+		inline Int128 WideAbs(const Int128& value)
+		{
+			return value.IsNegative() ? -value : value;
+		}
+
+		/**
+		 * \brief Unsigned 256 bit integer, only as much as InCircle needs: sums of 128 x 128 bit products and comparison.
+		 */
+		struct UInt256
+		{
+			uint64_t limbs[4] = { 0, 0, 0, 0 };
+
+			void AddAt(int index, uint64_t value)
+			{
+				for (; index < 4 && value != 0; ++index)
+				{
+					uint64_t sum = limbs[index] + value;
+					value = sum < value ? 1 : 0;
+					limbs[index] = sum;
+				}
+			}
+
+			// Adds a * b treating both halves of each Int128 as unsigned
+			void AddProduct(const Int128& a, const Int128& b)
+			{
+				const Int128 lolo = Int128::MulUnsigned(a.lo, b.lo);
+				const Int128 lohi = Int128::MulUnsigned(a.lo, b.hi);
+				const Int128 hilo = Int128::MulUnsigned(a.hi, b.lo);
+				const Int128 hihi = Int128::MulUnsigned(a.hi, b.hi);
+				AddAt(0, lolo.lo);
+				AddAt(1, lolo.hi);
+				AddAt(1, lohi.lo);
+				AddAt(2, lohi.hi);
+				AddAt(1, hilo.lo);
+				AddAt(2, hilo.hi);
+				AddAt(2, hihi.lo);
+				AddAt(3, hihi.hi);
+			}
+
+			int Compare(const UInt256& other) const
+			{
+				for (int i = 3; i >= 0; --i)
+				{
+					if (limbs[i] != other.limbs[i])
+					{
+						return limbs[i] < other.limbs[i] ? -1 : 1;
+					}
+				}
+				return 0;
+			}
+		};
+
+		// Both points are already known to be collinear with the segment, so only the bounding box needs checking
+		inline bool OnSegment(const Vector2fx& a, const Vector2fx& b, const Vector2fx& p)
+		{
+			return p.x >= std::min(a.x, b.x) && p.x <= std::max(a.x, b.x)
+				&& p.y >= std::min(a.y, b.y) && p.y <= std::max(a.y, b.y);
+		}
+	}
+
+	/**
+	 * \brief Exact orientation of \p c relative to the directed line from \p a to \p b.
+	 * \return 1 when a, b, c turn counterclockwise (c is left of a -> b), -1 when clockwise, 0 when exactly collinear.
+	 */
+	inline int Orient2D(const Vector2fx& a, const Vector2fx& b, const Vector2fx& c)
+	{
+		FXMATH_ASSERT(internal::InPredicateRange(a) && internal::InPredicateRange(b) && internal::InPredicateRange(c)
+			&& "Coordinates out of range for exact predicates.");
+
+		return internal::WideOrient(b.x.rawValue - a.x.rawValue, b.y.rawValue - a.y.rawValue,
+			c.x.rawValue - a.x.rawValue, c.y.rawValue - a.y.rawValue).Sign();
+	}
+
+	/**
+	 * \brief Exact test for whether segment p1 p2 and segment q1 q2 share at least one point.
+	 * Touching endpoints and overlapping collinear segments count as intersecting.
+	 */
+	inline bool SegmentsIntersect(const Vector2fx& p1, const Vector2fx& p2, const Vector2fx& q1, const Vector2fx& q2)
+	{
+		const int d1 = Orient2D(q1, q2, p1);
+		const int d2 = Orient2D(q1, q2, p2);
+		const int d3 = Orient2D(p1, p2, q1);
+		const int d4 = Orient2D(p1, p2, q2);
+
+		// Proper crossing, each segment's endpoints are strictly on opposite sides of the other
+		if (d1 * d2 < 0 && d3 * d4 < 0)
+		{
+			return true;
+		}
+
+		return (d1 == 0 && internal::OnSegment(q1, q2, p1))
+			|| (d2 == 0 && internal::OnSegment(q1, q2, p2))
+			|| (d3 == 0 && internal::OnSegment(p1, p2, q1))
+			|| (d4 == 0 && internal::OnSegment(p1, p2, q2));
+	}
+
+	/**
+	 * \brief Exact test of \p d against the circle through \p a, \p b and \p c.
+	 * \return 1 when d is inside the circle, -1 when outside, 0 when exactly on it. Assumes a, b, c are counterclockwise,
+	 * the sign flips when they are clockwise, and is 0 when they are collinear.
+	 */
+	inline int InCircle(const Vector2fx& a, const Vector2fx& b, const Vector2fx& c, const Vector2fx& d)
+	{
+		FXMATH_ASSERT(internal::InPredicateRange(a) && internal::InPredicateRange(b) && internal::InPredicateRange(c)
+			&& internal::InPredicateRange(d) && "Coordinates out of range for exact predicates.");
+
+		const int64_t adx = a.x.rawValue - d.x.rawValue;
+		const int64_t ady = a.y.rawValue - d.y.rawValue;
+		const int64_t bdx = b.x.rawValue - d.x.rawValue;
+		const int64_t bdy = b.y.rawValue - d.y.rawValue;
+		const int64_t cdx = c.x.rawValue - d.x.rawValue;
+		const int64_t cdy = c.y.rawValue - d.y.rawValue;
+
+		// Squared distances need all 128 bits unsigned, the cross terms are signed and below 2^127
+		const Int128 lifts[3] = {
+			Int128::Mul(adx, adx) + Int128::Mul(ady, ady),
+			Int128::Mul(bdx, bdx) + Int128::Mul(bdy, bdy),
+			Int128::Mul(cdx, cdx) + Int128::Mul(cdy, cdy),
+		};
+		const Int128 crosses[3] = {
+			internal::WideOrient(bdx, bdy, cdx, cdy),
+			internal::WideOrient(cdx, cdy, adx, ady),
+			internal::WideOrient(adx, ady, bdx, bdy),
+		};
+
+		// Each term reaches 2^254, so rather than a signed 256 bit sum the positive and negative terms are summed
+		// separately by magnitude and compared
+		internal::UInt256 positive;
+		internal::UInt256 negative;
+		for (int i = 0; i < 3; ++i)
+		{
+			internal::UInt256& sum = crosses[i].IsNegative() ? negative : positive;
+			sum.AddProduct(lifts[i], internal::WideAbs(crosses[i]));
+		}
+		return positive.Compare(negative);
+	}
+}
@@ -0,0 +1,245 @@
+#pragma once
+
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "vector3fx.h"
+
+struct Quaternionfx
+{
+	using fixed = fixed64;
+
+	fixed x = fixed::Zero;
+	fixed y = fixed::Zero;
+	fixed z = fixed::Zero;
+	fixed w = fixed::One;
+
+	static const Quaternionfx Identity;
+
+	// constructors
+	constexpr Quaternionfx() : x(fixed::Zero), y(fixed::Zero), z(fixed::Zero), w(fixed::One) {}
+	constexpr Quaternionfx(fixed x, fixed y, fixed z, fixed w) : x(x), y(y), z(z), w(w) {}
+	constexpr Quaternionfx(const Quaternionfx& other) = default;
+	constexpr Quaternionfx(Quaternionfx&& other) noexcept = default;
+	~Quaternionfx() = default;
+
+	Quaternionfx& operator=(const Quaternionfx& other) = default;
+	Quaternionfx& operator=(Quaternionfx&& other) noexcept = default;
+
+	// compound-assignment operators
+	Quaternionfx& operator*=(const Quaternionfx& other)
+	{
+		*this = Multiply(*this, other);
+		return *this;
+	}
+
+	// static methods
+	static Quaternionfx Multiply(const Quaternionfx& a, const Quaternionfx& b);
+	static fixed Dot(const Quaternionfx& a, const Quaternionfx& b);
+	static Quaternionfx Conjugate(const Quaternionfx& q);
+	static Quaternionfx Inverse(const Quaternionfx& q);
+	static Quaternionfx Normalize(const Quaternionfx& q);
+	static Quaternionfx AxisAngle(const Vector3fx& axisNormalized, fixed degrees);
+	static Quaternionfx AxisAngleRadians(const Vector3fx& axisNormalized, fixed radians);
+	static Vector3fx Rotate(const Quaternionfx& q, const Vector3fx& vec);
+	static void RotateBatch(const Quaternionfx& q, std::span<const Vector3fx> in, std::span<Vector3fx> out);
+	static Quaternionfx Nlerp(const Quaternionfx& a, const Quaternionfx& b, fixed t);
+	static Quaternionfx Slerp(const Quaternionfx& a, const Quaternionfx& b, fixed t);
+	static bool ApproxEqual(const Quaternionfx& a, const Quaternionfx& b, int ignoreBits = fixed::EpsilonBits);
+
+	// instance methods
+	fixed Magnitude() const
+	{
+		return Mathfx::FastSqrt(SqrMagnitude());
+	}
+
+	fixed SqrMagnitude() const
+	{
+		return x * x + y * y + z * z + w * w;
+	}
+
+	Quaternionfx Normalized() const
+	{
+		return Normalize(*this);
+	}
+
+private:
+	// Row major 3x3 rotation matrix equivalent of a unit quaternion, shared by Rotate and RotateBatch so both give identical results
+	struct RotationMatrix
+	{
+		fixed m[3][3];
+
+		Vector3fx Apply(const Vector3fx& v) const
+		{
+			return Vector3fx(
+				m[0][0] * v.x + m[0][1] * v.y + m[0][2] * v.z,
+				m[1][0] * v.x + m[1][1] * v.y + m[1][2] * v.z,
+				m[2][0] * v.x + m[2][1] * v.y + m[2][2] * v.z);
+		}
+	};
+
+	static RotationMatrix ToRotationMatrix(const Quaternionfx& q);
+};
+
+constexpr Quaternionfx Quaternionfx::Identity(fixed::Zero, fixed::Zero, fixed::Zero, fixed::One);
+
+inline Quaternionfx operator*(Quaternionfx a, const Quaternionfx& b) { return a *= b; }
+inline Vector3fx operator*(const Quaternionfx& q, const Vector3fx& v) { return Quaternionfx::Rotate(q, v); }
+inline bool operator==(const Quaternionfx& a, const Quaternionfx& b) { return a.x == b.x && a.y == b.y && a.z == b.z && a.w == b.w; }
+inline bool operator!=(const Quaternionfx& a, const Quaternionfx& b) { return !(a == b); }
+
+Quaternionfx Quaternionfx::Multiply(const Quaternionfx& a, const Quaternionfx& b)
+{
+	return Quaternionfx(
+		a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+		a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+		a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w,
+		a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z);
+}
+
+fixed Quaternionfx::Dot(const Quaternionfx& a, const Quaternionfx& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w;
+}
+
+Quaternionfx Quaternionfx::Conjugate(const Quaternionfx& q)
+{
+	return Quaternionfx(-q.x, -q.y, -q.z, q.w);
+}
+
+Quaternionfx Quaternionfx::Inverse(const Quaternionfx& q)
+{
+	fixed sqrMagnitude = q.SqrMagnitude();
+	if (Mathfx::ApproxZero(sqrMagnitude))
+	{
+		return Identity;
+	}
+
+	// Conjugate over the squared length, multiply by the reciprocal instead of dividing four times
+	fixed invSqrMagnitude = fixed::One / sqrMagnitude;
+	return Quaternionfx(-q.x * invSqrMagnitude, -q.y * invSqrMagnitude, -q.z * invSqrMagnitude, q.w * invSqrMagnitude);
+}
+
+Quaternionfx Quaternionfx::Normalize(const Quaternionfx& q)
+{
+	fixed sqrMagnitude = q.SqrMagnitude();
+	if (Mathfx::ApproxZero(sqrMagnitude))
+	{
+		return Identity;
+	}
+
+	fixed invLength = Mathfx::InvSqrt(sqrMagnitude);
+	return Quaternionfx(q.x * invLength, q.y * invLength, q.z * invLength, q.w * invLength);
+}
+
+Quaternionfx Quaternionfx::AxisAngle(const Vector3fx& axisNormalized, fixed degrees)
+{
+	return AxisAngleRadians(axisNormalized, degrees * fixed::Deg2Rad);
+}
+
+Quaternionfx Quaternionfx::AxisAngleRadians(const Vector3fx& axisNormalized, fixed radians)
+{
+	fixed halfAngle(radians.rawValue >> 1);
+	fixed sin = Mathfx::Sin(halfAngle);
+	fixed cos = Mathfx::Cos(halfAngle);
+	return Quaternionfx(axisNormalized.x * sin, axisNormalized.y * sin, axisNormalized.z * sin, cos);
+}
+
+Quaternionfx::RotationMatrix Quaternionfx::ToRotationMatrix(const Quaternionfx& q)
+{
+	fixed x2 = q.x + q.x;
+	fixed y2 = q.y + q.y;
+	fixed z2 = q.z + q.z;
+
+	fixed xx = q.x * x2;
+	fixed yy = q.y * y2;
+	fixed zz = q.z * z2;
+	fixed xy = q.x * y2;
+	fixed xz = q.x * z2;
+	fixed yz = q.y * z2;
+	fixed wx = q.w * x2;
+	fixed wy = q.w * y2;
+	fixed wz = q.w * z2;
+
+	RotationMatrix result;
+	result.m[0][0] = fixed::One - (yy + zz);
+	result.m[0][1] = xy - wz;
+	result.m[0][2] = xz + wy;
+	result.m[1][0] = xy + wz;
+	result.m[1][1] = fixed::One - (xx + zz);
+	result.m[1][2] = yz - wx;
+	result.m[2][0] = xz - wy;
+	result.m[2][1] = yz + wx;
+	result.m[2][2] = fixed::One - (xx + yy);
+	return result;
+}
+
+Vector3fx Quaternionfx::Rotate(const Quaternionfx& q, const Vector3fx& vec)
+{
+	return ToRotationMatrix(q).Apply(vec);
+}
+
+void Quaternionfx::RotateBatch(const Quaternionfx& q, std::span<const Vector3fx> in, std::span<Vector3fx> out)
+{
+	FXMATH_ASSERT(in.size() == out.size() && "Input and output spans must be the same length.");
+
+	// Building the matrix costs 12 multiplies once, every vector after that is 9 multiplies instead of the 15+ of the cross product form
+	RotationMatrix matrix = ToRotationMatrix(q);
+	for (size_t i = 0; i < in.size(); ++i)
+	{
+		out[i] = matrix.Apply(in[i]);
+	}
+}
+
+Quaternionfx Quaternionfx::Nlerp(const Quaternionfx& a, const Quaternionfx& b, fixed t)
+{
+	// Interpolate along the shortest arc
+	fixed sign = Dot(a, b) < fixed::Zero ? fixed::NegOne : fixed::One;
+	fixed oneMinusT = fixed::One - t;
+	fixed tSigned = t * sign;
+
+	Quaternionfx result(
+		a.x * oneMinusT + b.x * tSigned,
+		a.y * oneMinusT + b.y * tSigned,
+		a.z * oneMinusT + b.z * tSigned,
+		a.w * oneMinusT + b.w * tSigned);
+	return Normalize(result);
+}
+
+Quaternionfx Quaternionfx::Slerp(const Quaternionfx& a, const Quaternionfx& b, fixed t)
+{
+	fixed cosTheta = Dot(a, b);
+	Quaternionfx target = b;
+	if (cosTheta < fixed::Zero)
+	{
+		cosTheta = -cosTheta;
+		target = Quaternionfx(-b.x, -b.y, -b.z, -b.w);
+	}
+
+	// sin(theta) goes to zero as the quaternions converge, at that point Nlerp is indistinguishable and doesn't divide by ~0
+	static const fixed nlerpThreshold = fixed::Float(0.9995);
+	if (cosTheta > nlerpThreshold)
+	{
+		return Nlerp(a, target, t);
+	}
+
+	fixed theta = Mathfx::Acos(Mathfx::Min(cosTheta, fixed::One));
+	fixed invSinTheta = fixed::One / Mathfx::Sin(theta);
+	fixed weightA = Mathfx::Sin((fixed::One - t) * theta) * invSinTheta;
+	fixed weightB = Mathfx::Sin(t * theta) * invSinTheta;
+
+	return Quaternionfx(
+		a.x * weightA + target.x * weightB,
+		a.y * weightA + target.y * weightB,
+		a.z * weightA + target.z * weightB,
+		a.w * weightA + target.w * weightB);
+}
+
+bool Quaternionfx::ApproxEqual(const Quaternionfx& a, const Quaternionfx& b, int ignoreBits)
+{
+	return Mathfx::ApproxEqual(a.x, b.x, ignoreBits)
+		&& Mathfx::ApproxEqual(a.y, b.y, ignoreBits)
+		&& Mathfx::ApproxEqual(a.z, b.z, ignoreBits)
+		&& Mathfx::ApproxEqual(a.w, b.w, ignoreBits);
+}
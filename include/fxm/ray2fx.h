@@ -0,0 +1,284 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+#include "shapes2fx.h"
+#include "collision2fx.h"
+
+namespace Mathfx
+{
+	namespace internal
+	{
+		// numerator / denominator for 0 <= numerator <= denominator, both scaled down or up together until the denominator
+		// has 62 significant bits so the one division keeps full precision however small or large the wide values are
+		inline fixed64 WideFraction(Int128 numerator, Int128 denominator)
+		{
+			const int bitLength = denominator.hi != 0 ? 128 - std::countl_zero(denominator.hi) : 64 - std::countl_zero(denominator.lo);
+			const int shift = bitLength - 62;
+			if (shift > 0)
+			{
+				numerator >>= shift;
+				denominator >>= shift;
+			}
+			else
+			{
+				numerator <<= -shift;
+				denominator <<= -shift;
+			}
+			return fixed64(numerator.Low()) / fixed64(denominator.Low());
+		}
+	}
+}
+
+/**
+ * \brief Ray from an origin along a direction, hits are reported as the fraction t of the direction travelled,
+ * origin + direction * t with t in [0, 1], so a ray built with FromPoints casts along a segment.
+ * The divisions every shape test would need are done once here: exact reciprocals of both direction components and of
+ * the length, so testing a shape is multiplies only. Shapes outside the ray's bounding box are rejected before even that.
+ * Build one ray and cast it against as many shapes as needed.
+ */
+struct Ray2fx
+{
+	using fixed = fixed64;
+
+	// constructors
+	Ray2fx(const Vector2fx& origin, const Vector2fx& direction);
+
+	// static methods
+	static Ray2fx FromPoints(const Vector2fx& from, const Vector2fx& to);
+
+	/**
+	 * \brief Returns true and the fraction of the first hit when the ray hits the shape, 0 when it starts inside.
+	 */
+	static bool Cast(const Ray2fx& ray, const Aabb2fx& box, fixed& fraction);
+	static bool Cast(const Ray2fx& ray, const Circle2fx& circle, fixed& fraction);
+
+	/**
+	 * \brief Same as the other Casts, segments parallel to the ray never count as hit.
+	 * Only hits pay for a division, the hit test itself is exact.
+	 */
+	static bool Cast(const Ray2fx& ray, const Segment2fx& segment, fixed& fraction);
+
+	/**
+	 * \brief fractions[i] is the hit fraction for shape i or fixed::MaxValue when it misses.
+	 */
+	static void CastBatch(const Ray2fx& ray, std::span<const Aabb2fx> boxes, std::span<fixed> fractions);
+	static void CastBatch(const Ray2fx& ray, std::span<const Circle2fx> circles, std::span<fixed> fractions);
+	static void CastBatch(const Ray2fx& ray, std::span<const Segment2fx> segments, std::span<fixed> fractions);
+
+	// instance methods
+	const Vector2fx& Origin() const { return origin; }
+	const Vector2fx& Direction() const { return direction; }
+	fixed Length() const { return length; }
+
+	Vector2fx GetPoint(fixed fraction) const
+	{
+		return origin + direction * fraction;
+	}
+
+private:
+	Vector2fx origin;
+	Vector2fx direction;
+	Vector2fx unitDirection;
+	fixed length;
+	Aabb2fx bounds;
+
+	// Components of direction that are zero keep the default divisor and are never divided by
+	FixedDivisor<int64_t, 32> inverseX;
+	FixedDivisor<int64_t, 32> inverseY;
+	FixedDivisor<int64_t, 32> inverseLength;
+};
+
+Ray2fx::Ray2fx(const Vector2fx& origin, const Vector2fx& direction) : origin(origin), direction(direction)
+{
+	FXMATH_ASSERT(direction != Vector2fx::Zero && "Ray direction can't be zero.");
+
+	bounds = Aabb2fx::Union(Aabb2fx(origin, origin), origin + direction);
+	length = Mathfx::internal::Length(Mathfx::internal::Project(direction, direction));
+	FXMATH_ASSERT(length > fixed::Zero && "Ray direction too short.");
+
+	inverseLength = FixedDivisor<int64_t, 32>(length);
+	unitDirection = Vector2fx(inverseLength.Divide(direction.x), inverseLength.Divide(direction.y));
+	if (direction.x != fixed::Zero)
+	{
+		inverseX = FixedDivisor<int64_t, 32>(direction.x);
+	}
+	if (direction.y != fixed::Zero)
+	{
+		inverseY = FixedDivisor<int64_t, 32>(direction.y);
+	}
+}
+
+Ray2fx Ray2fx::FromPoints(const Vector2fx& from, const Vector2fx& to)
+{
+	return Ray2fx(from, to - from);
+}
+
+bool Ray2fx::Cast(const Ray2fx& ray, const Aabb2fx& box, fixed& fraction)
+{
+	// Slab test, clip [0, 1] to the range of t where the ray is between the box's x planes and then its y planes.
+	// A zero direction component never crosses those planes, the origin is either between them or the ray misses.
+	if (!Aabb2fx::Overlaps(ray.bounds, box))
+	{
+		return false;
+	}
+
+	fixed enter = fixed::Zero;
+	fixed exit = fixed::One;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		const fixed start = ray.origin[axis];
+		if (ray.direction[axis] == fixed::Zero)
+		{
+			if (start < box.min[axis] || start > box.max[axis])
+			{
+				return false;
+			}
+			continue;
+		}
+
+		const FixedDivisor<int64_t, 32>& inverse = axis == 0 ? ray.inverseX : ray.inverseY;
+		fixed near = inverse.Divide(box.min[axis] - start);
+		fixed far = inverse.Divide(box.max[axis] - start);
+		if (near > far)
+		{
+			std::swap(near, far);
+		}
+		enter = std::max(enter, near);
+		exit = std::min(exit, far);
+		if (enter > exit)
+		{
+			return false;
+		}
+	}
+
+	fraction = enter;
+	return true;
+}
+
+bool Ray2fx::Cast(const Ray2fx& ray, const Circle2fx& circle, fixed& fraction)
+{
+	// Along the unit direction the center is reached after along units and is perpendicular units off the ray,
+	// the ray is inside the circle for half a chord either side of that
+	if (!Circle2fx::Overlaps(circle, ray.bounds))
+	{
+		return false;
+	}
+
+	const Vector2fx toCenter = circle.center - ray.origin;
+	const fixed along = Mathfx::internal::Project(ray.unitDirection, toCenter).Result();
+
+	Mathfx::internal::Projection2fx cross;
+	cross.MulAdd(ray.unitDirection.x, toCenter.y);
+	cross.MulSub(ray.unitDirection.y, toCenter.x);
+	const fixed perpendicular = Mathfx::Abs(cross.Result());
+	if (perpendicular > circle.radius)
+	{
+		return false;
+	}
+
+	Mathfx::internal::Projection2fx halfChordSquared;
+	halfChordSquared.MulAdd(circle.radius - perpendicular, circle.radius + perpendicular);
+	const fixed halfChord = Mathfx::internal::Length(halfChordSquared);
+	if (along + halfChord < fixed::Zero)
+	{
+		return false;
+	}
+
+	const fixed enter = std::max(along - halfChord, fixed::Zero);
+	if (enter > ray.length)
+	{
+		return false;
+	}
+
+	fraction = ray.inverseLength.Divide(enter);
+	return true;
+}
+
+bool Ray2fx::Cast(const Ray2fx& ray, const Segment2fx& segment, fixed& fraction)
+{
+	// origin + direction * t = a + edge * u, crossing both sides with edge and direction gives
+	// t = Cross(offset, edge) / Cross(direction, edge) and u = Cross(offset, direction) / Cross(direction, edge),
+	// both must be in [0, 1] which is checked on the wide numerators without dividing
+	if (!Aabb2fx::Overlaps(ray.bounds, segment.Bounds()))
+	{
+		return false;
+	}
+
+	const Vector2fx edge = segment.b - segment.a;
+	const Vector2fx offset = segment.a - ray.origin;
+
+	Mathfx::internal::Projection2fx denominator;
+	denominator.MulAdd(ray.direction.x, edge.y);
+	denominator.MulSub(ray.direction.y, edge.x);
+	Mathfx::internal::Projection2fx t;
+	t.MulAdd(offset.x, edge.y);
+	t.MulSub(offset.y, edge.x);
+	Mathfx::internal::Projection2fx u;
+	u.MulAdd(offset.x, ray.direction.y);
+	u.MulSub(offset.y, ray.direction.x);
+
+	if (denominator.value == Int128(0))
+	{
+		return false;
+	}
+	if (denominator.value.IsNegative())
+	{
+		denominator.value = -denominator.value;
+		t.value = -t.value;
+		u.value = -u.value;
+	}
+	if (t.value.IsNegative() || t.value > denominator.value || u.value.IsNegative() || u.value > denominator.value)
+	{
+		return false;
+	}
+
+	fraction = Mathfx::internal::WideFraction(t.value, denominator.value);
+	return true;
+}
+
+void Ray2fx::CastBatch(const Ray2fx& ray, std::span<const Aabb2fx> boxes, std::span<fixed> fractions)
+{
+	FXMATH_ASSERT(boxes.size() == fractions.size() && "Input and output spans must be the same length.");
+
+	for (size_t i = 0; i < boxes.size(); ++i)
+	{
+		if (!Cast(ray, boxes[i], fractions[i]))
+		{
+			fractions[i] = fixed::MaxValue;
+		}
+	}
+}
+
+void Ray2fx::CastBatch(const Ray2fx& ray, std::span<const Circle2fx> circles, std::span<fixed> fractions)
+{
+	FXMATH_ASSERT(circles.size() == fractions.size() && "Input and output spans must be the same length.");
+
+	for (size_t i = 0; i < circles.size(); ++i)
+	{
+		if (!Cast(ray, circles[i], fractions[i]))
+		{
+			fractions[i] = fixed::MaxValue;
+		}
+	}
+}
+
+void Ray2fx::CastBatch(const Ray2fx& ray, std::span<const Segment2fx> segments, std::span<fixed> fractions)
+{
+	FXMATH_ASSERT(segments.size() == fractions.size() && "Input and output spans must be the same length.");
+
+	for (size_t i = 0; i < segments.size(); ++i)
+	{
+		if (!Cast(ray, segments[i], fractions[i]))
+		{
+			fractions[i] = fixed::MaxValue;
+		}
+	}
+}
@@ -0,0 +1,357 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <span>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedsimd.h"
+#include "vector2fx.h"
+
+namespace Mathfx
+{
+	// Overlap batches write one bit per shape, bit i of the result lives at mask[i / 64] & (1 << (i % 64))
+	constexpr size_t BitmaskWordCount(size_t count)
+	{
+		return (count + 63) / 64;
+	}
+}
+
+/**
+ * \brief Axis aligned bounding box, both corners are inclusive so boxes that only share an edge still overlap.
+ */
+struct Aabb2fx
+{
+	using fixed = fixed64;
+
+	Vector2fx min;
+	Vector2fx max;
+
+	// constructors
+	constexpr Aabb2fx() : min(), max() {}
+	constexpr Aabb2fx(const Vector2fx& min, const Vector2fx& max) : min(min), max(max) {}
+	constexpr Aabb2fx(const Aabb2fx& other) = default;
+	constexpr Aabb2fx(Aabb2fx&& other) noexcept = default;
+	~Aabb2fx() = default;
+
+	Aabb2fx& operator=(const Aabb2fx& other) = default;
+	Aabb2fx& operator=(Aabb2fx&& other) noexcept = default;
+
+	// static methods
+	static Aabb2fx FromCenterExtents(const Vector2fx& center, const Vector2fx& extents);
+	static bool Overlaps(const Aabb2fx& a, const Aabb2fx& b);
+	static bool Contains(const Aabb2fx& a, const Vector2fx& point);
+	static bool Contains(const Aabb2fx& a, const Aabb2fx& b);
+	static Aabb2fx Union(const Aabb2fx& a, const Aabb2fx& b);
+	static Aabb2fx Union(const Aabb2fx& a, const Vector2fx& point);
+	static Aabb2fx Expand(const Aabb2fx& a, fixed margin);
+	static Aabb2fx Expand(const Aabb2fx& a, const Vector2fx& margin);
+	static void OverlapsBatch(const Aabb2fx& a, std::span<const Aabb2fx> boxes, std::span<uint64_t> mask);
+
+	// instance methods
+	Vector2fx Center() const
+	{
+		return Vector2fx((min.x + max.x) >> 1, (min.y + max.y) >> 1);
+	}
+
+	Vector2fx Extents() const
+	{
+		return Vector2fx((max.x - min.x) >> 1, (max.y - min.y) >> 1);
+	}
+
+	Vector2fx Size() const
+	{
+		return max - min;
+	}
+
+	fixed Area() const
+	{
+		return (max.x - min.x) * (max.y - min.y);
+	}
+
+	fixed Perimeter() const
+	{
+		return ((max.x - min.x) + (max.y - min.y)) << 1;
+	}
+};
+
+#if FXMATH_AVX2
+namespace Mathfx
+{
+	namespace simd
+	{
+		// Loads four consecutive boxes as min.x, min.y, max.x and max.y registers, one box per lane
+		inline void LoadBoxes4(const Aabb2fx* boxes, __m256i& minX, __m256i& minY, __m256i& maxX, __m256i& maxY)
+		{
+			minX = Load4(&boxes[0].min.x);
+			minY = Load4(&boxes[1].min.x);
+			maxX = Load4(&boxes[2].min.x);
+			maxY = Load4(&boxes[3].min.x);
+			Transpose4x4(minX, minY, maxX, maxY);
+		}
+	}
+}
+#endif
+
+inline bool operator==(const Aabb2fx& a, const Aabb2fx& b) { return a.min == b.min && a.max == b.max; }
+inline bool operator!=(const Aabb2fx& a, const Aabb2fx& b) { return !(a == b); }
+
+/**
+ * \brief Circle given by center and radius, the boundary counts as inside.
+ * Distance tests use squared lengths with the same FastMul products as Vector2fx::DistanceSquared,
+ * so the same range limit applies: squared distances and radii must fit in fixed64.
+ */
+struct Circle2fx
+{
+	using fixed = fixed64;
+
+	Vector2fx center;
+	fixed radius = fixed::Zero;
+
+	// constructors
+	constexpr Circle2fx() : center(), radius(fixed::Zero) {}
+	constexpr Circle2fx(const Vector2fx& center, fixed radius) : center(center), radius(radius) {}
+	constexpr Circle2fx(const Circle2fx& other) = default;
+	constexpr Circle2fx(Circle2fx&& other) noexcept = default;
+	~Circle2fx() = default;
+
+	Circle2fx& operator=(const Circle2fx& other) = default;
+	Circle2fx& operator=(Circle2fx&& other) noexcept = default;
+
+	// static methods
+	static bool Overlaps(const Circle2fx& a, const Circle2fx& b);
+	static bool Overlaps(const Circle2fx& a, const Aabb2fx& b);
+	static bool Contains(const Circle2fx& a, const Vector2fx& point);
+	static bool Contains(const Circle2fx& a, const Circle2fx& b);
+	static Circle2fx Union(const Circle2fx& a, const Circle2fx& b);
+	static Circle2fx Expand(const Circle2fx& a, fixed margin);
+	static void OverlapsBatch(const Circle2fx& a, std::span<const Circle2fx> circles, std::span<uint64_t> mask);
+	static void OverlapsBatch(const Circle2fx& a, std::span<const Aabb2fx> boxes, std::span<uint64_t> mask);
+
+	// instance methods
+	Aabb2fx Bounds() const
+	{
+		return Aabb2fx(Vector2fx(center.x - radius, center.y - radius), Vector2fx(center.x + radius, center.y + radius));
+	}
+};
+
+inline bool operator==(const Circle2fx& a, const Circle2fx& b) { return a.center == b.center && a.radius == b.radius; }
+inline bool operator!=(const Circle2fx& a, const Circle2fx& b) { return !(a == b); }
+
+/**
+ * \brief Line segment between two points, both end points included.
+ */
+struct Segment2fx
+{
+	using fixed = fixed64;
+
+	Vector2fx a;
+	Vector2fx b;
+
+	// constructors
+	constexpr Segment2fx() : a(), b() {}
+	constexpr Segment2fx(const Vector2fx& a, const Vector2fx& b) : a(a), b(b) {}
+	constexpr Segment2fx(const Segment2fx& other) = default;
+	constexpr Segment2fx(Segment2fx&& other) noexcept = default;
+	~Segment2fx() = default;
+
+	Segment2fx& operator=(const Segment2fx& other) = default;
+	Segment2fx& operator=(Segment2fx&& other) noexcept = default;
+
+	// instance methods
+	Aabb2fx Bounds() const
+	{
+		return Aabb2fx::Union(Aabb2fx(a, a), b);
+	}
+};
+
+inline bool operator==(const Segment2fx& x, const Segment2fx& y) { return x.a == y.a && x.b == y.b; }
+inline bool operator!=(const Segment2fx& x, const Segment2fx& y) { return !(x == y); }
+
+Aabb2fx Aabb2fx::FromCenterExtents(const Vector2fx& center, const Vector2fx& extents)
+{
+	return Aabb2fx(center - extents, center + extents);
+}
+
+bool Aabb2fx::Overlaps(const Aabb2fx& a, const Aabb2fx& b)
+{
+	return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+}
+
+bool Aabb2fx::Contains(const Aabb2fx& a, const Vector2fx& point)
+{
+	return point.x >= a.min.x && point.x <= a.max.x && point.y >= a.min.y && point.y <= a.max.y;
+}
+
+bool Aabb2fx::Contains(const Aabb2fx& a, const Aabb2fx& b)
+{
+	return b.min.x >= a.min.x && b.max.x <= a.max.x && b.min.y >= a.min.y && b.max.y <= a.max.y;
+}
+
+Aabb2fx Aabb2fx::Union(const Aabb2fx& a, const Aabb2fx& b)
+{
+	return Aabb2fx(Vector2fx(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y)),
+		Vector2fx(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y)));
+}
+
+Aabb2fx Aabb2fx::Union(const Aabb2fx& a, const Vector2fx& point)
+{
+	return Aabb2fx(Vector2fx(std::min(a.min.x, point.x), std::min(a.min.y, point.y)),
+		Vector2fx(std::max(a.max.x, point.x), std::max(a.max.y, point.y)));
+}
+
+Aabb2fx Aabb2fx::Expand(const Aabb2fx& a, fixed margin)
+{
+	return Aabb2fx(Vector2fx(a.min.x - margin, a.min.y - margin), Vector2fx(a.max.x + margin, a.max.y + margin));
+}
+
+Aabb2fx Aabb2fx::Expand(const Aabb2fx& a, const Vector2fx& margin)
+{
+	return Aabb2fx(a.min - margin, a.max + margin);
+}
+
+void Aabb2fx::OverlapsBatch(const Aabb2fx& a, std::span<const Aabb2fx> boxes, std::span<uint64_t> mask)
+{
+	FXMATH_ASSERT(mask.size() >= Mathfx::BitmaskWordCount(boxes.size()) && "Mask span too short for the number of boxes.");
+
+	std::fill(mask.begin(), mask.end(), static_cast<uint64_t>(0));
+	size_t i = 0;
+#if FXMATH_AVX2
+	static_assert(sizeof(Aabb2fx) == 4 * sizeof(fixed), "OverlapsBatch loads a whole box as one register.");
+
+	const __m256i queryMinX = Mathfx::simd::Splat4(a.min.x);
+	const __m256i queryMinY = Mathfx::simd::Splat4(a.min.y);
+	const __m256i queryMaxX = Mathfx::simd::Splat4(a.max.x);
+	const __m256i queryMaxY = Mathfx::simd::Splat4(a.max.y);
+	for (; i + 4 <= boxes.size(); i += 4)
+	{
+		__m256i minX, minY, maxX, maxY;
+		Mathfx::simd::LoadBoxes4(&boxes[i], minX, minY, maxX, maxY);
+		__m256i separated = _mm256_or_si256(_mm256_cmpgt_epi64(minX, queryMaxX), _mm256_cmpgt_epi64(queryMinX, maxX));
+		separated = _mm256_or_si256(separated, _mm256_cmpgt_epi64(minY, queryMaxY));
+		separated = _mm256_or_si256(separated, _mm256_cmpgt_epi64(queryMinY, maxY));
+		uint64_t bits = static_cast<uint64_t>(~_mm256_movemask_pd(_mm256_castsi256_pd(separated)) & 0xF);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+#endif
+	for (; i < boxes.size(); ++i)
+	{
+		mask[i >> 6] |= static_cast<uint64_t>(Overlaps(a, boxes[i])) << (i & 63);
+	}
+}
+
+bool Circle2fx::Overlaps(const Circle2fx& a, const Circle2fx& b)
+{
+	fixed radii = a.radius + b.radius;
+	return Vector2fx::DistanceSquared(a.center, b.center) <= radii * radii;
+}
+
+bool Circle2fx::Overlaps(const Circle2fx& a, const Aabb2fx& b)
+{
+	// Closest point of the box to the circle center
+	Vector2fx closest(std::clamp(a.center.x, b.min.x, b.max.x), std::clamp(a.center.y, b.min.y, b.max.y));
+	return Vector2fx::DistanceSquared(a.center, closest) <= a.radius * a.radius;
+}
+
+bool Circle2fx::Contains(const Circle2fx& a, const Vector2fx& point)
+{
+	return Vector2fx::DistanceSquared(a.center, point) <= a.radius * a.radius;
+}
+
+bool Circle2fx::Contains(const Circle2fx& a, const Circle2fx& b)
+{
+	// distance + b.radius <= a.radius, squared so no square root is needed
+	fixed slack = a.radius - b.radius;
+	return slack >= fixed::Zero && Vector2fx::DistanceSquared(a.center, b.center) <= slack * slack;
+}
+
+Circle2fx Circle2fx::Union(const Circle2fx& a, const Circle2fx& b)
+{
+	if (Contains(a, b))
+	{
+		return a;
+	}
+	if (Contains(b, a))
+	{
+		return b;
+	}
+
+	// Smallest enclosing circle spans from the far side of a to the far side of b along the line between the centers
+	Vector2fx offset = b.center - a.center;
+	fixed distance = offset.Magnitude();
+	fixed radius = (distance + a.radius + b.radius) >> 1;
+	return Circle2fx(a.center + offset * (radius - a.radius) / distance, radius);
+}
+
+Circle2fx Circle2fx::Expand(const Circle2fx& a, fixed margin)
+{
+	return Circle2fx(a.center, a.radius + margin);
+}
+
+void Circle2fx::OverlapsBatch(const Circle2fx& a, std::span<const Circle2fx> circles, std::span<uint64_t> mask)
+{
+	FXMATH_ASSERT(mask.size() >= Mathfx::BitmaskWordCount(circles.size()) && "Mask span too short for the number of circles.");
+
+	std::fill(mask.begin(), mask.end(), static_cast<uint64_t>(0));
+	size_t i = 0;
+#if FXMATH_AVX2
+	static_assert(sizeof(Circle2fx) == 3 * sizeof(fixed), "OverlapsBatch gathers circles with a stride of three values.");
+
+	// Circles are three values wide, gather four at a time into x, y and radius registers
+	const __m256i stride = _mm256_setr_epi64x(0, 3, 6, 9);
+	const __m256i cx = Mathfx::simd::Splat4(a.center.x);
+	const __m256i cy = Mathfx::simd::Splat4(a.center.y);
+	const __m256i cr = Mathfx::simd::Splat4(a.radius);
+	for (; i + 4 <= circles.size(); i += 4)
+	{
+		const long long* base = reinterpret_cast<const long long*>(&circles[i].center.x);
+		__m256i dx = _mm256_sub_epi64(cx, _mm256_i64gather_epi64(base, stride, 8));
+		__m256i dy = _mm256_sub_epi64(cy, _mm256_i64gather_epi64(base + 1, stride, 8));
+		__m256i radii = _mm256_add_epi64(cr, _mm256_i64gather_epi64(base + 2, stride, 8));
+		__m256i distance = _mm256_add_epi64(Mathfx::simd::FastMul4(dx, dx), Mathfx::simd::FastMul4(dy, dy));
+		__m256i outside = _mm256_cmpgt_epi64(distance, Mathfx::simd::FastMul4(radii, radii));
+		uint64_t bits = static_cast<uint64_t>(~_mm256_movemask_pd(_mm256_castsi256_pd(outside)) & 0xF);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+#endif
+	for (; i < circles.size(); ++i)
+	{
+		mask[i >> 6] |= static_cast<uint64_t>(Overlaps(a, circles[i])) << (i & 63);
+	}
+}
+
+void Circle2fx::OverlapsBatch(const Circle2fx& a, std::span<const Aabb2fx> boxes, std::span<uint64_t> mask)
+{
+	FXMATH_ASSERT(mask.size() >= Mathfx::BitmaskWordCount(boxes.size()) && "Mask span too short for the number of boxes.");
+
+	std::fill(mask.begin(), mask.end(), static_cast<uint64_t>(0));
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i cx = Mathfx::simd::Splat4(a.center.x);
+	const __m256i cy = Mathfx::simd::Splat4(a.center.y);
+	const __m256i radiusSquared = Mathfx::simd::Splat4(a.radius * a.radius);
+	for (; i + 4 <= boxes.size(); i += 4)
+	{
+		__m256i minX, minY, maxX, maxY;
+		Mathfx::simd::LoadBoxes4(&boxes[i], minX, minY, maxX, maxY);
+
+		// Same clamp order as std::clamp, min first and then max
+		__m256i closestX = _mm256_blendv_epi8(cx, minX, _mm256_cmpgt_epi64(minX, cx));
+		closestX = _mm256_blendv_epi8(closestX, maxX, _mm256_cmpgt_epi64(closestX, maxX));
+		__m256i closestY = _mm256_blendv_epi8(cy, minY, _mm256_cmpgt_epi64(minY, cy));
+		closestY = _mm256_blendv_epi8(closestY, maxY, _mm256_cmpgt_epi64(closestY, maxY));
+
+		__m256i dx = _mm256_sub_epi64(cx, closestX);
+		__m256i dy = _mm256_sub_epi64(cy, closestY);
+		__m256i distance = _mm256_add_epi64(Mathfx::simd::FastMul4(dx, dx), Mathfx::simd::FastMul4(dy, dy));
+		__m256i outside = _mm256_cmpgt_epi64(distance, radiusSquared);
+		uint64_t bits = static_cast<uint64_t>(~_mm256_movemask_pd(_mm256_castsi256_pd(outside)) & 0xF);
+		mask[i >> 6] |= bits << (i & 63);
+	}
+#endif
+	for (; i < boxes.size(); ++i)
+	{
+		mask[i >> 6] |= static_cast<uint64_t>(Overlaps(a, boxes[i])) << (i & 63);
+	}
+}
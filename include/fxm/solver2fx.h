@@ -0,0 +1,515 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "parallelfx.h"
+#include "vector2fx.h"
+#include "vector2fxsoa.h"
+#include "collision2fx.h"
+
+/**
+ * \brief Projected Gauss-Seidel / sequential impulse solver for 2D velocity constraints between bodies.
+ * Every constraint is a set of rows, each a Jacobian J over the linear and angular velocities of two bodies with a velocity
+ * target and bounds on its accumulated impulse. Solving a row computes J v exactly with full width products, turns the
+ * error into an impulse with the row's effective mass, clamps the accumulated impulse and applies the change to both
+ * bodies. Rows are kept as structure of arrays so the sweep over them streams through memory.
+ *
+ * Bodies are referenced by index into arrays owned by the caller, like Integrator2fx. Bodies with zero inverse mass and
+ * inverse inertia are static, they are read but never written.
+ *
+ * Results are deterministic: the default mode solves rows in the order they were added. The colored mode splits rows into
+ * colors that don't share a dynamic body and solves each color across the pool, which gives the same result for every
+ * thread count, but a different one from the sequential order.
+ */
+struct Solver2fx
+{
+	using fixed = fixed64;
+
+	enum class RowKind : uint32_t
+	{
+		ContactNormal,
+		ContactFriction,
+		JointX,
+		JointY,
+		Custom,
+	};
+
+	/**
+	 * \brief Identifies a row from one step to the next so its impulse can warm start the next step.
+	 */
+	struct Key
+	{
+		uint32_t a = 0;
+		uint32_t b = 0;
+		uint32_t feature = 0;
+		RowKind kind = RowKind::Custom;
+
+		auto operator<=>(const Key&) const = default;
+	};
+
+	/**
+	 * \brief One velocity constraint row, the solver drives J v towards
+	 * velocityBias + baumgarte / dt * positionError with the accumulated impulse kept in [lower, upper].
+	 */
+	struct Row
+	{
+		uint32_t a = 0;
+		uint32_t b = 0;
+		Vector2fx linearA;
+		fixed angularA;
+		Vector2fx linearB;
+		fixed angularB;
+		fixed positionError;
+		fixed velocityBias;
+		fixed lower = fixed::MinValue;
+		fixed upper = fixed::MaxValue;
+		Key key;
+	};
+
+	/**
+	 * \brief Body state the rows refer to by index, velocities are updated in place.
+	 */
+	struct Bodies
+	{
+		Vector2fxSoA& velocities;
+		std::span<fixed> angularVelocities;
+		std::span<const fixed> inverseMasses;
+		std::span<const fixed> inverseInertias;
+	};
+
+	struct Settings
+	{
+		int iterations = 8;
+		bool warmStarting = true;
+
+		// Fraction of the position error corrected per step and the contact depth left uncorrected so resting contacts
+		// don't jitter
+		fixed baumgarte = fixed::Float(0.2);
+		fixed slop = fixed::Float(0.005);
+
+		// Solve colors of independent rows across the pool instead of all rows in order
+		bool colored = false;
+	};
+
+	// Rows of one color handed to a thread at a time in colored mode
+	static constexpr size_t ParallelRowChunk = 256;
+
+	// instance methods
+
+	/**
+	 * \brief Adds a row and returns its index.
+	 */
+	size_t AddRow(const Row& row);
+
+	/**
+	 * \brief Adds a non-penetration row and a friction row for every point of \p manifold between bodies a and b.
+	 * \param centerA World position of body a, contact offsets are measured from it.
+	 * \param friction Friction impulse is bounded by friction * the normal impulse of the same point.
+	 */
+	void AddContact(uint32_t a, uint32_t b, const Vector2fx& centerA, const Vector2fx& centerB, const Manifold2fx& manifold, fixed friction);
+
+	/**
+	 * \brief Adds two rows pinning world point \p anchorA on body a to \p anchorB on body b.
+	 * \param id Identifies the joint between the two bodies for warm starting.
+	 */
+	void AddPointJoint(uint32_t id, uint32_t a, uint32_t b, const Vector2fx& centerA, const Vector2fx& centerB,
+		const Vector2fx& anchorA, const Vector2fx& anchorB);
+
+	/**
+	 * \brief Removes every row to start the next step. The impulses solved so far are kept and warm start the rows
+	 * added afterwards that have the same key.
+	 */
+	void Clear();
+
+	/**
+	 * \brief Applies the warm start impulses and runs the iterations, updating the body velocities.
+	 */
+	void Solve(const Bodies& bodies, fixed dt, const Settings& settings, Mathfx::ThreadPool& pool = Mathfx::DefaultThreadPool());
+	void Solve(const Bodies& bodies, fixed dt) { Solve(bodies, dt, Settings()); }
+
+	size_t RowCount() const { return keys.size(); }
+
+	// Accumulated impulse of a row after Solve
+	fixed Impulse(size_t row) const { return impulses[row]; }
+
+private:
+	// Jacobian and row data, one element per row
+	std::vector<uint32_t> bodyA;
+	std::vector<uint32_t> bodyB;
+	Vector2fxSoA linearA;
+	Vector2fxSoA linearB;
+	std::vector<fixed> angularA;
+	std::vector<fixed> angularB;
+	std::vector<fixed> positionErrors;
+	std::vector<fixed> velocityBiases;
+	std::vector<fixed> lowers;
+	std::vector<fixed> uppers;
+	std::vector<Key> keys;
+
+	// Friction rows take their bounds from the impulse of the normal row they belong to, -1 for every other row
+	std::vector<int32_t> parents;
+	std::vector<fixed> frictions;
+
+	// Computed by Solve: M^-1 J^T of both bodies, 1 / (J M^-1 J^T), the velocity target and the accumulated impulse
+	Vector2fxSoA massA;
+	Vector2fxSoA massB;
+	std::vector<fixed> inertiaA;
+	std::vector<fixed> inertiaB;
+	std::vector<fixed> effectiveMasses;
+	std::vector<fixed> biases;
+	std::vector<fixed> impulses;
+
+	// Impulses of the rows before the last Clear sorted by key
+	std::vector<std::pair<Key, fixed>> previous;
+
+	// Colored mode: row indices grouped by color, colors[c] spans colorRows[colorStarts[c], colorStarts[c + 1])
+	std::vector<uint32_t> colorRows;
+	std::vector<size_t> colorStarts;
+
+	void Prepare(const Bodies& bodies, std::span<const uint8_t> dynamic, fixed dt, const Settings& settings);
+	void Color(std::span<const uint8_t> dynamic);
+	void SolveRow(size_t i, const Bodies& bodies, std::span<const uint8_t> dynamic);
+	void ApplyImpulse(size_t i, fixed impulse, const Bodies& bodies, std::span<const uint8_t> dynamic);
+};
+
+size_t Solver2fx::AddRow(const Row& row)
+{
+	FXMATH_ASSERT(row.a != row.b && "A row must connect two different bodies.");
+
+	bodyA.push_back(row.a);
+	bodyB.push_back(row.b);
+	linearA.PushBack(row.linearA);
+	linearB.PushBack(row.linearB);
+	angularA.push_back(row.angularA);
+	angularB.push_back(row.angularB);
+	positionErrors.push_back(row.positionError);
+	velocityBiases.push_back(row.velocityBias);
+	lowers.push_back(row.lower);
+	uppers.push_back(row.upper);
+	keys.push_back(row.key);
+	parents.push_back(-1);
+	frictions.push_back(fixed::Zero);
+	return keys.size() - 1;
+}
+
+void Solver2fx::AddContact(uint32_t a, uint32_t b, const Vector2fx& centerA, const Vector2fx& centerB, const Manifold2fx& manifold, fixed friction)
+{
+	// J v is the velocity of b's contact point relative to a's along the axis, positive when separating:
+	// J = [-axis, -Cross(rA, axis), axis, Cross(rB, axis)]
+	auto makeRow = [&](const Manifold2fx::Point& point, const Vector2fx& axis, RowKind kind) {
+		const Vector2fx rA = point.position - centerA;
+		const Vector2fx rB = point.position - centerB;
+		Row row;
+		row.a = a;
+		row.b = b;
+		row.linearA = -axis;
+		row.angularA = -Vector2fx::Cross(rA, axis);
+		row.linearB = axis;
+		row.angularB = Vector2fx::Cross(rB, axis);
+		row.key = Key { a, b, point.id, kind };
+		return row;
+	};
+
+	const Vector2fx tangent(-manifold.normal.y, manifold.normal.x);
+	size_t normalRows[2] = {};
+	for (int p = 0; p < manifold.pointCount; ++p)
+	{
+		Row row = makeRow(manifold.points[p], manifold.normal, RowKind::ContactNormal);
+		row.positionError = manifold.points[p].depth;
+		row.lower = fixed::Zero;
+		normalRows[p] = AddRow(row);
+	}
+	for (int p = 0; p < manifold.pointCount; ++p)
+	{
+		const size_t index = AddRow(makeRow(manifold.points[p], tangent, RowKind::ContactFriction));
+		parents[index] = static_cast<int32_t>(normalRows[p]);
+		frictions[index] = friction;
+	}
+}
+
+void Solver2fx::AddPointJoint(uint32_t id, uint32_t a, uint32_t b, const Vector2fx& centerA, const Vector2fx& centerB,
+	const Vector2fx& anchorA, const Vector2fx& anchorB)
+{
+	// The velocity of a point r from a body's center is v + w * (-r.y, r.x)
+	const Vector2fx rA = anchorA - centerA;
+	const Vector2fx rB = anchorB - centerB;
+	const Vector2fx error = anchorB - anchorA;
+
+	Row row;
+	row.a = a;
+	row.b = b;
+	row.linearA = Vector2fx(-fixed::One, fixed::Zero);
+	row.angularA = rA.y;
+	row.linearB = Vector2fx(fixed::One, fixed::Zero);
+	row.angularB = -rB.y;
+	row.positionError = -error.x;
+	row.key = Key { a, b, id, RowKind::JointX };
+	AddRow(row);
+
+	row.linearA = Vector2fx(fixed::Zero, -fixed::One);
+	row.angularA = -rA.x;
+	row.linearB = Vector2fx(fixed::Zero, fixed::One);
+	row.angularB = rB.x;
+	row.positionError = -error.y;
+	row.key.kind = RowKind::JointY;
+	AddRow(row);
+}
+
+void Solver2fx::Clear()
+{
+	previous.clear();
+	for (size_t i = 0; i < impulses.size(); ++i)
+	{
+		previous.emplace_back(keys[i], impulses[i]);
+	}
+	std::stable_sort(previous.begin(), previous.end(), [](const auto& x, const auto& y) { return x.first < y.first; });
+
+	bodyA.clear();
+	bodyB.clear();
+	linearA.Clear();
+	linearB.Clear();
+	angularA.clear();
+	angularB.clear();
+	positionErrors.clear();
+	velocityBiases.clear();
+	lowers.clear();
+	uppers.clear();
+	keys.clear();
+	parents.clear();
+	frictions.clear();
+	impulses.clear();
+}
+
+void Solver2fx::Prepare(const Bodies& bodies, std::span<const uint8_t> dynamic, fixed dt, const Settings& settings)
+{
+	const size_t count = keys.size();
+	const fixed positionFactor = settings.baumgarte / dt;
+
+	massA.Resize(count);
+	massB.Resize(count);
+	inertiaA.resize(count);
+	inertiaB.resize(count);
+	effectiveMasses.resize(count);
+	biases.resize(count);
+
+	// Rows added since the last Solve start from their warm start impulse, rows solved before keep theirs
+	const size_t solved = impulses.size();
+	impulses.resize(count);
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		const uint32_t a = bodyA[i];
+		const uint32_t b = bodyB[i];
+		const fixed inverseMassA = bodies.inverseMasses[a];
+		const fixed inverseMassB = bodies.inverseMasses[b];
+		massA.x[i] = inverseMassA * linearA.x[i];
+		massA.y[i] = inverseMassA * linearA.y[i];
+		massB.x[i] = inverseMassB * linearB.x[i];
+		massB.y[i] = inverseMassB * linearB.y[i];
+		inertiaA[i] = bodies.inverseInertias[a] * angularA[i];
+		inertiaB[i] = bodies.inverseInertias[b] * angularB[i];
+
+		Mathfx::internal::Projection2fx k;
+		k.MulAdd(massA.x[i], linearA.x[i]);
+		k.MulAdd(massA.y[i], linearA.y[i]);
+		k.MulAdd(inertiaA[i], angularA[i]);
+		k.MulAdd(massB.x[i], linearB.x[i]);
+		k.MulAdd(massB.y[i], linearB.y[i]);
+		k.MulAdd(inertiaB[i], angularB[i]);
+		const fixed kSum = k.SaturatedResult();
+		effectiveMasses[i] = kSum > fixed::Zero ? fixed::One / kSum : fixed::Zero;
+
+		fixed error = positionErrors[i];
+		if (keys[i].kind == RowKind::ContactNormal)
+		{
+			error = Mathfx::Max(error - settings.slop, fixed::Zero);
+		}
+		biases[i] = velocityBiases[i] + positionFactor * error;
+
+		if (i >= solved)
+		{
+			impulses[i] = fixed::Zero;
+			if (settings.warmStarting)
+			{
+				auto found = std::lower_bound(previous.begin(), previous.end(), keys[i], [](const auto& entry, const Key& key) { return entry.first < key; });
+				if (found != previous.end() && found->first == keys[i])
+				{
+					impulses[i] = Mathfx::Clamp(found->second, lowers[i], uppers[i]);
+				}
+			}
+		}
+		if (!dynamic[a] && !dynamic[b])
+		{
+			impulses[i] = fixed::Zero;
+		}
+	}
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		if (impulses[i] != fixed::Zero)
+		{
+			ApplyImpulse(i, impulses[i], bodies, dynamic);
+		}
+	}
+}
+
+void Solver2fx::Color(std::span<const uint8_t> dynamic)
+{
+	// Greedy coloring in row order, each row gets the first color none of its dynamic bodies is in yet. A body can be in
+	// up to 64 colors, rows past that go into one last color that is solved in order on the calling thread.
+	constexpr size_t maxColors = 64;
+	std::vector<uint64_t> bodyColors(dynamic.size(), 0);
+	std::vector<uint32_t> rowColors(keys.size());
+	std::vector<size_t> counts(maxColors + 2, 0);
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		const uint32_t a = bodyA[i];
+		const uint32_t b = bodyB[i];
+		if (!dynamic[a] && !dynamic[b])
+		{
+			// Nothing to move, such rows are never solved
+			rowColors[i] = maxColors + 1;
+			++counts[maxColors + 1];
+			continue;
+		}
+
+		const uint64_t used = (dynamic[a] ? bodyColors[a] : 0) | (dynamic[b] ? bodyColors[b] : 0);
+		const int color = std::countr_one(used);
+		if (color < static_cast<int>(maxColors))
+		{
+			bodyColors[a] |= static_cast<uint64_t>(1) << color;
+			bodyColors[b] |= static_cast<uint64_t>(1) << color;
+		}
+		rowColors[i] = static_cast<uint32_t>(color);
+		++counts[color];
+	}
+
+	colorStarts.assign(1, 0);
+	for (size_t color = 0; color <= maxColors; ++color)
+	{
+		colorStarts.push_back(colorStarts.back() + counts[color]);
+	}
+	std::vector<size_t> next(colorStarts.begin(), colorStarts.end() - 1);
+	colorRows.resize(colorStarts.back());
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		if (rowColors[i] <= maxColors)
+		{
+			colorRows[next[rowColors[i]]++] = static_cast<uint32_t>(i);
+		}
+	}
+}
+
+void Solver2fx::ApplyImpulse(size_t i, fixed impulse, const Bodies& bodies, std::span<const uint8_t> dynamic)
+{
+	const uint32_t a = bodyA[i];
+	const uint32_t b = bodyB[i];
+	if (dynamic[a])
+	{
+		bodies.velocities.x[a] += massA.x[i] * impulse;
+		bodies.velocities.y[a] += massA.y[i] * impulse;
+		bodies.angularVelocities[a] += inertiaA[i] * impulse;
+	}
+	if (dynamic[b])
+	{
+		bodies.velocities.x[b] += massB.x[i] * impulse;
+		bodies.velocities.y[b] += massB.y[i] * impulse;
+		bodies.angularVelocities[b] += inertiaB[i] * impulse;
+	}
+}
+
+void Solver2fx::SolveRow(size_t i, const Bodies& bodies, std::span<const uint8_t> dynamic)
+{
+	const uint32_t a = bodyA[i];
+	const uint32_t b = bodyB[i];
+
+	Mathfx::internal::Projection2fx velocity;
+	velocity.MulAdd(linearA.x[i], bodies.velocities.x[a]);
+	velocity.MulAdd(linearA.y[i], bodies.velocities.y[a]);
+	velocity.MulAdd(angularA[i], bodies.angularVelocities[a]);
+	velocity.MulAdd(linearB.x[i], bodies.velocities.x[b]);
+	velocity.MulAdd(linearB.y[i], bodies.velocities.y[b]);
+	velocity.MulAdd(angularB[i], bodies.angularVelocities[b]);
+
+	fixed lower = lowers[i];
+	fixed upper = uppers[i];
+	if (parents[i] >= 0)
+	{
+		upper = frictions[i] * impulses[parents[i]];
+		lower = -upper;
+	}
+
+	const fixed previousImpulse = impulses[i];
+	impulses[i] = Mathfx::Clamp(previousImpulse + effectiveMasses[i] * (biases[i] - velocity.SaturatedResult()), lower, upper);
+	const fixed delta = impulses[i] - previousImpulse;
+	if (delta != fixed::Zero)
+	{
+		ApplyImpulse(i, delta, bodies, dynamic);
+	}
+}
+
+void Solver2fx::Solve(const Bodies& bodies, fixed dt, const Settings& settings, Mathfx::ThreadPool& pool)
+{
+	const size_t bodyCount = bodies.velocities.Size();
+	FXMATH_ASSERT(bodies.angularVelocities.size() == bodyCount && bodies.inverseMasses.size() == bodyCount
+		&& bodies.inverseInertias.size() == bodyCount && "Body arrays must be the same length.");
+	FXMATH_ASSERT(dt > fixed::Zero && "Timestep must be positive.");
+
+	std::vector<uint8_t> dynamic(bodyCount);
+	for (size_t i = 0; i < bodyCount; ++i)
+	{
+		dynamic[i] = bodies.inverseMasses[i] != fixed::Zero || bodies.inverseInertias[i] != fixed::Zero;
+	}
+	for (size_t i = 0; i < keys.size(); ++i)
+	{
+		FXMATH_ASSERT(bodyA[i] < bodyCount && bodyB[i] < bodyCount && "Row refers to a body out of range.");
+	}
+
+	Prepare(bodies, dynamic, dt, settings);
+
+	if (!settings.colored)
+	{
+		for (int iteration = 0; iteration < settings.iterations; ++iteration)
+		{
+			for (size_t i = 0; i < keys.size(); ++i)
+			{
+				SolveRow(i, bodies, dynamic);
+			}
+		}
+		return;
+	}
+
+	// Rows of one color touch disjoint dynamic bodies, so they can be solved in any order and on any thread with the same
+	// result. The last color may share bodies and is solved in order.
+	Color(dynamic);
+	const size_t colorCount = colorStarts.size() - 1;
+	for (int iteration = 0; iteration < settings.iterations; ++iteration)
+	{
+		for (size_t color = 0; color + 1 < colorCount; ++color)
+		{
+			const size_t begin = colorStarts[color];
+			const size_t end = colorStarts[color + 1];
+			pool.ParallelFor((end - begin + ParallelRowChunk - 1) / ParallelRowChunk, [&](size_t chunk) {
+				const size_t chunkBegin = begin + chunk * ParallelRowChunk;
+				const size_t chunkEnd = std::min(chunkBegin + ParallelRowChunk, end);
+				for (size_t j = chunkBegin; j < chunkEnd; ++j)
+				{
+					SolveRow(colorRows[j], bodies, dynamic);
+				}
+			});
+		}
+		for (size_t j = colorStarts[colorCount - 1]; j < colorStarts[colorCount]; ++j)
+		{
+			SolveRow(colorRows[j], bodies, dynamic);
+		}
+	}
+}
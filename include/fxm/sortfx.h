@@ -0,0 +1,265 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "fixedtype.h"
+#include "shapes2fx.h"
+
+namespace Mathfx
+{
+	namespace internal
+	{
+		// Fixed compares by its signed raw value, flipping the sign bit turns that into the same order on unsigned integers
+		template <typename T, int F>
+		constexpr typename Fixed<T, F>::uraw RadixKey(Fixed<T, F> x)
+		{
+			using fixed = Fixed<T, F>;
+			return static_cast<typename fixed::uraw>(x.rawValue) ^ fixed::SignMask;
+		}
+
+		/**
+		 * \brief LSD radix sort one byte per pass, optionally carrying a value along with each key.
+		 * All byte histograms are built in one read of the keys, passes where every key has the same byte are skipped.
+		 * Stable, so equal keys keep their input order.
+		 */
+		template <typename T, int F, typename V>
+		void RadixSortPasses(Fixed<T, F>* keys, Fixed<T, F>* keyScratch, V* values, V* valueScratch, size_t count)
+		{
+			constexpr int kPasses = sizeof(T);
+			constexpr bool kHasValues = !std::is_same_v<V, std::nullptr_t>;
+
+			if (count < 2)
+			{
+				return;
+			}
+
+			std::array<std::array<size_t, 256>, kPasses> histograms {};
+			for (size_t i = 0; i < count; ++i)
+			{
+				const auto key = RadixKey(keys[i]);
+				for (int pass = 0; pass < kPasses; ++pass)
+				{
+					++histograms[pass][(key >> (pass * 8)) & 0xFF];
+				}
+			}
+
+			Fixed<T, F>* srcKeys = keys;
+			Fixed<T, F>* dstKeys = keyScratch;
+			V* srcValues = values;
+			V* dstValues = valueScratch;
+			for (int pass = 0; pass < kPasses; ++pass)
+			{
+				std::array<size_t, 256>& offsets = histograms[pass];
+				const int shift = pass * 8;
+				if (offsets[(RadixKey(srcKeys[0]) >> shift) & 0xFF] == count)
+				{
+					continue;
+				}
+
+				size_t offset = 0;
+				for (size_t& bucket : offsets)
+				{
+					const size_t bucketCount = bucket;
+					bucket = offset;
+					offset += bucketCount;
+				}
+
+				for (size_t i = 0; i < count; ++i)
+				{
+					const size_t destination = offsets[(RadixKey(srcKeys[i]) >> shift) & 0xFF]++;
+					dstKeys[destination] = srcKeys[i];
+					if constexpr (kHasValues)
+					{
+						dstValues[destination] = srcValues[i];
+					}
+				}
+				std::swap(srcKeys, dstKeys);
+				if constexpr (kHasValues)
+				{
+					std::swap(srcValues, dstValues);
+				}
+			}
+
+			// An odd number of passes leaves the result in the scratch buffers
+			if (srcKeys != keys)
+			{
+				std::copy(srcKeys, srcKeys + count, keys);
+				if constexpr (kHasValues)
+				{
+					std::copy(srcValues, srcValues + count, values);
+				}
+			}
+		}
+	}
+
+	/**
+	 * \brief Sorts fixed point values ascending with an LSD radix sort, same order as std::sort with operator<.
+	 * \param scratch Temporary storage, at least as long as \p values.
+	 */
+	template <typename T, int F>
+	void RadixSort(std::span<Fixed<T, F>> values, std::span<Fixed<T, F>> scratch)
+	{
+		FXMATH_ASSERT(scratch.size() >= values.size() && "Scratch span too short.");
+		internal::RadixSortPasses<T, F, std::nullptr_t>(values.data(), scratch.data(), nullptr, nullptr, values.size());
+	}
+
+	template <typename T, int F>
+	void RadixSort(std::span<Fixed<T, F>> values)
+	{
+		std::vector<Fixed<T, F>> scratch(values.size());
+		RadixSort(values, std::span(scratch));
+	}
+
+	/**
+	 * \brief Sorts \p keys ascending and applies the same permutation to \p values, stable for equal keys.
+	 * Typical use is values holding indices 0..n-1 to get the sorted order of a key array.
+	 */
+	template <typename T, int F, typename V>
+	void RadixSortByKey(std::span<Fixed<T, F>> keys, std::span<V> values, std::span<Fixed<T, F>> keyScratch, std::span<V> valueScratch)
+	{
+		FXMATH_ASSERT(keys.size() == values.size() && "Keys and values must be the same length.");
+		FXMATH_ASSERT(keyScratch.size() >= keys.size() && valueScratch.size() >= values.size() && "Scratch spans too short.");
+		internal::RadixSortPasses<T, F, V>(keys.data(), keyScratch.data(), values.data(), valueScratch.data(), keys.size());
+	}
+
+	template <typename T, int F, typename V>
+	void RadixSortByKey(std::span<Fixed<T, F>> keys, std::span<V> values)
+	{
+		std::vector<Fixed<T, F>> keyScratch(keys.size());
+		std::vector<V> valueScratch(values.size());
+		RadixSortByKey(keys, values, std::span(keyScratch), std::span(valueScratch));
+	}
+}
+
+/**
+ * \brief Sweep and prune broadphase over a span of boxes, sorted along x.
+ * Boxes are kept ordered by (min.x, index). Between ticks objects barely move, so Update first repairs last tick's order
+ * with an insertion sort, which is close to linear on almost sorted input, and only falls back to a full radix sort when
+ * that runs out of budget or the number of boxes changed. Either way the order and the pairs found are the same.
+ */
+struct SweepAndPrune2fx
+{
+	using fixed = fixed64;
+
+	/**
+	 * \brief Takes this tick's boxes, box i is object i.
+	 */
+	void Update(std::span<const Aabb2fx> boxes);
+
+	/**
+	 * \brief Appends every pair of overlapping boxes as (smaller index, larger index), in sweep order.
+	 */
+	void FindPairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const;
+
+	size_t Size() const { return order.size(); }
+	std::span<const uint32_t> Order() const { return order; }
+
+	// Budget for repairing the order, in element moves per box, before giving up and radix sorting
+	static constexpr size_t InsertionBudget = 8;
+
+private:
+	std::vector<uint32_t> order;
+	std::vector<fixed> keys;
+	std::vector<fixed> keyScratch;
+	std::vector<uint32_t> orderScratch;
+
+	// Boxes gathered in sweep order so the inner loop reads memory front to back
+	std::vector<fixed> minX;
+	std::vector<fixed> maxX;
+	std::vector<fixed> minY;
+	std::vector<fixed> maxY;
+
+	bool RepairOrder();
+};
+
+bool SweepAndPrune2fx::RepairOrder()
+{
+	const size_t count = order.size();
+	size_t budget = count * InsertionBudget;
+	for (size_t i = 1; i < count; ++i)
+	{
+		const fixed key = keys[i];
+		const uint32_t index = order[i];
+		size_t j = i;
+		while (j > 0 && (keys[j - 1] > key || (keys[j - 1] == key && order[j - 1] > index)))
+		{
+			if (budget-- == 0)
+			{
+				return false;
+			}
+			keys[j] = keys[j - 1];
+			order[j] = order[j - 1];
+			--j;
+		}
+		keys[j] = key;
+		order[j] = index;
+	}
+	return true;
+}
+
+void SweepAndPrune2fx::Update(std::span<const Aabb2fx> boxes)
+{
+	const size_t count = boxes.size();
+	bool sorted = false;
+	if (order.size() == count)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys[i] = boxes[order[i]].min.x;
+		}
+		sorted = RepairOrder();
+	}
+
+	if (!sorted)
+	{
+		// Starting from index order makes the stable radix sort break ties by index, same as the insertion sort
+		order.resize(count);
+		keys.resize(count);
+		keyScratch.resize(count);
+		orderScratch.resize(count);
+		std::iota(order.begin(), order.end(), 0u);
+		for (size_t i = 0; i < count; ++i)
+		{
+			keys[i] = boxes[i].min.x;
+		}
+		Mathfx::RadixSortByKey(std::span(keys), std::span(order), std::span(keyScratch), std::span(orderScratch));
+	}
+
+	minX.resize(count);
+	maxX.resize(count);
+	minY.resize(count);
+	maxY.resize(count);
+	for (size_t i = 0; i < count; ++i)
+	{
+		const Aabb2fx& box = boxes[order[i]];
+		minX[i] = box.min.x;
+		maxX[i] = box.max.x;
+		minY[i] = box.min.y;
+		maxY[i] = box.max.y;
+	}
+}
+
+void SweepAndPrune2fx::FindPairs(std::vector<std::pair<uint32_t, uint32_t>>& out) const
+{
+	// Every box only has to look ahead until the next min.x passes its max.x, then check y
+	const size_t count = order.size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		const fixed endX = maxX[i];
+		const fixed lowY = minY[i];
+		const fixed highY = maxY[i];
+		for (size_t j = i + 1; j < count && minX[j] <= endX; ++j)
+		{
+			if (minY[j] <= highY && lowY <= maxY[j])
+			{
+				out.emplace_back(std::min(order[i], order[j]), std::max(order[i], order[j]));
+			}
+		}
+	}
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "vector2fx.h"
+
+/**
+ * \brief Spatial hash over a uniform grid of square cells, for radius queries over a set of indexed points.
+ * Points are stored by bucket in one array (compressed rows), so a query reads a few contiguous runs instead of chasing lists.
+ * Cells are floor(position / cellSize), computed with a shift when the cell size is a power of two and with an exact
+ * integer floor division otherwise. Each bucket keeps a little spare room after a rebuild so Insert and Move rarely
+ * have to touch anything else; entries that don't fit go to a small overflow list until the next rebuild.
+ */
+struct SpatialGrid2fx
+{
+	using fixed = fixed64;
+
+	struct Cell
+	{
+		int64_t x = 0;
+		int64_t y = 0;
+	};
+
+	struct Entry
+	{
+		Vector2fx position;
+		uint32_t index = 0;
+	};
+
+	static constexpr uint32_t InvalidSlot = std::numeric_limits<uint32_t>::max();
+	static constexpr uint32_t OverflowBit = static_cast<uint32_t>(1) << 31;
+	static constexpr uint32_t BucketSlack = 2;
+
+	// constructors
+	explicit SpatialGrid2fx(fixed cellSize);
+
+	fixed CellSize() const { return cellSize; }
+	size_t Size() const { return count; }
+	bool Empty() const { return count == 0; }
+	size_t BucketCount() const { return bucketCounts.size(); }
+
+	Cell CellOf(const Vector2fx& position) const;
+
+	/**
+	 * \brief Replaces the contents with \p positions, point i gets index i.
+	 */
+	void Rebuild(std::span<const Vector2fx> positions);
+
+	// Incremental updates, indices don't have to be dense but must stay below OverflowBit
+	void Insert(uint32_t index, const Vector2fx& position);
+	void Remove(uint32_t index);
+	void Move(uint32_t index, const Vector2fx& position);
+	bool Contains(uint32_t index) const { return index < slots.size() && slots[index] != InvalidSlot; }
+
+	/**
+	 * \brief Appends the index of every point within \p radius of \p center (inclusive) to \p out.
+	 * Buckets are visited in memory order and points within a bucket in storage order, so the output order only depends
+	 * on the sequence of updates, not on the platform.
+	 */
+	void QueryRadius(const Vector2fx& center, fixed radius, std::vector<uint32_t>& out) const;
+
+private:
+	fixed cellSize;
+	int cellShift = -1;
+	size_t count = 0;
+	int bucketBits = 0;
+
+	std::vector<uint32_t> bucketStarts;
+	std::vector<uint32_t> bucketCounts;
+	std::vector<Entry> entries;
+	std::vector<Entry> overflow;
+	std::vector<uint32_t> slots;
+
+	static int64_t FloorDiv(int64_t a, int64_t b)
+	{
+		int64_t quotient = a / b;
+		return (a % b != 0 && (a < 0) != (b < 0)) ? quotient - 1 : quotient;
+	}
+
+	uint32_t BucketOf(const Cell& cell) const
+	{
+		uint64_t hash = static_cast<uint64_t>(cell.x) * 0x9E3779B97F4A7C15ull ^ static_cast<uint64_t>(cell.y) * 0xC2B2AE3D27D4EB4Full;
+		return bucketBits == 0 ? 0 : static_cast<uint32_t>(hash >> (64 - bucketBits));
+	}
+
+	void Build(std::vector<Entry>&& items);
+	void Compact();
+	void Detach(uint32_t index);
+	void Attach(const Entry& entry);
+	void QueryBucket(uint32_t bucket, const Vector2fx& center, fixed radiusSquared, std::vector<uint32_t>& out) const;
+};
+
+SpatialGrid2fx::SpatialGrid2fx(fixed cellSize) : cellSize(cellSize)
+{
+	FXMATH_ASSERT(cellSize > fixed::Zero && "Cell size must be positive.");
+
+	const uint64_t rawCellSize = static_cast<uint64_t>(cellSize.rawValue);
+	if (std::has_single_bit(rawCellSize))
+	{
+		cellShift = std::countr_zero(rawCellSize);
+	}
+	Build({});
+}
+
+SpatialGrid2fx::Cell SpatialGrid2fx::CellOf(const Vector2fx& position) const
+{
+	// Arithmetic shift on the raw value is an exact floor division by a power of two cell size
+	if (cellShift >= 0)
+	{
+		return Cell { position.x.rawValue >> cellShift, position.y.rawValue >> cellShift };
+	}
+	return Cell { FloorDiv(position.x.rawValue, cellSize.rawValue), FloorDiv(position.y.rawValue, cellSize.rawValue) };
+}
+
+void SpatialGrid2fx::Rebuild(std::span<const Vector2fx> positions)
+{
+	FXMATH_ASSERT(positions.size() < OverflowBit && "Too many points.");
+
+	std::vector<Entry> items(positions.size());
+	for (size_t i = 0; i < positions.size(); ++i)
+	{
+		items[i] = Entry { positions[i], static_cast<uint32_t>(i) };
+	}
+	Build(std::move(items));
+}
+
+void SpatialGrid2fx::Build(std::vector<Entry>&& items)
+{
+	// Roughly two points per bucket, always a power of two so the hash only needs its top bits
+	bucketBits = std::max(4, static_cast<int>(std::bit_width(items.size() / 2)));
+	const size_t numBuckets = static_cast<size_t>(1) << bucketBits;
+
+	std::vector<uint32_t> itemBuckets(items.size());
+	bucketCounts.assign(numBuckets, 0);
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		itemBuckets[i] = BucketOf(CellOf(items[i].position));
+		++bucketCounts[itemBuckets[i]];
+	}
+
+	// Counting sort into one array, every bucket followed by BucketSlack free entries
+	bucketStarts.resize(numBuckets + 1);
+	uint32_t offset = 0;
+	for (size_t bucket = 0; bucket < numBuckets; ++bucket)
+	{
+		bucketStarts[bucket] = offset;
+		offset += bucketCounts[bucket] + BucketSlack;
+		bucketCounts[bucket] = 0;
+	}
+	bucketStarts[numBuckets] = offset;
+
+	entries.resize(offset);
+	overflow.clear();
+	slots.clear();
+	for (size_t i = 0; i < items.size(); ++i)
+	{
+		const uint32_t bucket = itemBuckets[i];
+		const uint32_t slot = bucketStarts[bucket] + bucketCounts[bucket]++;
+		entries[slot] = items[i];
+		if (items[i].index >= slots.size())
+		{
+			slots.resize(static_cast<size_t>(items[i].index) + 1, InvalidSlot);
+		}
+		FXMATH_ASSERT(slots[items[i].index] == InvalidSlot && "Duplicate index.");
+		slots[items[i].index] = slot;
+	}
+	count = items.size();
+}
+
+void SpatialGrid2fx::Compact()
+{
+	std::vector<Entry> items;
+	items.reserve(count);
+	for (size_t bucket = 0; bucket < bucketCounts.size(); ++bucket)
+	{
+		const Entry* begin = entries.data() + bucketStarts[bucket];
+		items.insert(items.end(), begin, begin + bucketCounts[bucket]);
+	}
+	items.insert(items.end(), overflow.begin(), overflow.end());
+	Build(std::move(items));
+}
+
+void SpatialGrid2fx::Detach(uint32_t index)
+{
+	const uint32_t slot = slots[index];
+	slots[index] = InvalidSlot;
+
+	// Swap the last entry of the bucket (or of the overflow list) into the hole
+	if (slot & OverflowBit)
+	{
+		const uint32_t position = slot & ~OverflowBit;
+		overflow[position] = overflow.back();
+		overflow.pop_back();
+		if (position < overflow.size())
+		{
+			slots[overflow[position].index] = position | OverflowBit;
+		}
+		return;
+	}
+
+	const uint32_t bucket = static_cast<uint32_t>(std::upper_bound(bucketStarts.begin(), bucketStarts.end(), slot) - bucketStarts.begin()) - 1;
+	const uint32_t last = bucketStarts[bucket] + --bucketCounts[bucket];
+	if (slot != last)
+	{
+		entries[slot] = entries[last];
+		slots[entries[slot].index] = slot;
+	}
+}
+
+void SpatialGrid2fx::Attach(const Entry& entry)
+{
+	if (entry.index >= slots.size())
+	{
+		slots.resize(static_cast<size_t>(entry.index) + 1, InvalidSlot);
+	}
+
+	const uint32_t bucket = BucketOf(CellOf(entry.position));
+	if (bucketStarts[bucket] + bucketCounts[bucket] < bucketStarts[bucket + 1])
+	{
+		const uint32_t slot = bucketStarts[bucket] + bucketCounts[bucket]++;
+		entries[slot] = entry;
+		slots[entry.index] = slot;
+	}
+	else
+	{
+		slots[entry.index] = static_cast<uint32_t>(overflow.size()) | OverflowBit;
+		overflow.push_back(entry);
+	}
+}
+
+void SpatialGrid2fx::Insert(uint32_t index, const Vector2fx& position)
+{
+	FXMATH_ASSERT(index < OverflowBit && !Contains(index) && "Index out of range or already in the grid.");
+
+	Attach(Entry { position, index });
+	++count;
+
+	// Overflow entries are scanned by every query, once there are too many fold them back into the buckets
+	if (overflow.size() > count / 8 + 16)
+	{
+		Compact();
+	}
+}
+
+void SpatialGrid2fx::Remove(uint32_t index)
+{
+	FXMATH_ASSERT(Contains(index) && "Index is not in the grid.");
+
+	Detach(index);
+	--count;
+}
+
+void SpatialGrid2fx::Move(uint32_t index, const Vector2fx& position)
+{
+	FXMATH_ASSERT(Contains(index) && "Index is not in the grid.");
+
+	const uint32_t slot = slots[index];
+	Entry& current = (slot & OverflowBit) ? overflow[slot & ~OverflowBit] : entries[slot];
+
+	// Staying in the same bucket is by far the common case and only updates the stored position
+	if (BucketOf(CellOf(current.position)) == BucketOf(CellOf(position)))
+	{
+		current.position = position;
+		return;
+	}
+
+	Detach(index);
+	Attach(Entry { position, index });
+	if (overflow.size() > count / 8 + 16)
+	{
+		Compact();
+	}
+}
+
+void SpatialGrid2fx::QueryBucket(uint32_t bucket, const Vector2fx& center, fixed radiusSquared, std::vector<uint32_t>& out) const
+{
+	const Entry* begin = entries.data() + bucketStarts[bucket];
+	const Entry* end = begin + bucketCounts[bucket];
+	for (const Entry* entry = begin; entry != end; ++entry)
+	{
+		if (Vector2fx::DistanceSquared(entry->position, center) <= radiusSquared)
+		{
+			out.push_back(entry->index);
+		}
+	}
+}
+
+void SpatialGrid2fx::QueryRadius(const Vector2fx& center, fixed radius, std::vector<uint32_t>& out) const
+{
+	const fixed radiusSquared = radius * radius;
+	const Cell low = CellOf(Vector2fx(center.x - radius, center.y - radius));
+	const Cell high = CellOf(Vector2fx(center.x + radius, center.y + radius));
+	const uint64_t cellsX = static_cast<uint64_t>(high.x - low.x) + 1;
+	const uint64_t cellsY = static_cast<uint64_t>(high.y - low.y) + 1;
+	const size_t numBuckets = bucketCounts.size();
+
+	if (cellsX >= numBuckets || cellsY >= numBuckets || cellsX * cellsY >= numBuckets)
+	{
+		// The query covers more cells than there are buckets, every bucket is probably hit anyway
+		for (uint32_t bucket = 0; bucket < numBuckets; ++bucket)
+		{
+			QueryBucket(bucket, center, radiusSquared, out);
+		}
+	}
+	else
+	{
+		// Several cells can hash into the same bucket, visit each bucket once so no point is reported twice.
+		// Typical queries cover a handful of cells so the list stays on the stack.
+		constexpr size_t kInlineBuckets = 64;
+		std::array<uint32_t, kInlineBuckets> inlineBuckets;
+		std::vector<uint32_t> heapBuckets;
+		const size_t numCells = static_cast<size_t>(cellsX * cellsY);
+		uint32_t* buckets = inlineBuckets.data();
+		if (numCells > kInlineBuckets)
+		{
+			heapBuckets.resize(numCells);
+			buckets = heapBuckets.data();
+		}
+
+		size_t numVisited = 0;
+		for (int64_t y = low.y; y <= high.y; ++y)
+		{
+			for (int64_t x = low.x; x <= high.x; ++x)
+			{
+				buckets[numVisited++] = BucketOf(Cell { x, y });
+			}
+		}
+		std::sort(buckets, buckets + numVisited);
+		numVisited = static_cast<size_t>(std::unique(buckets, buckets + numVisited) - buckets);
+		for (size_t i = 0; i < numVisited; ++i)
+		{
+			QueryBucket(buckets[i], center, radiusSquared, out);
+		}
+	}
+
+	for (const Entry& entry : overflow)
+	{
+		if (Vector2fx::DistanceSquared(entry.position, center) <= radiusSquared)
+		{
+			out.push_back(entry.index);
+		}
+	}
+}
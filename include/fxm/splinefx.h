@@ -0,0 +1,348 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedwide.h"
+#include "vector2fx.h"
+
+namespace Mathfx
+{
+	namespace internal
+	{
+		// Scalar type, component access and distance for the values a spline can interpolate
+		template <typename V>
+		struct SplineTraits;
+
+		template <typename T, int F>
+		struct SplineTraits<Fixed<T, F>>
+		{
+			using scalar = Fixed<T, F>;
+			static constexpr int Dimensions = 1;
+
+			static scalar& Component(scalar& value, int) { return value; }
+			static scalar Component(const scalar& value, int) { return value; }
+			static scalar Distance(const scalar& a, const scalar& b) { return Abs(b - a); }
+		};
+
+		template <>
+		struct SplineTraits<Vector2fx>
+		{
+			using scalar = Vector2fx::fixed;
+			static constexpr int Dimensions = 2;
+
+			static scalar& Component(Vector2fx& value, int index) { return index == 0 ? value.x : value.y; }
+			static scalar Component(const Vector2fx& value, int index) { return index == 0 ? value.x : value.y; }
+			static scalar Distance(const Vector2fx& a, const Vector2fx& b) { return Vector2fx::Distance(a, b); }
+		};
+
+		// Fraction bits below the raw value kept while forward differencing. Each step adds the rounding of the third
+		// difference once more, after n steps the error is about n^3 / 6 units of these bits.
+		constexpr int ForwardDifferenceBits = 56;
+
+		// Running value and first three differences of a cubic sampled at a fixed step, scaled by ForwardDifferenceBits
+		struct ForwardDifferences
+		{
+			Int128 value;
+			Int128 first;
+			Int128 second;
+			Int128 third;
+
+			ForwardDifferences() = default;
+
+			// Coefficients of a t^3 + b t^2 + c t + d as raw values, steps of 1 / intervals
+			ForwardDifferences(int64_t a, int64_t b, int64_t c, int64_t d, uint64_t intervals)
+			{
+				const uint64_t squared = intervals * intervals;
+				const uint64_t cubed = squared * intervals;
+				const Int128 ah = Int128::DivFloor(Int128(a) << ForwardDifferenceBits, cubed);
+				const Int128 a6h = Int128::DivFloor(Int128::Mul(a, 6) << ForwardDifferenceBits, cubed);
+				const Int128 bh = Int128::DivFloor(Int128(b) << ForwardDifferenceBits, squared);
+				const Int128 b2h = Int128::DivFloor(Int128::Mul(b, 2) << ForwardDifferenceBits, squared);
+				const Int128 ch = Int128::DivFloor(Int128(c) << ForwardDifferenceBits, intervals);
+
+				// Starting half a unit up turns the shift that reads each sample into rounding to nearest
+				value = (Int128(d) << ForwardDifferenceBits) + (Int128(1) << (ForwardDifferenceBits - 1));
+				first = ah + bh + ch;
+				second = a6h + b2h;
+				third = a6h;
+			}
+
+			int64_t Raw() const { return (value >> ForwardDifferenceBits).Low(); }
+
+			void Step()
+			{
+				value += first;
+				first += second;
+				second += third;
+			}
+		};
+	}
+}
+
+/**
+ * \brief One cubic segment p(t) = a t^3 + b t^2 + c t + d for t in [0, 1] over Fixed values or Vector2fx points.
+ * The factories convert Bezier, Hermite and Catmull-Rom control points to these power basis coefficients once, so
+ * Evaluate is three FastMuls per component by Horner's rule instead of the six lerps of de Casteljau. Sample fills
+ * evenly spaced points by forward differencing, only 128 bit adds per point, and stays within an ulp or two of the exact
+ * curve up to a million samples. Control points should stay within an eighth of the range, the coefficients are sums
+ * of up to eight of them and wrap like the rest of the FastMul arithmetic.
+ */
+template <typename V>
+struct CubicSplinefx
+{
+	using Traits = Mathfx::internal::SplineTraits<V>;
+	using fixed = typename Traits::scalar;
+
+	V a;
+	V b;
+	V c;
+	V d;
+
+	// static methods
+
+	/**
+	 * \brief Cubic Bezier from \p p0 to \p p3 pulled towards \p p1 and \p p2.
+	 */
+	static CubicSplinefx Bezier(const V& p0, const V& p1, const V& p2, const V& p3);
+
+	/**
+	 * \brief Quadratic Bezier from \p p0 to \p p2 with control point \p p1, e.g. a projectile arc.
+	 */
+	static CubicSplinefx QuadraticBezier(const V& p0, const V& p1, const V& p2);
+
+	/**
+	 * \brief Hermite segment from \p p0 to \p p1 leaving with tangent \p m0 and arriving with tangent \p m1.
+	 */
+	static CubicSplinefx Hermite(const V& p0, const V& m0, const V& p1, const V& m1);
+
+	/**
+	 * \brief Uniform Catmull-Rom segment from \p p1 to \p p2, \p p0 and \p p3 are the neighbouring points on the path.
+	 */
+	static CubicSplinefx CatmullRom(const V& p0, const V& p1, const V& p2, const V& p3);
+
+	// instance methods
+	V Evaluate(fixed t) const;
+
+	/**
+	 * \brief Derivative with respect to t, the direction of travel.
+	 */
+	V Tangent(fixed t) const;
+
+	/**
+	 * \brief Fills \p out with the points at t = i / (out.size() - 1), both ends included.
+	 */
+	void Sample(std::span<V> out) const;
+};
+
+template <typename V>
+CubicSplinefx<V> CubicSplinefx<V>::Bezier(const V& p0, const V& p1, const V& p2, const V& p3)
+{
+	const V p1p1p1 = p1 + p1 + p1;
+	const V p2p2p2 = p2 + p2 + p2;
+	const V p0p0p0 = p0 + p0 + p0;
+	return { p3 - p0 + p1p1p1 - p2p2p2, p0p0p0 - p1p1p1 - p1p1p1 + p2p2p2, p1p1p1 - p0p0p0, p0 };
+}
+
+template <typename V>
+CubicSplinefx<V> CubicSplinefx<V>::QuadraticBezier(const V& p0, const V& p1, const V& p2)
+{
+	const V toControl = p1 - p0;
+	return { V(), p2 - p1 - toControl, toControl + toControl, p0 };
+}
+
+template <typename V>
+CubicSplinefx<V> CubicSplinefx<V>::Hermite(const V& p0, const V& m0, const V& p1, const V& m1)
+{
+	const V span = p1 - p0;
+	const V span3 = span + span + span;
+	return { m0 + m1 - span - span, span3 - m0 - m0 - m1, m0, p0 };
+}
+
+template <typename V>
+CubicSplinefx<V> CubicSplinefx<V>::CatmullRom(const V& p0, const V& p1, const V& p2, const V& p3)
+{
+	// Hermite with tangents (p2 - p0) / 2 and (p3 - p1) / 2
+	return Hermite(p1, (p2 - p0) * fixed::Half, p2, (p3 - p1) * fixed::Half);
+}
+
+template <typename V>
+V CubicSplinefx<V>::Evaluate(fixed t) const
+{
+	return ((a * t + b) * t + c) * t + d;
+}
+
+template <typename V>
+V CubicSplinefx<V>::Tangent(fixed t) const
+{
+	const V a3 = a + a + a;
+	return (a3 * t + b + b) * t + c;
+}
+
+template <typename V>
+void CubicSplinefx<V>::Sample(std::span<V> out) const
+{
+	using namespace Mathfx::internal;
+
+	if (out.size() < 2)
+	{
+		if (!out.empty())
+		{
+			out[0] = d;
+		}
+		return;
+	}
+	FXMATH_ASSERT(out.size() <= (1u << 20) + 1 && "Forward differencing is only accurate up to 2^20 intervals.");
+
+	const uint64_t intervals = out.size() - 1;
+	ForwardDifferences differences[Traits::Dimensions] = {};
+	for (int k = 0; k < Traits::Dimensions; ++k)
+	{
+		differences[k] = ForwardDifferences(Traits::Component(a, k).rawValue, Traits::Component(b, k).rawValue,
+			Traits::Component(c, k).rawValue, Traits::Component(d, k).rawValue, intervals);
+	}
+
+	using raw = typename fixed::raw;
+	for (V& point : out)
+	{
+		for (int k = 0; k < Traits::Dimensions; ++k)
+		{
+			Traits::Component(point, k) = fixed(static_cast<raw>(differences[k].Raw()));
+			differences[k].Step();
+		}
+	}
+}
+
+/**
+ * \brief Inverse arc length of a CubicSplinefx for constant speed traversal.
+ * The segment is sampled by forward differencing and the chord lengths summed, then inverted into a table of the
+ * parameter t at evenly spaced distances along the curve. Parameter is one table read and a lerp, and the error is that
+ * of replacing the curve by its chords, so a few dozen entries are enough for gently bent segments.
+ */
+template <typename V>
+struct ArcLengthTablefx
+{
+	using fixed = typename CubicSplinefx<V>::fixed;
+	using raw = typename fixed::raw;
+
+	// constructors
+	ArcLengthTablefx(const CubicSplinefx<V>& spline, size_t resolution);
+
+	// instance methods
+	fixed Length() const { return length; }
+
+	/**
+	 * \brief Parameter t of the point \p distance along the curve, clamped to the ends.
+	 */
+	fixed Parameter(fixed distance) const;
+
+	/**
+	 * \brief Point \p distance along the curve.
+	 */
+	V Evaluate(fixed distance) const { return spline.Evaluate(Parameter(distance)); }
+
+	/**
+	 * \brief Fills \p out with points evenly spaced along the curve from start to end.
+	 */
+	void SampleUniform(std::span<V> out) const;
+
+private:
+	CubicSplinefx<V> spline;
+	fixed length;
+
+	// t at distance i * length / (parameters.size() - 1)
+	std::vector<fixed> parameters;
+
+	// The point i of count - 1 equal steps from zero to total, rounded down
+	static fixed Step(fixed total, size_t i, uint64_t intervals)
+	{
+		return fixed(static_cast<raw>(Int128::DivFloor(Int128::Mul(total.rawValue, static_cast<int64_t>(i)), intervals).Low()));
+	}
+};
+
+template <typename V>
+ArcLengthTablefx<V>::ArcLengthTablefx(const CubicSplinefx<V>& spline, size_t resolution) : spline(spline), parameters(resolution)
+{
+	FXMATH_ASSERT(resolution >= 2 && "An arc length table needs at least both ends.");
+
+	using Traits = typename CubicSplinefx<V>::Traits;
+
+	std::vector<V> points(resolution);
+	spline.Sample(points);
+	std::vector<fixed> distances(resolution);
+	distances[0] = fixed::Zero;
+	for (size_t i = 1; i < resolution; ++i)
+	{
+		distances[i] = distances[i - 1] + Traits::Distance(points[i - 1], points[i]);
+	}
+	length = distances.back();
+
+	const uint64_t intervals = resolution - 1;
+	if (length == fixed::Zero)
+	{
+		for (size_t j = 0; j < resolution; ++j)
+		{
+			parameters[j] = Step(fixed::One, j, intervals);
+		}
+		return;
+	}
+
+	// Both the targets and the chord ends only grow, one walk over the chords places every target
+	size_t chord = 0;
+	for (size_t j = 0; j < resolution; ++j)
+	{
+		const fixed target = Step(length, j, intervals);
+		while (chord + 2 < resolution && distances[chord + 1] <= target)
+		{
+			++chord;
+		}
+		const fixed chordLength = distances[chord + 1] - distances[chord];
+		const fixed along = chordLength == fixed::Zero ? fixed::Zero : Mathfx::Clamp((target - distances[chord]) / chordLength, fixed::Zero, fixed::One);
+		const Int128 position = (Int128(static_cast<int64_t>(chord)) << fixed::FractionShift) + Int128(static_cast<int64_t>(along.rawValue));
+		parameters[j] = fixed(static_cast<raw>(Int128::DivFloor(position, intervals).Low()));
+	}
+	parameters.back() = fixed::One;
+}
+
+template <typename V>
+typename ArcLengthTablefx<V>::fixed ArcLengthTablefx<V>::Parameter(fixed distance) const
+{
+	if (distance <= fixed::Zero)
+	{
+		return fixed::Zero;
+	}
+	if (distance >= length)
+	{
+		return fixed::One;
+	}
+
+	// Position in the table with fraction bits, distance * (size - 1) / length
+	const uint64_t intervals = parameters.size() - 1;
+	const Int128 scaled = Int128::Mul(distance.rawValue, static_cast<int64_t>(intervals)) << fixed::FractionShift;
+	const int64_t position = Int128::DivUnsigned(scaled, static_cast<uint64_t>(length.rawValue)).Low();
+	const size_t index = static_cast<size_t>(position >> fixed::FractionShift);
+	const fixed fraction = fixed(static_cast<raw>(position & (fixed::RawOne - 1)));
+	return parameters[index] + (parameters[index + 1] - parameters[index]) * fraction;
+}
+
+template <typename V>
+void ArcLengthTablefx<V>::SampleUniform(std::span<V> out) const
+{
+	if (out.size() < 2)
+	{
+		if (!out.empty())
+		{
+			out[0] = spline.d;
+		}
+		return;
+	}
+
+	const uint64_t intervals = out.size() - 1;
+	for (size_t i = 0; i < out.size(); ++i)
+	{
+		out[i] = Evaluate(Step(length, i, intervals));
+	}
+}
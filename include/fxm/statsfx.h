@@ -0,0 +1,389 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedwide.h"
+#include "parallelfx.h"
+
+namespace Mathfx
+{
+	namespace internal
+	{
+		// x * factor keeping the low 128 bits
+		constexpr Int128 WideScale(const Int128& x, uint64_t factor)
+		{
+			Int128 result = Int128::MulUnsigned(x.lo, factor);
+			result.hi += x.hi * factor;
+			return result;
+		}
+
+		// floor(sum / count) for a count that is not zero, in 64 bits while the sum fits
+		constexpr Int128 FloorMean(const Int128& sum, uint64_t count)
+		{
+			if (sum.FitsInt64() && count <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))
+			{
+				const int64_t value = sum.Low();
+				const int64_t divisor = static_cast<int64_t>(count);
+				const int64_t quotient = value / divisor;
+				return Int128(quotient - (value % divisor < 0 ? 1 : 0));
+			}
+			return Int128::DivFloor(sum, count);
+		}
+	}
+
+	/**
+	 * \brief Single pass count, sum, mean, variance, min and max of a stream of values.
+	 * Count, sum, mean, min and max are exact: the sum is kept in 128 bits and the mean is the floor of the exact average.
+	 * For 32 bit and narrower backing types the sum of squared raw values is kept exactly as well, a squared raw value is
+	 * at most 2^62 so 2^64 of them fit in 128 bits. Mean and variance are derived from the sums when they are read, the
+	 * variance is the floor of the exact value and Merge is plain addition, so the result is the same bits however the
+	 * values were split and merged, and the same as adding them all to one Stats.
+	 * fixed64 squares don't fit, there the variance follows Welford's method: every value adds
+	 * (x - old mean) * (x - new mean) to a 128 bit sum of squared deviations that keeps F fractional bits, and Merge
+	 * combines two partial results with Chan's formula. Each step truncates so the variance is within a few ulps of exact,
+	 * and only the same values added and merged in the same order give the same bits. ParallelStats fixes that order for
+	 * any thread count.
+	 */
+	template <typename T, int F>
+	struct Stats
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+
+		// instance methods
+		void Add(fixed x);
+		void Add(std::span<const fixed> values);
+
+		/**
+		 * \brief Combines \p other into this as if its values had been added here.
+		 */
+		void Merge(const Stats& other);
+
+		uint64_t Count() const { return count; }
+
+		// Sum of all values saturated to the type's range
+		fixed Sum() const;
+
+		// Values below are Zero for an empty stream, Min and Max are MaxValue and MinValue like ParallelMinMax
+		fixed Mean() const;
+		fixed Min() const { return fixed(min); }
+		fixed Max() const { return fixed(max); }
+
+		/**
+		 * \brief Population variance, the mean squared deviation, saturated to MaxValue.
+		 */
+		fixed Variance() const { return count == 0 ? fixed::Zero : Divide(count); }
+
+		/**
+		 * \brief Unbiased variance of a sample, the squared deviations divided by Count - 1.
+		 */
+		fixed SampleVariance() const { return count < 2 ? fixed::Zero : Divide(count - 1); }
+
+		/**
+		 * \brief Square root of the population variance, taken from the full width variance so it doesn't saturate with it.
+		 */
+		fixed StdDev() const;
+
+	private:
+		static constexpr bool ExactSums = sizeof(T) <= 4;
+
+		uint64_t count = 0;
+		Int128 sum;
+
+		// Running floor of the mean, only kept for Welford's method
+		raw mean = 0;
+
+		// With ExactSums the sum of squared raw values, otherwise the sum of squared deviations from the mean scaled like
+		// a raw value
+		Int128 squares;
+
+		raw min = fixed::RawMaxValue;
+		raw max = fixed::RawMinValue;
+
+		static int64_t Deviation(raw x, raw from)
+		{
+			return (Int128(static_cast<int64_t>(x)) - Int128(static_cast<int64_t>(from))).SaturateToInt64();
+		}
+
+		// Rounding can leave the sum of squares a hair below zero when the values are all but equal
+		Int128 Squares() const { return squares.IsNegative() ? Int128() : squares; }
+
+		// Floor of the exact sum of squared deviations from the mean with 2 * F fractional bits, from the exact sums
+		Int128 ExactDeviations() const;
+
+		fixed Divide(uint64_t divisor) const;
+	};
+
+	template <typename T, int F>
+	void Stats<T, F>::Add(fixed x)
+	{
+		++count;
+		sum += Int128(static_cast<int64_t>(x.rawValue));
+		min = std::min(min, x.rawValue);
+		max = std::max(max, x.rawValue);
+		if constexpr (ExactSums)
+		{
+			squares += Int128(static_cast<int64_t>(x.rawValue) * x.rawValue);
+			return;
+		}
+
+		const raw previous = mean;
+		mean = static_cast<raw>(internal::FloorMean(sum, count).Low());
+		squares += Int128::Mul(Deviation(x.rawValue, previous), Deviation(x.rawValue, mean)) >> F;
+	}
+
+	template <typename T, int F>
+	void Stats<T, F>::Add(std::span<const fixed> values)
+	{
+		for (fixed x : values)
+		{
+			Add(x);
+		}
+	}
+
+	template <typename T, int F>
+	void Stats<T, F>::Merge(const Stats& other)
+	{
+		if (other.count == 0)
+		{
+			return;
+		}
+		if constexpr (ExactSums)
+		{
+			count += other.count;
+			sum += other.sum;
+			squares += other.squares;
+			min = std::min(min, other.min);
+			max = std::max(max, other.max);
+			return;
+		}
+		if (count == 0)
+		{
+			*this = other;
+			return;
+		}
+
+		// The squares gain (mean b - mean a)^2 * na * nb / n. Scaling by the smaller count before the division and by the
+		// larger one after keeps the intermediate within 128 bits.
+		const uint64_t total = count + other.count;
+		const int64_t delta = Deviation(other.mean, mean);
+		const Int128 deltaSquared = Int128::Mul(delta, delta) >> F;
+		const uint64_t smaller = std::min(count, other.count);
+		const uint64_t larger = std::max(count, other.count);
+		squares += other.squares;
+		squares += internal::WideScale(Int128::DivUnsigned(internal::WideScale(deltaSquared, smaller), total), larger);
+
+		count = total;
+		sum += other.sum;
+		mean = static_cast<raw>(internal::FloorMean(sum, count).Low());
+		min = std::min(min, other.min);
+		max = std::max(max, other.max);
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Stats<T, F>::Sum() const
+	{
+		if (sum > Int128(static_cast<int64_t>(fixed::RawMaxValue)))
+		{
+			return fixed::MaxValue;
+		}
+		if (sum < Int128(static_cast<int64_t>(fixed::RawMinValue)))
+		{
+			return fixed::MinValue;
+		}
+		return fixed(static_cast<raw>(sum.Low()));
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Stats<T, F>::Mean() const
+	{
+		if constexpr (ExactSums)
+		{
+			return count == 0 ? fixed::Zero : fixed(static_cast<raw>(internal::FloorMean(sum, count).Low()));
+		}
+		return fixed(mean);
+	}
+
+	template <typename T, int F>
+	Int128 Stats<T, F>::ExactDeviations() const
+	{
+		// With sum = q * count + r and 0 <= r < count the squared deviations add up to
+		// squares - q^2 * count - 2 * q * r - r^2 / count, every term fits 128 bits and only the last one isn't whole
+		const int64_t q = internal::FloorMean(sum, count).Low();
+		const uint64_t r = (sum - internal::WideScale(Int128(q), count)).lo;
+		uint64_t remainder = 0;
+		Int128 fraction = Int128::DivUnsigned(Int128::MulUnsigned(r, r), count, &remainder);
+		if (remainder != 0)
+		{
+			fraction += Int128(1);
+		}
+		const Int128 deviations = squares - internal::WideScale(Int128(q * q), count) - internal::WideScale(Int128(2 * q), r) - fraction;
+		return deviations.IsNegative() ? Int128() : deviations;
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Stats<T, F>::Divide(uint64_t divisor) const
+	{
+		// floor(floor(x / a) / b) is floor(x / (a * b)), so dropping the extra F bits after the division rounds once
+		const Int128 variance = ExactSums ? Int128::DivUnsigned(ExactDeviations(), divisor) >> F : Int128::DivUnsigned(Squares(), divisor);
+		return variance > Int128(static_cast<int64_t>(fixed::RawMaxValue)) ? fixed::MaxValue : fixed(static_cast<raw>(variance.Low()));
+	}
+
+	template <typename T, int F>
+	Fixed<T, F> Stats<T, F>::StdDev() const
+	{
+		if (count == 0)
+		{
+			return fixed::Zero;
+		}
+
+		if constexpr (ExactSums)
+		{
+			return WideSqrt<T, F>(Int128::DivUnsigned(ExactDeviations(), count));
+		}
+
+		// The variance has F fractional bits, shifted up by F it has the 2 * F of a squared raw value WideSqrt expects
+		return WideSqrt<T, F>(Int128::DivUnsigned(Squares(), count) << F);
+	}
+
+	/**
+	 * \brief Counts values into equal width bins starting at min, values outside the bins count as underflow or overflow.
+	 * Bin indices are an integer division of the offset from min, or a shift when the raw bin width is a power of two.
+	 * Counts are exact, so merged histograms are identical whatever the order.
+	 */
+	template <typename T, int F>
+	struct Histogram
+	{
+		using fixed = Fixed<T, F>;
+		using raw = typename fixed::raw;
+		using uraw = typename fixed::uraw;
+
+		// constructors
+		Histogram(fixed min, fixed binWidth, size_t binCount);
+
+		// instance methods
+		void Add(fixed x);
+		void Add(std::span<const fixed> values);
+
+		/**
+		 * \brief Adds the counts of \p other, which must have the same bins.
+		 */
+		void Merge(const Histogram& other);
+
+		/**
+		 * \brief Bin \p x falls into, BinCount() when it is outside the bins.
+		 */
+		size_t BinIndex(fixed x) const;
+
+		size_t BinCount() const { return bins.size(); }
+		uint64_t Bin(size_t index) const { return bins[index]; }
+		uint64_t Underflow() const { return underflow; }
+		uint64_t Overflow() const { return overflow; }
+		fixed BinStart(size_t index) const { return fixed(static_cast<raw>(min + static_cast<raw>(index * width))); }
+
+	private:
+		raw min;
+		uraw width;
+
+		// log2 of the width when it is a power of two, -1 otherwise
+		int shift;
+
+		std::vector<uint64_t> bins;
+		uint64_t underflow = 0;
+		uint64_t overflow = 0;
+	};
+
+	template <typename T, int F>
+	Histogram<T, F>::Histogram(fixed min, fixed binWidth, size_t binCount) : min(min.rawValue), width(static_cast<uraw>(binWidth.rawValue)), bins(binCount, 0)
+	{
+		FXMATH_ASSERT(binWidth > fixed::Zero && binCount > 0 && "Histogram needs at least one bin of positive width.");
+		shift = std::has_single_bit(width) ? std::countr_zero(width) : -1;
+	}
+
+	template <typename T, int F>
+	size_t Histogram<T, F>::BinIndex(fixed x) const
+	{
+		if (x.rawValue < min)
+		{
+			return bins.size();
+		}
+
+		// The offset always fits the unsigned type even when the signed difference would overflow
+		const uraw offset = static_cast<uraw>(static_cast<uraw>(x.rawValue) - static_cast<uraw>(min));
+		const uraw index = shift >= 0 ? static_cast<uraw>(offset >> shift) : static_cast<uraw>(offset / width);
+		return index < bins.size() ? static_cast<size_t>(index) : bins.size();
+	}
+
+	template <typename T, int F>
+	void Histogram<T, F>::Add(fixed x)
+	{
+		const size_t index = BinIndex(x);
+		if (index < bins.size())
+		{
+			++bins[index];
+		}
+		else if (x.rawValue < min)
+		{
+			++underflow;
+		}
+		else
+		{
+			++overflow;
+		}
+	}
+
+	template <typename T, int F>
+	void Histogram<T, F>::Add(std::span<const fixed> values)
+	{
+		for (fixed x : values)
+		{
+			Add(x);
+		}
+	}
+
+	template <typename T, int F>
+	void Histogram<T, F>::Merge(const Histogram& other)
+	{
+		FXMATH_ASSERT(min == other.min && width == other.width && bins.size() == other.bins.size() && "Histograms must have the same bins.");
+
+		for (size_t i = 0; i < bins.size(); ++i)
+		{
+			bins[i] += other.bins[i];
+		}
+		underflow += other.underflow;
+		overflow += other.overflow;
+	}
+
+	/**
+	 * \brief Stats of all values, built per ParallelChunkSize chunk across the pool and merged in chunk order, so the
+	 * result is the same for every thread count. For 32 bit and narrower backing types it is also the same as adding every
+	 * value to one Stats.
+	 */
+	template <typename T, int F>
+	Stats<T, F> ParallelStats(std::span<const Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		std::vector<Stats<T, F>> partials(ParallelChunkCount(values.size()));
+		pool.ParallelFor(partials.size(), [&](size_t chunk) {
+			const size_t begin = chunk * ParallelChunkSize;
+			partials[chunk].Add(values.subspan(begin, std::min(ParallelChunkSize, values.size() - begin)));
+		});
+
+		Stats<T, F> total;
+		for (const Stats<T, F>& partial : partials)
+		{
+			total.Merge(partial);
+		}
+		return total;
+	}
+
+	template <typename T, int F>
+	Stats<T, F> ParallelStats(std::span<Fixed<T, F>> values, ThreadPool& pool = DefaultThreadPool())
+	{
+		return ParallelStats(std::span<const Fixed<T, F>>(values), pool);
+	}
+}
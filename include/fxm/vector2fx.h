@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <span>
+
 #include "fixedtype.h"
 #include "fixedmath.h"
+#include "fixedsimd.h"
 
 struct Vector2fx
 {
@@ -95,6 +99,12 @@ struct Vector2fx
 	static Vector2fx Reflect(const Vector2fx& vec, const Vector2fx& normal);
 	static bool ApproxEqual(const Vector2fx& a, const Vector2fx& b, int ignoreBits = fixed::EpsilonBits);
 
+	// batch methods, bit-identical to calling the single vector version on every element
+	static void MagnitudeBatch(std::span<const Vector2fx> vecs, std::span<fixed> out);
+	static void NormalizeBatch(std::span<const Vector2fx> vecs, std::span<Vector2fx> out);
+	static void DistanceToPointBatch(const Vector2fx& point, std::span<const Vector2fx> vecs, std::span<fixed> out);
+	static void DistanceSquaredToPointBatch(const Vector2fx& point, std::span<const Vector2fx> vecs, std::span<fixed> out);
+
 	// instance methods
 	fixed Magnitude() const
 	{
@@ -123,6 +133,7 @@ constexpr Vector2fx Vector2fx::Down(fixed::Zero, fixed::NegOne);
 
 inline Vector2fx operator+(Vector2fx a, const Vector2fx& b) { return a += b; }
 inline Vector2fx operator-(Vector2fx a, const Vector2fx& b) { return a -= b; }
+inline Vector2fx operator-(const Vector2fx& a) { return Vector2fx(-a.x, -a.y); }
 inline Vector2fx operator*(Vector2fx a, const Vector2fx& b) { return a *= b; }
 inline Vector2fx operator*(Vector2fx a, fixed b) { return a *= b; }
 inline Vector2fx operator*(fixed a, Vector2fx b) { return b *= a; }
@@ -258,3 +269,90 @@ bool Vector2fx::ApproxEqual(const Vector2fx& a, const Vector2fx& b, int ignoreBi
 	return Mathfx::ApproxEqual(a.x, b.x, ignoreBits)
 		&& Mathfx::ApproxEqual(a.y, b.y, ignoreBits);
 }
+
+void Vector2fx::MagnitudeBatch(std::span<const Vector2fx> vecs, std::span<fixed> out)
+{
+	FXMATH_ASSERT(vecs.size() == out.size() && "Input and output spans must be the same length.");
+
+	size_t i = 0;
+#if FXMATH_AVX2
+	for (; i + 4 <= vecs.size(); i += 4)
+	{
+		__m256i vx, vy;
+		Mathfx::simd::LoadDeinterleaved4(&vecs[i].x, vx, vy);
+		__m256i sqrMagnitude = _mm256_add_epi64(Mathfx::simd::FastMul4(vx, vx), Mathfx::simd::FastMul4(vy, vy));
+		Mathfx::simd::Store4(&out[i], Mathfx::simd::Unshuffle4(Mathfx::simd::FastSqrt4(sqrMagnitude)));
+	}
+#endif
+	for (; i < vecs.size(); ++i)
+	{
+		out[i] = vecs[i].Magnitude();
+	}
+}
+
+void Vector2fx::NormalizeBatch(std::span<const Vector2fx> vecs, std::span<Vector2fx> out)
+{
+	FXMATH_ASSERT(vecs.size() == out.size() && "Input and output spans must be the same length.");
+
+	// Square roots go through MagnitudeBatch in blocks, the divides stay scalar so the result matches Normalize exactly
+	constexpr size_t blockSize = 64;
+	fixed lengths[blockSize];
+	for (size_t start = 0; start < vecs.size(); start += blockSize)
+	{
+		size_t count = std::min(blockSize, vecs.size() - start);
+		MagnitudeBatch(vecs.subspan(start, count), std::span<fixed>(lengths, count));
+		for (size_t i = 0; i < count; ++i)
+		{
+			const Vector2fx& vec = vecs[start + i];
+			out[start + i] = Mathfx::ApproxZero(lengths[i]) ? Zero : vec / lengths[i];
+		}
+	}
+}
+
+void Vector2fx::DistanceToPointBatch(const Vector2fx& point, std::span<const Vector2fx> vecs, std::span<fixed> out)
+{
+	FXMATH_ASSERT(vecs.size() == out.size() && "Input and output spans must be the same length.");
+
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i px = Mathfx::simd::Splat4(point.x);
+	const __m256i py = Mathfx::simd::Splat4(point.y);
+	for (; i + 4 <= vecs.size(); i += 4)
+	{
+		__m256i vx, vy;
+		Mathfx::simd::LoadDeinterleaved4(&vecs[i].x, vx, vy);
+		__m256i dx = _mm256_sub_epi64(vx, px);
+		__m256i dy = _mm256_sub_epi64(vy, py);
+		__m256i sqrDistance = _mm256_add_epi64(Mathfx::simd::FastMul4(dx, dx), Mathfx::simd::FastMul4(dy, dy));
+		Mathfx::simd::Store4(&out[i], Mathfx::simd::Unshuffle4(Mathfx::simd::FastSqrt4(sqrDistance)));
+	}
+#endif
+	for (; i < vecs.size(); ++i)
+	{
+		out[i] = Distance(vecs[i], point);
+	}
+}
+
+void Vector2fx::DistanceSquaredToPointBatch(const Vector2fx& point, std::span<const Vector2fx> vecs, std::span<fixed> out)
+{
+	FXMATH_ASSERT(vecs.size() == out.size() && "Input and output spans must be the same length.");
+
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i px = Mathfx::simd::Splat4(point.x);
+	const __m256i py = Mathfx::simd::Splat4(point.y);
+	for (; i + 4 <= vecs.size(); i += 4)
+	{
+		__m256i vx, vy;
+		Mathfx::simd::LoadDeinterleaved4(&vecs[i].x, vx, vy);
+		__m256i dx = _mm256_sub_epi64(vx, px);
+		__m256i dy = _mm256_sub_epi64(vy, py);
+		__m256i sqrDistance = _mm256_add_epi64(Mathfx::simd::FastMul4(dx, dx), Mathfx::simd::FastMul4(dy, dy));
+		Mathfx::simd::Store4(&out[i], Mathfx::simd::Unshuffle4(sqrDistance));
+	}
+#endif
+	for (; i < vecs.size(); ++i)
+	{
+		out[i] = DistanceSquared(vecs[i], point);
+	}
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+#include "fixedsimd.h"
+#include "vector2fx.h"
+
+/**
+ * \brief Reference to one element of a Vector2fxSoA, reads and writes go straight to the x and y arrays without copying.
+ */
+struct Vector2fxRef
+{
+	using fixed = fixed64;
+
+	fixed& x;
+	fixed& y;
+
+	operator Vector2fx() const { return Vector2fx(x, y); }
+
+	Vector2fxRef& operator=(const Vector2fx& other)
+	{
+		x = other.x;
+		y = other.y;
+		return *this;
+	}
+
+	Vector2fxRef& operator=(const Vector2fxRef& other)
+	{
+		x = other.x;
+		y = other.y;
+		return *this;
+	}
+
+	Vector2fxRef& operator+=(const Vector2fx& other)
+	{
+		x += other.x;
+		y += other.y;
+		return *this;
+	}
+
+	Vector2fxRef& operator-=(const Vector2fx& other)
+	{
+		x -= other.x;
+		y -= other.y;
+		return *this;
+	}
+
+	Vector2fxRef& operator*=(fixed other)
+	{
+		x *= other;
+		y *= other;
+		return *this;
+	}
+};
+
+/**
+ * \brief Structure of arrays container of Vector2fx, x and y live in separate 64 byte aligned arrays.
+ * Every kernel produces exactly the same values as running the matching Vector2fx operation on each element,
+ * the AVX2 paths (when compiled with AVX2 enabled) just do four elements at a time.
+ */
+struct Vector2fxSoA
+{
+	using fixed = fixed64;
+	using array = std::vector<fixed, AlignedAllocator<fixed>>;
+
+	array x;
+	array y;
+
+	// constructors
+	Vector2fxSoA() = default;
+	explicit Vector2fxSoA(size_t count) : x(count), y(count) {}
+	explicit Vector2fxSoA(std::span<const Vector2fx> vecs) { FromAoS(vecs); }
+
+	size_t Size() const { return x.size(); }
+	bool Empty() const { return x.empty(); }
+
+	void Resize(size_t count)
+	{
+		x.resize(count);
+		y.resize(count);
+	}
+
+	void Reserve(size_t count)
+	{
+		x.reserve(count);
+		y.reserve(count);
+	}
+
+	void Clear()
+	{
+		x.clear();
+		y.clear();
+	}
+
+	void PushBack(const Vector2fx& vec)
+	{
+		x.push_back(vec.x);
+		y.push_back(vec.y);
+	}
+
+	Vector2fxRef operator[](size_t index) { return Vector2fxRef { x[index], y[index] }; }
+	Vector2fx operator[](size_t index) const { return Vector2fx(x[index], y[index]); }
+
+	// conversion
+	void FromAoS(std::span<const Vector2fx> vecs);
+	void ToAoS(std::span<Vector2fx> out) const;
+	std::vector<Vector2fx> ToAoS() const;
+
+	// element-wise kernels, each matches the Vector2fx operator applied to every element
+	void Add(const Vector2fxSoA& other);
+	void Add(const Vector2fx& vec);
+	void Sub(const Vector2fxSoA& other);
+	void Scale(fixed scalar);
+	void MulAdd(const Vector2fxSoA& vecs, fixed scalar);
+	void Normalize();
+	void DistanceSquared(const Vector2fx& point, std::span<fixed> out) const;
+	void Dot(const Vector2fxSoA& other, std::span<fixed> out) const;
+	void Dot(const Vector2fx& vec, std::span<fixed> out) const;
+
+private:
+	// Same steps as Vector2fx::Normalize once the length is known, so results match exactly
+	void NormalizeElement(size_t index, fixed length)
+	{
+		if (Mathfx::ApproxZero(length))
+		{
+			x[index] = fixed::Zero;
+			y[index] = fixed::Zero;
+		}
+		else
+		{
+			x[index] /= length;
+			y[index] /= length;
+		}
+	}
+};
+
+void Vector2fxSoA::FromAoS(std::span<const Vector2fx> vecs)
+{
+	Resize(vecs.size());
+	for (size_t i = 0; i < vecs.size(); ++i)
+	{
+		x[i] = vecs[i].x;
+		y[i] = vecs[i].y;
+	}
+}
+
+void Vector2fxSoA::ToAoS(std::span<Vector2fx> out) const
+{
+	FXMATH_ASSERT(out.size() == Size() && "Output span must be the same length as the container.");
+	for (size_t i = 0; i < out.size(); ++i)
+	{
+		out[i] = Vector2fx(x[i], y[i]);
+	}
+}
+
+std::vector<Vector2fx> Vector2fxSoA::ToAoS() const
+{
+	std::vector<Vector2fx> result(Size());
+	ToAoS(result);
+	return result;
+}
+
+void Vector2fxSoA::Add(const Vector2fxSoA& other)
+{
+	FXMATH_ASSERT(other.Size() == Size() && "Containers must be the same length.");
+
+	// Plain wrapping integer adds, simple enough that the compiler vectorizes these without help
+	const size_t count = Size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		x[i] += other.x[i];
+		y[i] += other.y[i];
+	}
+}
+
+void Vector2fxSoA::Add(const Vector2fx& vec)
+{
+	const size_t count = Size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		x[i] += vec.x;
+		y[i] += vec.y;
+	}
+}
+
+void Vector2fxSoA::Sub(const Vector2fxSoA& other)
+{
+	FXMATH_ASSERT(other.Size() == Size() && "Containers must be the same length.");
+
+	const size_t count = Size();
+	for (size_t i = 0; i < count; ++i)
+	{
+		x[i] -= other.x[i];
+		y[i] -= other.y[i];
+	}
+}
+
+void Vector2fxSoA::Scale(fixed scalar)
+{
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i s = Mathfx::simd::Splat4(scalar);
+	for (; i + 4 <= count; i += 4)
+	{
+		Mathfx::simd::Store4(&x[i], Mathfx::simd::FastMul4(Mathfx::simd::Load4(&x[i]), s));
+		Mathfx::simd::Store4(&y[i], Mathfx::simd::FastMul4(Mathfx::simd::Load4(&y[i]), s));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		x[i] *= scalar;
+		y[i] *= scalar;
+	}
+}
+
+void Vector2fxSoA::MulAdd(const Vector2fxSoA& vecs, fixed scalar)
+{
+	FXMATH_ASSERT(vecs.Size() == Size() && "Containers must be the same length.");
+
+	// this += vecs * scalar, e.g. position += velocity * dt
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i s = Mathfx::simd::Splat4(scalar);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i dx = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&vecs.x[i]), s);
+		__m256i dy = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&vecs.y[i]), s);
+		Mathfx::simd::Store4(&x[i], _mm256_add_epi64(Mathfx::simd::Load4(&x[i]), dx));
+		Mathfx::simd::Store4(&y[i], _mm256_add_epi64(Mathfx::simd::Load4(&y[i]), dy));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		x[i] += vecs.x[i] * scalar;
+		y[i] += vecs.y[i] * scalar;
+	}
+}
+
+void Vector2fxSoA::Normalize()
+{
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	alignas(32) fixed lengths[4];
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i vx = Mathfx::simd::Load4(&x[i]);
+		__m256i vy = Mathfx::simd::Load4(&y[i]);
+		__m256i sqrMagnitude = _mm256_add_epi64(Mathfx::simd::FastMul4(vx, vx), Mathfx::simd::FastMul4(vy, vy));
+		Mathfx::simd::Store4(lengths, Mathfx::simd::FastSqrt4(sqrMagnitude));
+		for (size_t lane = 0; lane < 4; ++lane)
+		{
+			NormalizeElement(i + lane, lengths[lane]);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		NormalizeElement(i, Mathfx::FastSqrt(x[i] * x[i] + y[i] * y[i]));
+	}
+}
+
+void Vector2fxSoA::DistanceSquared(const Vector2fx& point, std::span<fixed> out) const
+{
+	FXMATH_ASSERT(out.size() == Size() && "Output span must be the same length as the container.");
+
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i px = Mathfx::simd::Splat4(point.x);
+	const __m256i py = Mathfx::simd::Splat4(point.y);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i dx = _mm256_sub_epi64(Mathfx::simd::Load4(&x[i]), px);
+		__m256i dy = _mm256_sub_epi64(Mathfx::simd::Load4(&y[i]), py);
+		__m256i sum = _mm256_add_epi64(Mathfx::simd::FastMul4(dx, dx), Mathfx::simd::FastMul4(dy, dy));
+		Mathfx::simd::Store4(&out[i], sum);
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		fixed dx = x[i] - point.x;
+		fixed dy = y[i] - point.y;
+		out[i] = dx * dx + dy * dy;
+	}
+}
+
+void Vector2fxSoA::Dot(const Vector2fxSoA& other, std::span<fixed> out) const
+{
+	FXMATH_ASSERT(other.Size() == Size() && out.size() == Size() && "Containers and output span must be the same length.");
+
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i xx = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&x[i]), Mathfx::simd::Load4(&other.x[i]));
+		__m256i yy = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&y[i]), Mathfx::simd::Load4(&other.y[i]));
+		Mathfx::simd::Store4(&out[i], _mm256_add_epi64(xx, yy));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = x[i] * other.x[i] + y[i] * other.y[i];
+	}
+}
+
+void Vector2fxSoA::Dot(const Vector2fx& vec, std::span<fixed> out) const
+{
+	FXMATH_ASSERT(out.size() == Size() && "Output span must be the same length as the container.");
+
+	const size_t count = Size();
+	size_t i = 0;
+#if FXMATH_AVX2
+	const __m256i vx = Mathfx::simd::Splat4(vec.x);
+	const __m256i vy = Mathfx::simd::Splat4(vec.y);
+	for (; i + 4 <= count; i += 4)
+	{
+		__m256i xx = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&x[i]), vx);
+		__m256i yy = Mathfx::simd::FastMul4(Mathfx::simd::Load4(&y[i]), vy);
+		Mathfx::simd::Store4(&out[i], _mm256_add_epi64(xx, yy));
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		out[i] = x[i] * vec.x + y[i] * vec.y;
+	}
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "fixedtype.h"
+#include "fixedmath.h"
+
+struct Vector3fx
+{
+	using fixed = fixed64;
+
+	fixed x = fixed::Zero;
+	fixed y = fixed::Zero;
+	fixed z = fixed::Zero;
+
+	static_assert(std::is_trivially_copyable_v<fixed>);
+
+	static const Vector3fx Zero;
+	static const Vector3fx One;
+	static const Vector3fx Right;
+	static const Vector3fx Left;
+	static const Vector3fx Up;
+	static const Vector3fx Down;
+	static const Vector3fx Forward;
+	static const Vector3fx Back;
+
+	// constructors
+	constexpr Vector3fx() : x(fixed::Zero), y(fixed::Zero), z(fixed::Zero) {}
+	constexpr Vector3fx(fixed x, fixed y, fixed z) : x(x), y(y), z(z) {}
+	constexpr Vector3fx(const Vector3fx& other) = default;
+	constexpr Vector3fx(Vector3fx&& other) noexcept = default;
+	~Vector3fx() = default;
+
+	Vector3fx& operator=(const Vector3fx& other) = default;
+	Vector3fx& operator=(Vector3fx&& other) noexcept = default;
+
+	// compound-assignment operators
+	Vector3fx& operator+=(const Vector3fx& other)
+	{
+		this->x += other.x;
+		this->y += other.y;
+		this->z += other.z;
+		return *this;
+	}
+
+	Vector3fx& operator-=(const Vector3fx& other)
+	{
+		this->x -= other.x;
+		this->y -= other.y;
+		this->z -= other.z;
+		return *this;
+	}
+
+	Vector3fx& operator*=(const Vector3fx& other)
+	{
+		this->x *= other.x;
+		this->y *= other.y;
+		this->z *= other.z;
+		return *this;
+	}
+
+	Vector3fx& operator*=(fixed other)
+	{
+		this->x *= other;
+		this->y *= other;
+		this->z *= other;
+		return *this;
+	}
+
+	Vector3fx& operator/=(fixed other)
+	{
+		this->x /= other;
+		this->y /= other;
+		this->z /= other;
+		return *this;
+	}
+
+	fixed& operator[](int index)
+	{
+		return (index == 0) ? x : (index == 1 ? y : z);
+	}
+
+	fixed operator[](int index) const
+	{
+		return (index == 0) ? x : (index == 1 ? y : z);
+	}
+
+	// static methods
+	static fixed Dot(const Vector3fx& a, const Vector3fx& b);
+	static Vector3fx Cross(const Vector3fx& a, const Vector3fx& b);
+	static Vector3fx Normalize(const Vector3fx& vec);
+	static fixed Distance(const Vector3fx& a, const Vector3fx& b);
+	static fixed DistanceSquared(const Vector3fx& a, const Vector3fx& b);
+	static bool ApproxEqual(const Vector3fx& a, const Vector3fx& b, int ignoreBits = fixed::EpsilonBits);
+
+	// instance methods
+	fixed Magnitude() const
+	{
+		// Same caveat as Vector2fx::Magnitude, FastSqrt loses accuracy once the squared length goes above ~1e9
+		return Mathfx::FastSqrt(x * x + y * y + z * z);
+	}
+
+	fixed SqrMagnitude() const
+	{
+		return x * x + y * y + z * z;
+	}
+
+	Vector3fx Normalized() const
+	{
+		return Normalize(*this);
+	}
+};
+
+constexpr Vector3fx Vector3fx::Zero(fixed::Zero, fixed::Zero, fixed::Zero);
+constexpr Vector3fx Vector3fx::One(fixed::One, fixed::One, fixed::One);
+constexpr Vector3fx Vector3fx::Right(fixed::One, fixed::Zero, fixed::Zero);
+constexpr Vector3fx Vector3fx::Left(fixed::NegOne, fixed::Zero, fixed::Zero);
+constexpr Vector3fx Vector3fx::Up(fixed::Zero, fixed::One, fixed::Zero);
+constexpr Vector3fx Vector3fx::Down(fixed::Zero, fixed::NegOne, fixed::Zero);
+constexpr Vector3fx Vector3fx::Forward(fixed::Zero, fixed::Zero, fixed::One);
+constexpr Vector3fx Vector3fx::Back(fixed::Zero, fixed::Zero, fixed::NegOne);
+
+inline Vector3fx operator+(Vector3fx a, const Vector3fx& b) { return a += b; }
+inline Vector3fx operator-(Vector3fx a, const Vector3fx& b) { return a -= b; }
+inline Vector3fx operator-(const Vector3fx& a) { return Vector3fx(-a.x, -a.y, -a.z); }
+inline Vector3fx operator*(Vector3fx a, const Vector3fx& b) { return a *= b; }
+inline Vector3fx operator*(Vector3fx a, fixed b) { return a *= b; }
+inline Vector3fx operator*(fixed a, Vector3fx b) { return b *= a; }
+inline Vector3fx operator/(Vector3fx a, fixed b) { return a /= b; }
+inline bool operator==(const Vector3fx& a, const Vector3fx& b) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+inline bool operator!=(const Vector3fx& a, const Vector3fx& b) { return !(a == b); }
+
+fixed Vector3fx::Dot(const Vector3fx& a, const Vector3fx& b)
+{
+	return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+Vector3fx Vector3fx::Cross(const Vector3fx& a, const Vector3fx& b)
+{
+	return Vector3fx(
+		a.y * b.z - a.z * b.y,
+		a.z * b.x - a.x * b.z,
+		a.x * b.y - a.y * b.x);
+}
+
+Vector3fx Vector3fx::Normalize(const Vector3fx& vec)
+{
+	fixed length = vec.Magnitude();
+
+	if (Mathfx::ApproxZero(length))
+	{
+		return Zero;
+	}
+	return vec / length;
+}
+
+fixed Vector3fx::Distance(const Vector3fx& a, const Vector3fx& b)
+{
+	return (a - b).Magnitude();
+}
+
+fixed Vector3fx::DistanceSquared(const Vector3fx& a, const Vector3fx& b)
+{
+	return (a - b).SqrMagnitude();
+}
+
+bool Vector3fx::ApproxEqual(const Vector3fx& a, const Vector3fx& b, int ignoreBits)
+{
+	return Mathfx::ApproxEqual(a.x, b.x, ignoreBits)
+		&& Mathfx::ApproxEqual(a.y, b.y, ignoreBits)
+		&& Mathfx::ApproxEqual(a.z, b.z, ignoreBits);
+}
@@ -1,5 +1,5 @@
 workspace "fxm"
-    configurations { "Debug", "Release" }
+    configurations { "Debug", "Release", "AVX2", "NoSimd" }
     platforms { "x64" }
     location "."
 
@@ -20,6 +20,14 @@ project "fxm_tests"
 		symbols "On"
 		defines { "_DEBUG" }
 		
-	filter "configurations:Release"
+	filter "configurations:Release or AVX2 or NoSimd"
 		optimize "Full"
 		defines { "_NDEBUG" }
+
+	-- Builds the AVX2 kernels, run the tests here and in NoSimd to check they match the scalar paths bit for bit
+	filter "configurations:AVX2 or NoSimd"
+		vectorextensions "AVX2"
+
+	-- Same flags as AVX2 but every kernel takes its scalar fallback
+	filter "configurations:NoSimd"
+		defines { "FXMATH_NO_SIMD" }
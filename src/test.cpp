@@ -641,6 +641,29 @@ TEST_CASE("Math Functions", "[fixedmath]")
 		}
 	}
 
+	SECTION("InvSqrt")
+	{
+		REQUIRE(Mathfx::InvSqrt(1_fx64) == 1_fx64);
+		REQUIRE(Mathfx::InvSqrt(4_fx64) == 0.5_fx64);
+		REQUIRE(Mathfx::InvSqrt(16_fx64) == 0.25_fx64);
+		REQUIRE(Mathfx::InvSqrt(0.25_fx64) == 2_fx64);
+
+		for (auto raw : testCases)
+		{
+			// Tiny inputs run out of fractional bits in x * y, those are covered by the exact powers of two above
+			if (raw < 0x10000)
+			{
+				continue;
+			}
+
+			fixed64 e = fixed64(raw);
+			double d = static_cast<double>(e);
+			double expected = 1.0 / std::sqrt(d);
+			CAPTURE(raw, d, expected);
+			CHECK(static_cast<double>(Mathfx::InvSqrt(e)) == Approx(expected).epsilon(0.00001));
+		}
+	}
+
 	SECTION("Log2")
 	{
 		constexpr double tolerance = 0.0000001;
@@ -1155,109 +1178,4431 @@ TEST_CASE("Benchmarks", "[fixedmath]")
 		};
 	}
 
-	SECTION("Trigonometry")
+	SECTION("Quaternionfx")
 	{
-		BENCHMARK_ADVANCED("Sin")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::Sin(v[i]); });
+		constexpr size_t kBatchSize = 1024;
+		std::vector<Vector3fx> in(kBatchSize);
+		std::ranges::generate(in, []() { return Vector3fx(random_fixed(), random_fixed(), random_fixed()); });
+		std::vector<Vector3fx> out(kBatchSize);
+		Quaternionfx q = Quaternionfx::AxisAngle(Vector3fx(1_fx, 2_fx, 3_fx).Normalized(), 37_fx);
+
+		BENCHMARK("Quaternionfx::Rotate x1024") {
+			for (size_t i = 0; i < kBatchSize; ++i)
+			{
+				out[i] = Quaternionfx::Rotate(q, in[i]);
+			}
+			return out[0];
 		};
 
-		BENCHMARK_ADVANCED("FastSin")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::FastSin(v[i]); });
+		BENCHMARK("Quaternionfx::RotateBatch x1024") {
+			Quaternionfx::RotateBatch(q, in, out);
+			return out[0];
 		};
+	}
 
-		BENCHMARK_ADVANCED("std::sinf")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
-			meter.measure([&v](int i) { return std::sinf(v[i]); });
+	SECTION("Affine2fx")
+	{
+		constexpr size_t kBatchSize = 1024;
+		std::vector<Vector2fx> in(kBatchSize);
+		std::ranges::generate(in, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> out(kBatchSize);
+		fixed64 radians = random_fixed(fixed64::Pi);
+		Vector2fx translation(random_fixed(), random_fixed());
+
+		BENCHMARK("Vector2fx::RotateByRadians + translate x1024") {
+			for (size_t i = 0; i < kBatchSize; ++i)
+			{
+				out[i] = Vector2fx::RotateByRadians(in[i], radians) + translation;
+			}
+			return out[0];
 		};
 
-		BENCHMARK_ADVANCED("Cos")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::Cos(v[i]); });
+		BENCHMARK("Affine2fx::TransformPoints x1024") {
+			Affine2fx transform = Affine2fx::FromTranslationRotationScale(translation, radians, Vector2fx::One);
+			Affine2fx::TransformPoints(transform, in, out);
+			return out[0];
 		};
+	}
 
-		BENCHMARK_ADVANCED("FastCos")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::FastCos(v[i]); });
+	SECTION("Rotation2fx")
+	{
+		constexpr size_t kBatchSize = 1024;
+		std::vector<Vector2fx> in(kBatchSize);
+		std::ranges::generate(in, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> out(kBatchSize);
+		fixed64 degrees = random_fixed(360_fx64);
+
+		BENCHMARK("Vector2fx::Rotate x1024") {
+			for (size_t i = 0; i < kBatchSize; ++i)
+			{
+				out[i] = Vector2fx::Rotate(in[i], degrees);
+			}
+			return out[0];
 		};
 
-		BENCHMARK_ADVANCED("std::cosf")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
-			meter.measure([&v](int i) { return std::cosf(v[i]); });
+		BENCHMARK("Rotation2fx::RotateBatch x1024") {
+			Rotation2fx::RotateBatch(Rotation2fx::FromDegrees(degrees), in, out);
+			return out[0];
 		};
+	}
 
-		BENCHMARK_ADVANCED("Tan")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::Tan(v[i]); });
+	SECTION("Vector2fx Batch")
+	{
+		constexpr size_t kCount = 4096;
+		std::vector<Vector2fx> vecs(kCount);
+		std::ranges::generate(vecs, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> normalized(kCount);
+		std::vector<fixed64> distances(kCount);
+		Vector2fx point(random_fixed(), random_fixed());
+
+		BENCHMARK("Vector2fx::Distance x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				distances[i] = Vector2fx::Distance(vecs[i], point);
+			}
+			return distances[0];
 		};
 
-		BENCHMARK_ADVANCED("std::tanf")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
-			meter.measure([&v](int i) { return std::tanf(v[i]); });
+		BENCHMARK("Vector2fx::DistanceToPointBatch x4096") {
+			Vector2fx::DistanceToPointBatch(point, vecs, distances);
+			return distances[0];
 		};
 
-		BENCHMARK_ADVANCED("Acos")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::Acos(v[i]); });
+		BENCHMARK("Vector2fx::Normalize x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				normalized[i] = Vector2fx::Normalize(vecs[i]);
+			}
+			return normalized[0];
 		};
 
-		BENCHMARK_ADVANCED("std::acosf")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const float& x) { return random_snorm_float(); });
-			meter.measure([&v](int i) { return std::acosf(v[i]); });
+		BENCHMARK("Vector2fx::NormalizeBatch x4096") {
+			Vector2fx::NormalizeBatch(vecs, normalized);
+			return normalized[0];
 		};
+	}
 
-		BENCHMARK_ADVANCED("Atan")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
-			meter.measure([&v](int i) { return Mathfx::Atan(v[i]); });
+	SECTION("Vector2fxSoA")
+	{
+		constexpr size_t kCount = 4096;
+		std::vector<Vector2fx> positions(kCount);
+		std::vector<Vector2fx> velocities(kCount);
+		std::ranges::generate(positions, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::ranges::generate(velocities, []() { return Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)); });
+		Vector2fxSoA soaPositions(positions);
+		Vector2fxSoA soaVelocities(velocities);
+		std::vector<fixed64> distances(kCount);
+		fixed64 dt = 1_fx64 / 60_fx64;
+		Vector2fx point(random_fixed(), random_fixed());
+
+		BENCHMARK("AoS position += velocity * dt x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				positions[i] += velocities[i] * dt;
+			}
+			return positions[0];
 		};
 
-		BENCHMARK_ADVANCED("std::atanf")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> v(meter.runs());
-			std::ranges::transform(v, v.begin(), [](const float& x) { return random_snorm_float(); });
-			meter.measure([&v](int i) { return std::atanf(v[i]); });
+		BENCHMARK("Vector2fxSoA::MulAdd x4096") {
+			soaPositions.MulAdd(soaVelocities, dt);
+			return soaPositions.x[0];
 		};
 
-		BENCHMARK_ADVANCED("Atan2")(Catch::Benchmark::Chronometer meter) {
-			std::vector<fixed64> vx(meter.runs());
-			std::vector<fixed64> vy(meter.runs());
-			std::ranges::transform(vx, vx.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
-			std::ranges::transform(vy, vy.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
-			meter.measure([&vx, &vy](int i) { return Mathfx::Atan2(vy[i], vx[i]); });
+		BENCHMARK("AoS Vector2fx::DistanceSquared x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				distances[i] = Vector2fx::DistanceSquared(positions[i], point);
+			}
+			return distances[0];
 		};
 
-		BENCHMARK_ADVANCED("std::atan2f")(Catch::Benchmark::Chronometer meter) {
-			std::vector<float> vx(meter.runs());
-			std::vector<float> vy(meter.runs());
-			std::ranges::transform(vx, vx.begin(), [](const float& x) { return random_snorm_float(); });
-			std::ranges::transform(vy, vy.begin(), [](const float& x) { return random_snorm_float(); });
-			meter.measure([&vx, &vy](int i) { return std::atan2f(vy[i], vx[i]); });
+		BENCHMARK("Vector2fxSoA::DistanceSquared x4096") {
+			soaPositions.DistanceSquared(point, distances);
+			return distances[0];
 		};
 	}
-}
 
-#endif
+	SECTION("Shapes")
+	{
+		constexpr size_t kCount = 4096;
+		std::vector<Aabb2fx> boxes(kCount);
+		std::vector<Circle2fx> circles(kCount);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			Vector2fx center(random_fixed(), random_fixed());
+			boxes[i] = Aabb2fx::FromCenterExtents(center, Vector2fx(random_pos_fixed(20_fx64), random_pos_fixed(20_fx64)));
+			circles[i] = Circle2fx(center, random_pos_fixed(20_fx64));
+		}
+		Aabb2fx box = Aabb2fx::FromCenterExtents(Vector2fx::Zero, Vector2fx(300_fx64, 300_fx64));
+		Circle2fx circle(Vector2fx::Zero, 300_fx64);
+		std::vector<uint64_t> mask(Mathfx::BitmaskWordCount(kCount));
 
-TEST_CASE("Vector2fx", "[fixedmath]")
-{
-	Vector2fx v0 = Vector2fx::Zero;
-	Vector2fx v1 = Vector2fx::Right;
-	REQUIRE(Vector2fx::Zero + Vector2fx::Right == Vector2fx::Right);
-	REQUIRE(Vector2fx::Zero + Vector2fx::Left == Vector2fx::Left);
-	REQUIRE(Vector2fx::Zero + Vector2fx::Up == Vector2fx::Up);
-	REQUIRE(Vector2fx::Zero + Vector2fx::Down == Vector2fx::Down);
-	REQUIRE(Vector2fx::Zero + Vector2fx::One == Vector2fx::One);
+		BENCHMARK("Aabb2fx::Overlaps x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				if (Aabb2fx::Overlaps(box, boxes[i]))
+				{
+					mask[i >> 6] |= static_cast<uint64_t>(1) << (i & 63);
+				}
+			}
+			return mask[0];
+		};
+
+		BENCHMARK("Aabb2fx::OverlapsBatch x4096") {
+			Aabb2fx::OverlapsBatch(box, boxes, mask);
+			return mask[0];
+		};
+
+		BENCHMARK("Circle2fx::Overlaps x4096") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				if (Circle2fx::Overlaps(circle, circles[i]))
+				{
+					mask[i >> 6] |= static_cast<uint64_t>(1) << (i & 63);
+				}
+			}
+			return mask[0];
+		};
+
+		BENCHMARK("Circle2fx::OverlapsBatch x4096") {
+			Circle2fx::OverlapsBatch(circle, circles, mask);
+			return mask[0];
+		};
+
+		BENCHMARK("Circle2fx::OverlapsBatch boxes x4096") {
+			Circle2fx::OverlapsBatch(circle, std::span<const Aabb2fx>(boxes), mask);
+			return mask[0];
+		};
+	}
+
+	SECTION("SpatialGrid2fx")
+	{
+		constexpr size_t kCount = 16384;
+		std::vector<Vector2fx> positions(kCount);
+		std::ranges::generate(positions, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> centers(64);
+		std::ranges::generate(centers, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		fixed64 radius = 20_fx64;
+		SpatialGrid2fx grid(16_fx64);
+		grid.Rebuild(positions);
+		std::vector<uint32_t> result;
+
+		BENCHMARK("Brute force radius query x64") {
+			result.clear();
+			for (const Vector2fx& center : centers)
+			{
+				for (uint32_t i = 0; i < kCount; ++i)
+				{
+					if (Vector2fx::DistanceSquared(positions[i], center) <= radius * radius)
+					{
+						result.push_back(i);
+					}
+				}
+			}
+			return result.size();
+		};
+
+		BENCHMARK("SpatialGrid2fx::QueryRadius x64") {
+			result.clear();
+			for (const Vector2fx& center : centers)
+			{
+				grid.QueryRadius(center, radius, result);
+			}
+			return result.size();
+		};
+
+		BENCHMARK("SpatialGrid2fx::Rebuild x16384") {
+			grid.Rebuild(positions);
+			return grid.Size();
+		};
+	}
+
+	SECTION("AabbTree2fx")
+	{
+		constexpr size_t kCount = 2048;
+		std::vector<Aabb2fx> boxes(kCount);
+		std::ranges::generate(boxes, []() {
+			return Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(), random_fixed()), Vector2fx(random_pos_fixed(8_fx64), random_pos_fixed(8_fx64)));
+		});
+		AabbTree2fx tree;
+		std::vector<int32_t> proxies;
+		for (uint32_t i = 0; i < kCount; ++i)
+		{
+			proxies.push_back(tree.Insert(boxes[i], i));
+		}
+		std::vector<std::pair<int32_t, int32_t>> pairs;
+
+		BENCHMARK("Brute force overlap pairs x2048") {
+			pairs.clear();
+			for (size_t a = 0; a < kCount; ++a)
+			{
+				for (size_t b = a + 1; b < kCount; ++b)
+				{
+					if (Aabb2fx::Overlaps(boxes[a], boxes[b]))
+					{
+						pairs.emplace_back(static_cast<int32_t>(a), static_cast<int32_t>(b));
+					}
+				}
+			}
+			return pairs.size();
+		};
+
+		BENCHMARK("AabbTree2fx::OverlapPairs x2048") {
+			pairs.clear();
+			tree.OverlapPairs(pairs);
+			return pairs.size();
+		};
+
+		BENCHMARK("AabbTree2fx::Move x2048") {
+			size_t moved = 0;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				Vector2fx step(random_fixed(0.25_fx64), random_fixed(0.25_fx64));
+				boxes[i] = Aabb2fx(boxes[i].min + step, boxes[i].max + step);
+				moved += tree.Move(proxies[i], boxes[i], step) ? 1 : 0;
+			}
+			return moved;
+		};
+	}
+
+	SECTION("RadixSort")
+	{
+		constexpr size_t kCount = 65536;
+		std::vector<fixed64> source(kCount);
+		std::ranges::generate(source, []() { return random_fixed(); });
+		std::vector<fixed64> values(kCount);
+		std::vector<fixed64> scratch(kCount);
+
+		BENCHMARK("std::sort x65536") {
+			values = source;
+			std::sort(values.begin(), values.end());
+			return values[0];
+		};
+
+		BENCHMARK("Mathfx::RadixSort x65536") {
+			values = source;
+			Mathfx::RadixSort(std::span(values), std::span(scratch));
+			return values[0];
+		};
+
+		constexpr size_t kBoxes = 4096;
+		std::vector<Aabb2fx> boxes(kBoxes);
+		std::ranges::generate(boxes, []() {
+			return Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(), random_fixed()), Vector2fx(random_pos_fixed(8_fx64), random_pos_fixed(8_fx64)));
+		});
+		SweepAndPrune2fx sap;
+		sap.Update(boxes);
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+
+		BENCHMARK("SweepAndPrune2fx tick x4096") {
+			for (Aabb2fx& box : boxes)
+			{
+				Vector2fx step(random_fixed(0.5_fx64), random_fixed(0.5_fx64));
+				box = Aabb2fx(box.min + step, box.max + step);
+			}
+			sap.Update(boxes);
+			pairs.clear();
+			sap.FindPairs(pairs);
+			return pairs.size();
+		};
+	}
+
+	SECTION("Parallel Reductions")
+	{
+		constexpr size_t kCount = 1 << 20;
+		std::vector<fixed64> a(kCount);
+		std::vector<fixed64> b(kCount);
+		std::ranges::generate(a, []() { return random_fixed(); });
+		std::ranges::generate(b, []() { return random_fixed(); });
+
+		BENCHMARK("Serial FixedAccumulator dot x1M") {
+			FixedAccumulator<int64_t, 32> sum;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				sum.MulAdd(a[i], b[i]);
+			}
+			return sum.SaturatedResult();
+		};
+
+		BENCHMARK("Mathfx::ParallelDot x1M") {
+			return Mathfx::ParallelDot(std::span(a), std::span(b));
+		};
+
+		BENCHMARK("Mathfx::ParallelSum x1M") {
+			return Mathfx::ParallelSum(std::span(a));
+		};
+	}
+
+	SECTION("Parallel Transform")
+	{
+		constexpr size_t kCount = 1 << 16;
+		std::vector<fixed64> values(kCount);
+		std::ranges::generate(values, []() { return random_fixed(); });
+		std::vector<fixed64> out(kCount);
+
+		BENCHMARK("Serial Sin x64k") {
+			Mathfx::SinBatch<int64_t, 32>(values, out);
+			return out[0];
+		};
+
+		// Same work on pools of 1 to 64 threads, the results are identical for all of them
+		for (size_t threads = 1; threads <= 64; threads *= 2)
+		{
+			Mathfx::ThreadPool pool(threads);
+			BENCHMARK("ParallelBatch Sin x64k, " + std::to_string(threads) + " threads") {
+				Mathfx::ParallelBatch(std::span(values), std::span(out), [](auto in, auto result) { Mathfx::SinBatch<int64_t, 32>(in, result); }, pool);
+				return out[0];
+			};
+		}
+	}
+
+	SECTION("Integrator2fx")
+	{
+		const fixed64 dt = fixed64::One / 60_fx64;
+		for (size_t count : { 10000, 100000, 1000000 })
+		{
+			Vector2fxSoA positions(count);
+			Vector2fxSoA velocities(count);
+			Vector2fxSoA accelerations(count);
+			std::vector<fixed64> factors(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				positions[i] = Vector2fx(random_fixed(), random_fixed());
+				velocities[i] = Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64));
+				accelerations[i] = Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64));
+				factors[i] = Mathfx::Exp(-(random_pos_fixed(fixed64::One) * dt));
+			}
+			Vector2fxSoA previous = positions;
+
+			BENCHMARK("SemiImplicitEuler x" + std::to_string(count)) {
+				Integrator2fx::SemiImplicitEuler(positions, velocities, accelerations, dt);
+				return positions.x[0];
+			};
+			BENCHMARK("SemiImplicitEuler damped x" + std::to_string(count)) {
+				Integrator2fx::SemiImplicitEuler(positions, velocities, accelerations, dt, factors);
+				return positions.x[0];
+			};
+			BENCHMARK("Verlet damped x" + std::to_string(count)) {
+				Integrator2fx::Verlet(positions, previous, accelerations, dt, factors);
+				return positions.x[0];
+			};
+		}
+	}
+
+	SECTION("Collision2fx")
+	{
+		constexpr size_t kCount = 1024;
+		std::vector<Polygon2fx> polygons(kCount);
+		std::vector<Circle2fx> circles(kCount);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			polygons[i] = Polygon2fx::Transform(Polygon2fx::Box(Vector2fx(random_pos_fixed(2_fx64) + 0.1_fx64, random_pos_fixed(2_fx64) + 0.1_fx64)),
+				Rotation2fx::FromRadians(random_fixed(fixed64::Pi)), Vector2fx(random_fixed(3_fx64), random_fixed(3_fx64)));
+			circles[i] = Circle2fx(Vector2fx(random_fixed(3_fx64), random_fixed(3_fx64)), random_pos_fixed(2_fx64) + 0.1_fx64);
+		}
+
+		BENCHMARK("Polygon vs polygon x1024") {
+			int hits = 0;
+			Manifold2fx manifold;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				hits += Collision2fx::Collide(polygons[i], polygons[(i + 1) & (kCount - 1)], manifold);
+			}
+			return hits;
+		};
+		BENCHMARK("Polygon vs circle x1024") {
+			int hits = 0;
+			Manifold2fx manifold;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				hits += Collision2fx::Collide(polygons[i], circles[i], manifold);
+			}
+			return hits;
+		};
+		BENCHMARK("Circle vs circle x1024") {
+			int hits = 0;
+			Manifold2fx manifold;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				hits += Collision2fx::Collide(circles[i], circles[(i + 1) & (kCount - 1)], manifold);
+			}
+			return hits;
+		};
+		BENCHMARK("Polygon transform x1024") {
+			Polygon2fx polygon;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				polygon = Polygon2fx::Transform(polygons[i], Rotation2fx::Identity, circles[i].center);
+			}
+			return polygon.count;
+		};
+	}
+
+	SECTION("Ray2fx")
+	{
+		constexpr size_t kCount = 1 << 14;
+		std::vector<Aabb2fx> boxes(kCount);
+		std::vector<Circle2fx> circles(kCount);
+		std::vector<Segment2fx> segments(kCount);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			boxes[i] = Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)), Vector2fx(random_pos_fixed(3_fx64), random_pos_fixed(3_fx64)));
+			circles[i] = Circle2fx(Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)), random_pos_fixed(3_fx64));
+			segments[i] = Segment2fx(Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)), Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)));
+		}
+		const Ray2fx ray(Vector2fx(-100_fx64, random_fixed(100_fx64)), Vector2fx(200_fx64, random_fixed(100_fx64)));
+		std::vector<fixed64> fractions(kCount);
+
+		BENCHMARK("Ray setup") {
+			return Ray2fx(Vector2fx(-100_fx64, random_fixed(100_fx64)), Vector2fx(200_fx64, 50_fx64)).Length();
+		};
+		BENCHMARK("Slab test with operator/ x16k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				fixed64 enter = fixed64::Zero;
+				fixed64 exit = fixed64::One;
+				for (int axis = 0; axis < 2; ++axis)
+				{
+					fixed64 near = (boxes[i].min[axis] - ray.Origin()[axis]) / ray.Direction()[axis];
+					fixed64 far = (boxes[i].max[axis] - ray.Origin()[axis]) / ray.Direction()[axis];
+					enter = std::max(enter, std::min(near, far));
+					exit = std::min(exit, std::max(near, far));
+				}
+				fractions[i] = enter <= exit ? enter : fixed64::MaxValue;
+			}
+			return fractions[0];
+		};
+		BENCHMARK("CastBatch boxes x16k") {
+			Ray2fx::CastBatch(ray, boxes, fractions);
+			return fractions[0];
+		};
+		BENCHMARK("CastBatch circles x16k") {
+			Ray2fx::CastBatch(ray, circles, fractions);
+			return fractions[0];
+		};
+		BENCHMARK("CastBatch segments x16k") {
+			Ray2fx::CastBatch(ray, segments, fractions);
+			return fractions[0];
+		};
+	}
+
+	SECTION("FFT")
+	{
+		// Textbook in place radix-2 float FFT with twiddles precomputed the same way, as a baseline
+		auto floatFft = [](std::vector<float>& re, std::vector<float>& im, const std::vector<float>& cosines, const std::vector<float>& sines) {
+			const size_t n = re.size();
+			for (size_t i = 1, j = 0; i < n; ++i)
+			{
+				size_t bit = n >> 1;
+				for (; j & bit; bit >>= 1)
+				{
+					j ^= bit;
+				}
+				j |= bit;
+				if (i < j)
+				{
+					std::swap(re[i], re[j]);
+					std::swap(im[i], im[j]);
+				}
+			}
+			for (size_t half = 1; half < n; half <<= 1)
+			{
+				const size_t stride = n / (2 * half);
+				for (size_t start = 0; start < n; start += 2 * half)
+				{
+					for (size_t k = 0; k < half; ++k)
+					{
+						const size_t a = start + k;
+						const size_t b = a + half;
+						const float productRe = re[b] * cosines[k * stride] - im[b] * sines[k * stride];
+						const float productIm = re[b] * sines[k * stride] + im[b] * cosines[k * stride];
+						re[b] = re[a] - productRe;
+						im[b] = im[a] - productIm;
+						re[a] += productRe;
+						im[a] += productIm;
+					}
+				}
+			}
+		};
+
+		for (size_t n : { 256, 4096, 65536 })
+		{
+			std::vector<float> re(n), im(n), cosines(n / 2), sines(n / 2);
+			std::ranges::generate(re, []() { return random_float(1.0f); });
+			std::ranges::generate(im, []() { return random_float(1.0f); });
+			for (size_t k = 0; k < n / 2; ++k)
+			{
+				cosines[k] = static_cast<float>(std::cos(-2.0 * 3.14159265358979323846 * k / n));
+				sines[k] = static_cast<float>(std::sin(-2.0 * 3.14159265358979323846 * k / n));
+			}
+			std::vector<Complexfx<int32_t, 16>> data32(n);
+			std::vector<Complexfx<int64_t, 32>> data64(n);
+			for (size_t i = 0; i < n; ++i)
+			{
+				data32[i] = Complexfx<int32_t, 16>(fixed32::Float(re[i]), fixed32::Float(im[i]));
+				data64[i] = Complexfx<int64_t, 32>(fixed64::Float(re[i]), fixed64::Float(im[i]));
+			}
+			const Fftfx<int32_t, 16> fft32(n);
+			const Fftfx<int64_t, 32> fft64(n);
+			const std::string size = std::to_string(n);
+
+			BENCHMARK("float FFT n=" + size) {
+				floatFft(re, im, cosines, sines);
+				return re[0];
+			};
+			BENCHMARK("Fftfx fixed32 n=" + size) {
+				return fft32.Forward(data32);
+			};
+			BENCHMARK("Fftfx fixed64 n=" + size) {
+				return fft64.Forward(data64);
+			};
+		}
+	}
+
+	SECTION("Filters")
+	{
+		constexpr size_t kCount = 1 << 16;
+		std::vector<fixed32> taps(64);
+		std::ranges::generate(taps, []() { return fixed32::Float(random_float(0.1f)); });
+		std::vector<fixed32> input(kCount);
+		std::ranges::generate(input, []() { return fixed32::Float(random_float(1.0f)); });
+		std::vector<fixed32> output(kCount);
+		FirFilterfx<int32_t, 16> fir(taps);
+		const std::vector<BiquadFilterfx<int32_t, 16>::Coefficients> sections(4, { 0.0675_fx32, 0.135_fx32, 0.0675_fx32, -1.143_fx32, 0.413_fx32 });
+		BiquadFilterfx<int32_t, 16> biquad(sections);
+
+		BENCHMARK("FIR 64 taps FastMul loop x64k") {
+			for (size_t n = taps.size(); n < kCount; ++n)
+			{
+				fixed32 sum = fixed32::Zero;
+				for (size_t k = 0; k < taps.size(); ++k)
+				{
+					sum += taps[k] * input[n - k];
+				}
+				output[n] = sum;
+			}
+			return output[kCount - 1];
+		};
+		BENCHMARK("FirFilterfx 64 taps x64k") {
+			fir.Process(input, output);
+			return output[kCount - 1];
+		};
+		BENCHMARK("BiquadFilterfx 4 sections x64k") {
+			biquad.Process(input, output);
+			return output[kCount - 1];
+		};
+	}
+
+	SECTION("Gemm")
+	{
+		for (size_t size : { 64, 128, 256 })
+		{
+			std::vector<fixed32> a(size * size), b(size * size), c(size * size);
+			std::ranges::generate(a, []() { return fixed32::Float(random_float(1.0f)); });
+			std::ranges::generate(b, []() { return fixed32::Float(random_float(1.0f)); });
+			std::vector<Fixed<int16_t, 8>> a16(size * size), b16(size * size), c16(size * size);
+			std::ranges::transform(a, a16.begin(), [](fixed32 x) { return Fixed<int16_t, 8>::Float(static_cast<double>(x)); });
+			std::ranges::transform(b, b16.begin(), [](fixed32 x) { return Fixed<int16_t, 8>::Float(static_cast<double>(x)); });
+			const std::string name = std::to_string(size) + "x" + std::to_string(size);
+
+			BENCHMARK("Naive operator* " + name) {
+				for (size_t i = 0; i < size; ++i)
+				{
+					for (size_t j = 0; j < size; ++j)
+					{
+						fixed32 sum = fixed32::Zero;
+						for (size_t p = 0; p < size; ++p)
+						{
+							sum += a[i * size + p] * b[p * size + j];
+						}
+						c[i * size + j] = sum;
+					}
+				}
+				return c[0];
+			};
+			BENCHMARK("Gemm fixed32 " + name) {
+				Mathfx::Gemm<int32_t, 16>(size, size, size, a, b, c);
+				return c[0];
+			};
+			BENCHMARK("Gemm fixed32 bias + ReLU " + name) {
+				Mathfx::GemmEpilogue<int32_t, 16> epilogue;
+				epilogue.bias = std::span<const fixed32>(a).subspan(0, size);
+				epilogue.activation = Mathfx::GemmActivation::ReLU;
+				Mathfx::Gemm<int32_t, 16>(size, size, size, a, b, c, epilogue);
+				return c[0];
+			};
+			BENCHMARK("Gemm 16 bit " + name) {
+				Mathfx::Gemm<int16_t, 8>(size, size, size, a16, b16, c16);
+				return c16[0];
+			};
+		}
+	}
+
+	SECTION("Activations")
+	{
+		constexpr size_t kCount = 1 << 14;
+		std::vector<fixed32> in(kCount), out(kCount);
+		std::ranges::generate(in, []() { return fixed32::Float(random_float(8.0f)); });
+		std::vector<fixed64> in64(kCount), out64(kCount);
+		std::ranges::generate(in64, []() { return random_fixed(8_fx64); });
+
+		BENCHMARK("Exp fixed32 x16k") {
+			std::ranges::transform(in, out.begin(), [](fixed32 x) { return Mathfx::Exp(x); });
+			return out[0];
+		};
+		BENCHMARK("FastExp fixed32 x16k") {
+			std::ranges::transform(in, out.begin(), [](fixed32 x) { return Mathfx::FastExp(x); });
+			return out[0];
+		};
+		BENCHMARK("FastExpBatch fixed32 x16k") {
+			Mathfx::FastExpBatch(in, std::span(out));
+			return out[0];
+		};
+		BENCHMARK("Tanh fixed32 x16k") {
+			std::ranges::transform(in, out.begin(), [](fixed32 x) { return Mathfx::Tanh(x); });
+			return out[0];
+		};
+		BENCHMARK("TanhBatch fixed32 x16k") {
+			Mathfx::TanhBatch(in, std::span(out));
+			return out[0];
+		};
+		BENCHMARK("SigmoidBatch fixed32 x16k") {
+			Mathfx::SigmoidBatch(in, std::span(out));
+			return out[0];
+		};
+		BENCHMARK("Softmax fixed32 x16k") {
+			Mathfx::Softmax(in, std::span(out));
+			return out[0];
+		};
+		BENCHMARK("Exp fixed64 x16k") {
+			std::ranges::transform(in64, out64.begin(), [](fixed64 x) { return Mathfx::Exp(x); });
+			return out64[0];
+		};
+		BENCHMARK("FastExp fixed64 x16k") {
+			std::ranges::transform(in64, out64.begin(), [](fixed64 x) { return Mathfx::FastExp(x); });
+			return out64[0];
+		};
+		BENCHMARK("Tanh fixed64 x16k") {
+			std::ranges::transform(in64, out64.begin(), [](fixed64 x) { return Mathfx::Tanh(x); });
+			return out64[0];
+		};
+		BENCHMARK("Softmax fixed64 x16k") {
+			Mathfx::Softmax(in64, std::span(out64));
+			return out64[0];
+		};
+	}
+
+	SECTION("BLAS")
+	{
+		constexpr size_t kCount = 1 << 16;
+		std::vector<fixed32> x(kCount), y(kCount);
+		std::ranges::generate(x, []() { return fixed32::Float(random_float(100.0f)); });
+		std::ranges::generate(y, []() { return fixed32::Float(random_float(100.0f)); });
+		std::vector<fixed64> x64(kCount), y64(kCount);
+		std::ranges::generate(x64, []() { return random_fixed(100_fx64); });
+		std::ranges::generate(y64, []() { return random_fixed(100_fx64); });
+		const fixed32 a = 0.001_fx32;
+		const fixed64 a64 = 0.001_fx64;
+
+		BENCHMARK("Dot loop fixed32 x64k") {
+			fixed32 sum = fixed32::Zero;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				sum += x[i] * y[i];
+			}
+			return sum;
+		};
+		BENCHMARK("Dot fixed32 x64k") {
+			return Mathfx::Dot(std::span(x), std::span(y));
+		};
+		BENCHMARK("Axpy loop fixed32 x64k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				y[i] += a * x[i];
+			}
+			return y[0];
+		};
+		BENCHMARK("Axpy fixed32 x64k") {
+			Mathfx::Axpy(a, x, std::span(y));
+			return y[0];
+		};
+		BENCHMARK("Nrm2 fixed32 x64k") {
+			return Mathfx::Nrm2(std::span(x));
+		};
+		BENCHMARK("Asum fixed32 x64k") {
+			return Mathfx::Asum(std::span(x));
+		};
+		BENCHMARK("IAmax fixed32 x64k") {
+			return Mathfx::IAmax(std::span(x));
+		};
+		BENCHMARK("Dot loop fixed64 x64k") {
+			fixed64 sum = fixed64::Zero;
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				sum += x64[i] * y64[i];
+			}
+			return sum;
+		};
+		BENCHMARK("Dot fixed64 x64k") {
+			return Mathfx::Dot(std::span(x64), std::span(y64));
+		};
+		BENCHMARK("Axpy loop fixed64 x64k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				y64[i] += a64 * x64[i];
+			}
+			return y64[0];
+		};
+		BENCHMARK("Axpy fixed64 x64k") {
+			Mathfx::Axpy(a64, x64, std::span(y64));
+			return y64[0];
+		};
+		BENCHMARK("Nrm2 fixed64 x64k") {
+			return Mathfx::Nrm2(std::span(x64));
+		};
+		BENCHMARK("Asum fixed64 x64k") {
+			return Mathfx::Asum(std::span(x64));
+		};
+		BENCHMARK("IAmax fixed64 x64k") {
+			return Mathfx::IAmax(std::span(x64));
+		};
+	}
+
+	SECTION("Solver2fx")
+	{
+		constexpr size_t kBodies = 1000;
+		Vector2fxSoA velocities(kBodies);
+		std::vector<fixed64> angularVelocities(kBodies), inverseMasses(kBodies, fixed64::One), inverseInertias(kBodies, fixed64::One);
+		inverseMasses[0] = fixed64::Zero;
+		inverseInertias[0] = fixed64::Zero;
+		std::vector<Vector2fx> centers(kBodies);
+		std::ranges::generate(centers, []() { return Vector2fx(random_fixed(50_fx64), random_fixed(50_fx64)); });
+
+		Solver2fx solver;
+		for (uint32_t c = 0; c < 4000; ++c)
+		{
+			const uint32_t a = static_cast<uint32_t>(G.rng() % kBodies);
+			const uint32_t b = (a + 1 + static_cast<uint32_t>(G.rng() % (kBodies - 1))) % kBodies;
+			Manifold2fx contact;
+			contact.normal = Vector2fx::Normalize(centers[b] - centers[a]);
+			contact.pointCount = 1;
+			contact.points[0] = { (centers[a] + centers[b]) * 0.5_fx64, random_pos_fixed(0.05_fx64), c };
+			solver.AddContact(a, b, centers[a], centers[b], contact, 0.3_fx64);
+		}
+		const Solver2fx::Bodies bodies { velocities, angularVelocities, inverseMasses, inverseInertias };
+		Solver2fx::Settings settings;
+		settings.warmStarting = false;
+
+		BENCHMARK("Sequential 8000 rows x8") {
+			Solver2fx copy = solver;
+			copy.Solve(bodies, fixed64::One / 60_fx64, settings);
+			return velocities.x[1];
+		};
+		BENCHMARK("Colored 8000 rows x8") {
+			Solver2fx copy = solver;
+			Solver2fx::Settings colored = settings;
+			colored.colored = true;
+			copy.Solve(bodies, fixed64::One / 60_fx64, colored);
+			return velocities.x[1];
+		};
+	}
+
+	SECTION("Convolution")
+	{
+		// Built with -O2 -mavx2 ConvolveSpan runs 8 outputs per step, with FXMATH_NO_SIMD added too it runs the scalar loop
+		constexpr size_t kSize = 256;
+		std::vector<fixed32> source(kSize * kSize), result(kSize * kSize);
+		std::ranges::generate(source, []() { return fixed32::Float(random_float(100.0f)); });
+		std::vector<fixed32> kernel(5 * 5);
+		std::ranges::generate(kernel, []() { return fixed32::Float(random_float(1.0f)); });
+		std::vector<Fixed<int16_t, 8>> source16(kSize * kSize), result16(kSize * kSize);
+		std::ranges::generate(source16, []() { return Fixed<int16_t, 8>(static_cast<int16_t>(G.rng())); });
+		std::vector<Fixed<int16_t, 8>> kernel16(5 * 5, Fixed<int16_t, 8>(static_cast<int16_t>(10)));
+
+		BENCHMARK("FastMul loop 5x5 fixed32 256^2") {
+			for (size_t y = 2; y < kSize - 2; ++y)
+			{
+				for (size_t x = 2; x < kSize - 2; ++x)
+				{
+					fixed32 sum = fixed32::Zero;
+					for (size_t ky = 0; ky < 5; ++ky)
+					{
+						for (size_t kx = 0; kx < 5; ++kx)
+						{
+							sum += kernel[ky * 5 + kx] * source[(y + ky - 2) * kSize + x + kx - 2];
+						}
+					}
+					result[y * kSize + x] = sum;
+				}
+			}
+			return result[kSize + 1];
+		};
+		BENCHMARK("Convolve2D 5x5 fixed32 256^2") {
+			Mathfx::Convolve2D(kSize, kSize, source, std::span(result), 5, 5, kernel);
+			return result[0];
+		};
+		BENCHMARK("ConvolveSeparable 5+5 fixed32 256^2") {
+			Mathfx::ConvolveSeparable(kSize, kSize, source, std::span(result), std::span(kernel).first(5), std::span(kernel).last(5));
+			return result[0];
+		};
+		BENCHMARK("Convolve2D 5x5 16 bit 256^2") {
+			Mathfx::Convolve2D(kSize, kSize, source16, std::span(result16), 5, 5, kernel16);
+			return result16[0];
+		};
+	}
+
+	SECTION("Stats")
+	{
+		constexpr size_t kCount = 1 << 16;
+		std::vector<fixed32> values(kCount);
+		std::ranges::generate(values, []() { return fixed32::Float(random_float(100.0f)); });
+		std::vector<fixed64> values64(kCount);
+		std::ranges::generate(values64, []() { return random_fixed(100_fx64); });
+
+		BENCHMARK("Stats fixed32 x64k") {
+			Mathfx::Stats<int32_t, 16> stats;
+			stats.Add(values);
+			return stats.Variance();
+		};
+		BENCHMARK("Stats fixed64 x64k") {
+			Mathfx::Stats<int64_t, 32> stats;
+			stats.Add(values64);
+			return stats.Variance();
+		};
+		BENCHMARK("ParallelStats fixed64 x64k") {
+			return Mathfx::ParallelStats(std::span(values64)).Variance();
+		};
+		BENCHMARK("Histogram shift fixed32 x64k") {
+			Mathfx::Histogram<int32_t, 16> histogram(-100_fx32, 0.25_fx32, 800);
+			histogram.Add(values);
+			return histogram.Bin(400);
+		};
+		BENCHMARK("Histogram divide fixed32 x64k") {
+			Mathfx::Histogram<int32_t, 16> histogram(-100_fx32, 0.3_fx32, 667);
+			histogram.Add(values);
+			return histogram.Bin(333);
+		};
+	}
+
+	SECTION("Splines")
+	{
+		constexpr size_t kCount = 4096;
+		const Vector2fx p0(0_fx64, 0_fx64), p1(10_fx64, 40_fx64), p2(60_fx64, 45_fx64), p3(100_fx64, 0_fx64);
+		const auto curve = CubicSplinefx<Vector2fx>::Bezier(p0, p1, p2, p3);
+		std::vector<Vector2fx> points(kCount);
+		const fixed64 step = fixed64::One / fixed64::Int(kCount - 1);
+
+		BENCHMARK("Bezier lerps Vector2fx x4k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				const fixed64 t = step * fixed64::Int(static_cast<int>(i));
+				const Vector2fx a(Mathfx::Lerp(p0.x, p1.x, t), Mathfx::Lerp(p0.y, p1.y, t));
+				const Vector2fx b(Mathfx::Lerp(p1.x, p2.x, t), Mathfx::Lerp(p1.y, p2.y, t));
+				const Vector2fx c(Mathfx::Lerp(p2.x, p3.x, t), Mathfx::Lerp(p2.y, p3.y, t));
+				const Vector2fx ab(Mathfx::Lerp(a.x, b.x, t), Mathfx::Lerp(a.y, b.y, t));
+				const Vector2fx bc(Mathfx::Lerp(b.x, c.x, t), Mathfx::Lerp(b.y, c.y, t));
+				points[i] = Vector2fx(Mathfx::Lerp(ab.x, bc.x, t), Mathfx::Lerp(ab.y, bc.y, t));
+			}
+			return points[kCount / 2];
+		};
+		BENCHMARK("Bezier Evaluate Vector2fx x4k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				points[i] = curve.Evaluate(step * fixed64::Int(static_cast<int>(i)));
+			}
+			return points[kCount / 2];
+		};
+		BENCHMARK("Bezier Sample Vector2fx x4k") {
+			curve.Sample(points);
+			return points[kCount / 2];
+		};
+		BENCHMARK("ArcLengthTablefx build 64") {
+			return ArcLengthTablefx<Vector2fx>(curve, 64).Length();
+		};
+		const ArcLengthTablefx<Vector2fx> table(curve, 64);
+		BENCHMARK("ArcLengthTablefx Evaluate x4k") {
+			const fixed64 spacing = table.Length() / fixed64::Int(kCount);
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				points[i] = table.Evaluate(spacing * fixed64::Int(static_cast<int>(i)));
+			}
+			return points[kCount / 2];
+		};
+	}
+
+	SECTION("FixedCurve")
+	{
+		// Pow2 wraps for fixed32 results below 2^-16, so the distances stop short of where the falloff gets that small.
+		// Built with -O2 -mavx2 the batch overload runs the AVX2 path, with FXMATH_NO_SIMD added too it runs Evaluate.
+		constexpr size_t kCount = 1 << 14;
+		std::vector<fixed32> distances(kCount), results(kCount);
+		std::ranges::generate(distances, []() { return fixed32::Float(std::abs(random_float(9.5f))); });
+		const fixed32 range = 10_fx32;
+		const auto falloff = FixedCurve<int32_t, 16>::FromFunction(0_fx32, range, 256, [](fixed32 d) { return Mathfx::Pow(fixed32::One - d / 10_fx32, 2.5_fx32); });
+
+		BENCHMARK("Pow falloff fixed32 x16k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				const fixed32 d = Mathfx::Min(distances[i], range);
+				results[i] = Mathfx::Pow(fixed32::One - d / range, 2.5_fx32);
+			}
+			return results[0];
+		};
+		BENCHMARK("FixedCurve Evaluate fixed32 x16k") {
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				results[i] = falloff(distances[i]);
+			}
+			return results[0];
+		};
+		BENCHMARK("FixedCurve batch fixed32 x16k") {
+			falloff.Evaluate(distances, results);
+			return results[0];
+		};
+	}
+
+	SECTION("Trigonometry")
+	{
+		BENCHMARK_ADVANCED("Sin")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::Sin(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("FastSin")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::FastSin(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::sinf")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
+			meter.measure([&v](int i) { return std::sinf(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("Cos")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::Cos(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("FastCos")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::FastCos(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::cosf")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
+			meter.measure([&v](int i) { return std::cosf(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("Tan")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::Tan(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::tanf")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const float& x) { return random_float(); });
+			meter.measure([&v](int i) { return std::tanf(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("Acos")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::Acos(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::acosf")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const float& x) { return random_snorm_float(); });
+			meter.measure([&v](int i) { return std::acosf(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("Atan")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
+			meter.measure([&v](int i) { return Mathfx::Atan(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::atanf")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> v(meter.runs());
+			std::ranges::transform(v, v.begin(), [](const float& x) { return random_snorm_float(); });
+			meter.measure([&v](int i) { return std::atanf(v[i]); });
+		};
+
+		BENCHMARK_ADVANCED("Atan2")(Catch::Benchmark::Chronometer meter) {
+			std::vector<fixed64> vx(meter.runs());
+			std::vector<fixed64> vy(meter.runs());
+			std::ranges::transform(vx, vx.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
+			std::ranges::transform(vy, vy.begin(), [](const fixed64& x) { return random_snorm_fixed(); });
+			meter.measure([&vx, &vy](int i) { return Mathfx::Atan2(vy[i], vx[i]); });
+		};
+
+		BENCHMARK_ADVANCED("std::atan2f")(Catch::Benchmark::Chronometer meter) {
+			std::vector<float> vx(meter.runs());
+			std::vector<float> vy(meter.runs());
+			std::ranges::transform(vx, vx.begin(), [](const float& x) { return random_snorm_float(); });
+			std::ranges::transform(vy, vy.begin(), [](const float& x) { return random_snorm_float(); });
+			meter.measure([&vx, &vy](int i) { return std::atan2f(vy[i], vx[i]); });
+		};
+	}
+}
+
+#endif
+
+TEST_CASE("Vector2fx", "[fixedmath]")
+{
+	Vector2fx v0 = Vector2fx::Zero;
+	Vector2fx v1 = Vector2fx::Right;
+	REQUIRE(Vector2fx::Zero + Vector2fx::Right == Vector2fx::Right);
+	REQUIRE(Vector2fx::Zero + Vector2fx::Left == Vector2fx::Left);
+	REQUIRE(Vector2fx::Zero + Vector2fx::Up == Vector2fx::Up);
+	REQUIRE(Vector2fx::Zero + Vector2fx::Down == Vector2fx::Down);
+	REQUIRE(Vector2fx::Zero + Vector2fx::One == Vector2fx::One);
+}
+
+TEST_CASE("Wide Arithmetic", "[fixedmath]")
+{
+	SECTION("Int128")
+	{
+		REQUIRE(Int128::Mul(-1, -1) == Int128(1));
+		REQUIRE(Int128::Mul(-3, 5) == Int128(-15));
+		REQUIRE(Int128::Mul(std::numeric_limits<int64_t>::min(), -1) == (Int128(1) << 63));
+		REQUIRE((Int128(-1) >> 100) == Int128(-1));
+		REQUIRE((Int128(5) << 70 >> 70) == Int128(5));
+		REQUIRE(Int128(-2) < Int128(1));
+		REQUIRE(Int128(1) << 64 > Int128(std::numeric_limits<int64_t>::max()));
+		REQUIRE((Int128(1) << 64).SaturateToInt64() == std::numeric_limits<int64_t>::max());
+		REQUIRE((-(Int128(1) << 64)).SaturateToInt64() == std::numeric_limits<int64_t>::min());
+
+		Int128 sum;
+		sum += Int128::Mul(std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max());
+		sum -= Int128::Mul(std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max());
+		REQUIRE(sum == Int128(0));
+	}
+
+	SECTION("WideMul matches FastMul")
+	{
+		for (auto a : testCases)
+		{
+			for (int i = 0; i < 8; ++i)
+			{
+				fixed64 x(a);
+				fixed64 y = random_fixed();
+				CAPTURE(x.rawValue, y.rawValue);
+				REQUIRE(Mathfx::WideToFixed<int64_t, 32>(Mathfx::WideMul(x, y)) == fixed64::FastMul(x, y));
+			}
+		}
+
+		fixed32 a = fixed32::Float(-3.25);
+		fixed32 b = fixed32::Float(7.5);
+		REQUIRE(Mathfx::WideToFixed<int32_t, 16>(Mathfx::WideMul(a, b)) == fixed32::FastMul(a, b));
+	}
+
+	SECTION("FixedAccumulator")
+	{
+		FixedAccumulator<int64_t, 32> sum;
+		sum.MulAdd(fixed64::MaxValue, 2_fx64);
+		sum.MulSub(fixed64::MaxValue, 2_fx64);
+		sum.Add(1.5_fx64);
+		REQUIRE(sum.Result() == 1.5_fx64);
+
+		FixedAccumulator<int64_t, 32> overflow;
+		overflow.MulAdd(fixed64::MaxValue, 4_fx64);
+		REQUIRE(overflow.SaturatedResult() == fixed64::MaxValue);
+
+		// Full scale fixed32 products are 2^62 each, a handful of them is past 64 bits
+		FixedAccumulator<int32_t, 16> sum32;
+		for (int i = 0; i < 8; ++i)
+		{
+			sum32.MulAdd(fixed32::MaxValue, fixed32::MaxValue);
+		}
+		REQUIRE(sum32.SaturatedResult() == fixed32::MaxValue);
+		for (int i = 0; i < 8; ++i)
+		{
+			sum32.MulSub(fixed32::MaxValue, fixed32::MaxValue);
+		}
+		sum32.Add(1.5_fx32);
+		REQUIRE(sum32.Result() == 1.5_fx32);
+		for (int i = 0; i < 8; ++i)
+		{
+			sum32.MulAdd(fixed32::MinValue, fixed32::MaxValue);
+		}
+		REQUIRE(sum32.SaturatedResult() == fixed32::MinValue);
+	}
+}
+
+TEST_CASE("Matrixfx", "[fixedmath]")
+{
+	constexpr fixed64 kMargin = fixed64(static_cast<int64_t>(1) << 12);
+	auto nearVec = [&](const Vector2fx& a, const Vector2fx& b) {
+		return Mathfx::Abs(a.x - b.x) < kMargin && Mathfx::Abs(a.y - b.y) < kMargin;
+	};
+	auto nearMatrix = [&]<int N>(const Matrixfx<N>& a, const Matrixfx<N>& b) {
+		for (int row = 0; row < N; ++row)
+		{
+			for (int col = 0; col < N; ++col)
+			{
+				if (Mathfx::Abs(a.m[row][col] - b.m[row][col]) >= kMargin)
+				{
+					return false;
+				}
+			}
+		}
+		return true;
+	};
+
+	SECTION("Matrix2fx")
+	{
+		Matrix2fx a;
+		a.m[0][0] = 4_fx; a.m[0][1] = 7_fx;
+		a.m[1][0] = 2_fx; a.m[1][1] = 6_fx;
+
+		REQUIRE(Matrix2fx::Determinant(a) == 10_fx);
+		REQUIRE(a * Matrix2fx::Identity() == a);
+		REQUIRE(Matrix2fx::Transpose(a).m[0][1] == 2_fx);
+		REQUIRE(nearMatrix(a * Matrix2fx::Inverse(a), Matrix2fx::Identity()));
+		REQUIRE(Mathfx::Abs(Matrix2fx::Inverse(a).m[0][0] - 0.6_fx) < kMargin);
+	}
+
+	SECTION("Matrix3fx")
+	{
+		Matrix3fx a;
+		a.m[0][0] = 2_fx; a.m[0][1] = -3_fx; a.m[0][2] = 1_fx;
+		a.m[1][0] = 2_fx; a.m[1][1] = 0_fx; a.m[1][2] = -1_fx;
+		a.m[2][0] = 1_fx; a.m[2][1] = 4_fx; a.m[2][2] = 5_fx;
+
+		REQUIRE(Matrix3fx::Determinant(a) == 49_fx);
+		REQUIRE(Matrix3fx::Transpose(Matrix3fx::Transpose(a)) == a);
+		REQUIRE(nearMatrix(a * Matrix3fx::Inverse(a), Matrix3fx::Identity()));
+		REQUIRE(nearMatrix(Matrix3fx::Inverse(a) * a, Matrix3fx::Identity()));
+
+		Vector3fx v = a * Vector3fx(1_fx, 2_fx, 3_fx);
+		REQUIRE(v == Vector3fx(-1_fx, -1_fx, 24_fx));
+	}
+
+	SECTION("Matrix4fx")
+	{
+		Matrix4fx a;
+		int values[4][4] = { { 1, 0, 2, -1 }, { 3, 0, 0, 5 }, { 2, 1, 4, -3 }, { 1, 0, 5, 0 } };
+		for (int row = 0; row < 4; ++row)
+		{
+			for (int col = 0; col < 4; ++col)
+			{
+				a.m[row][col] = fixed64::Int(values[row][col]);
+			}
+		}
+
+		REQUIRE(Matrix4fx::Determinant(a) == 30_fx);
+		REQUIRE(nearMatrix(a * Matrix4fx::Inverse(a), Matrix4fx::Identity()));
+		REQUIRE(TransformPoint(a, Vector3fx(1_fx, 1_fx, 1_fx)) == Vector3fx(2_fx, 8_fx, 4_fx));
+		REQUIRE(TransformVector(a, Vector3fx(1_fx, 1_fx, 1_fx)) == Vector3fx(3_fx, 3_fx, 7_fx));
+	}
+
+	SECTION("Affine2fx")
+	{
+		Affine2fx rotate = Affine2fx::FromRotation(fixed64::PiOver2);
+		REQUIRE(nearVec(rotate * Vector2fx::Right, Vector2fx::Up));
+
+		Affine2fx trs = Affine2fx::FromTranslationRotationScale(Vector2fx(10_fx, -5_fx), fixed64::Pi, Vector2fx(2_fx, 2_fx));
+		REQUIRE(nearVec(trs * Vector2fx(1_fx, 1_fx), Vector2fx(8_fx, -7_fx)));
+		REQUIRE(nearVec(Affine2fx::Inverse(trs) * (trs * Vector2fx(3_fx, 4_fx)), Vector2fx(3_fx, 4_fx)));
+		REQUIRE(Mathfx::Abs(Affine2fx::Determinant(trs) - 4_fx) < kMargin);
+
+		Affine2fx translate = Affine2fx::FromTranslation(Vector2fx(1_fx, 2_fx));
+		REQUIRE(nearVec((translate * rotate) * Vector2fx::Right, Vector2fx(1_fx, 3_fx)));
+		REQUIRE(nearVec((rotate * translate) * Vector2fx::Right, Vector2fx(-2_fx, 2_fx)));
+	}
+
+	SECTION("TransformPoints")
+	{
+		Affine2fx trs = Affine2fx::FromTranslationRotationScale(Vector2fx(random_fixed(), random_fixed()), random_fixed(), Vector2fx(1.5_fx, 0.75_fx));
+		std::vector<Vector2fx> in(301);
+		std::ranges::generate(in, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> out(in.size());
+
+		Affine2fx::TransformPoints(trs, in, out);
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Affine2fx::TransformPoint(trs, in[i]));
+		}
+
+		Affine2fx::TransformPoints(trs, in);
+		REQUIRE(in == out);
+	}
+}
+
+TEST_CASE("Quaternionfx", "[fixedmath]")
+{
+	// ApproxEqual masks off low bits which fails either side of a carry (0.99999 vs 1.0), compare against an absolute margin instead
+	constexpr fixed64 kMargin = fixed64(static_cast<int64_t>(1) << 12);
+	auto near = [&](const Quaternionfx& a, const Quaternionfx& b) {
+		return Mathfx::Abs(a.x - b.x) < kMargin && Mathfx::Abs(a.y - b.y) < kMargin
+			&& Mathfx::Abs(a.z - b.z) < kMargin && Mathfx::Abs(a.w - b.w) < kMargin;
+	};
+	auto nearVec = [&](const Vector3fx& a, const Vector3fx& b, fixed64 margin) {
+		return Mathfx::Abs(a.x - b.x) < margin && Mathfx::Abs(a.y - b.y) < margin && Mathfx::Abs(a.z - b.z) < margin;
+	};
+
+	SECTION("Multiplication")
+	{
+		Quaternionfx q = Quaternionfx::AxisAngle(Vector3fx::Up, 90_fx);
+		REQUIRE(q * Quaternionfx::Identity == q);
+		REQUIRE(Quaternionfx::Identity * q == q);
+		REQUIRE(near(q * Quaternionfx::Conjugate(q), Quaternionfx::Identity));
+		REQUIRE(near(q * Quaternionfx::Inverse(q), Quaternionfx::Identity));
+
+		Quaternionfx half = Quaternionfx::AxisAngle(Vector3fx::Up, 45_fx);
+		REQUIRE(near(half * half, q));
+	}
+
+	SECTION("Normalize")
+	{
+		Quaternionfx q(1_fx, 2_fx, 3_fx, 4_fx);
+		Quaternionfx n = Quaternionfx::Normalize(q);
+		REQUIRE(Mathfx::Abs(n.SqrMagnitude() - fixed64::One) < kMargin);
+
+		double length = std::sqrt(30.0);
+		CHECK(static_cast<double>(n.x) == Approx(1.0 / length).margin(0.000001));
+		CHECK(static_cast<double>(n.w) == Approx(4.0 / length).margin(0.000001));
+		REQUIRE(Quaternionfx::Normalize(Quaternionfx(0_fx, 0_fx, 0_fx, 0_fx)) == Quaternionfx::Identity);
+	}
+
+	SECTION("Rotate")
+	{
+		Quaternionfx yaw = Quaternionfx::AxisAngle(Vector3fx::Up, 90_fx);
+		REQUIRE(nearVec(yaw * Vector3fx::Right, Vector3fx::Back, kMargin));
+		REQUIRE(nearVec(yaw * Vector3fx::Forward, Vector3fx::Right, kMargin));
+		REQUIRE(nearVec(yaw * Vector3fx::Up, Vector3fx::Up, kMargin));
+
+		Quaternionfx roll = Quaternionfx::AxisAngleRadians(Vector3fx::Forward, fixed64::Pi);
+		REQUIRE(nearVec(roll * Vector3fx::Right, Vector3fx::Left, kMargin));
+
+		for (int i = 0; i < 100; ++i)
+		{
+			Vector3fx axis = Vector3fx(random_fixed(), random_fixed(), random_fixed()).Normalized();
+			Quaternionfx q = Quaternionfx::AxisAngle(axis, random_fixed(360_fx64));
+			Vector3fx v(random_fixed(), random_fixed(), random_fixed());
+			Vector3fx rotated = q * v;
+			CHECK(static_cast<double>(rotated.Magnitude()) == Approx(static_cast<double>(v.Magnitude())).epsilon(0.0001));
+			CHECK(nearVec(Quaternionfx::Conjugate(q) * rotated, v, 0.001_fx64));
+		}
+	}
+
+	SECTION("RotateBatch")
+	{
+		Quaternionfx q = Quaternionfx::AxisAngle(Vector3fx(1_fx, 2_fx, 3_fx).Normalized(), 37_fx);
+		std::vector<Vector3fx> in(257);
+		std::ranges::generate(in, []() { return Vector3fx(random_fixed(), random_fixed(), random_fixed()); });
+		std::vector<Vector3fx> out(in.size());
+
+		Quaternionfx::RotateBatch(q, in, out);
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Quaternionfx::Rotate(q, in[i]));
+		}
+	}
+
+	SECTION("Interpolation")
+	{
+		Quaternionfx a = Quaternionfx::Identity;
+		Quaternionfx b = Quaternionfx::AxisAngle(Vector3fx::Up, 90_fx);
+
+		REQUIRE(near(Quaternionfx::Slerp(a, b, 0_fx), a));
+		REQUIRE(near(Quaternionfx::Slerp(a, b, 1_fx), b));
+		REQUIRE(near(Quaternionfx::Slerp(a, b, 0.5_fx), Quaternionfx::AxisAngle(Vector3fx::Up, 45_fx)));
+		REQUIRE(near(Quaternionfx::Nlerp(a, b, 0.5_fx), Quaternionfx::AxisAngle(Vector3fx::Up, 45_fx)));
+
+		// Opposite hemisphere quaternions represent the same rotation, interpolation takes the short way round
+		Quaternionfx negB(-b.x, -b.y, -b.z, -b.w);
+		REQUIRE(near(Quaternionfx::Slerp(a, negB, 0.5_fx), Quaternionfx::AxisAngle(Vector3fx::Up, 45_fx)));
+	}
+}
+
+TEST_CASE("Rotation2fx", "[fixedmath]")
+{
+	constexpr fixed64 kMargin = fixed64(static_cast<int64_t>(1) << 12);
+	auto nearVec = [&](const Vector2fx& a, const Vector2fx& b) {
+		return Mathfx::Abs(a.x - b.x) < kMargin && Mathfx::Abs(a.y - b.y) < kMargin;
+	};
+
+	SECTION("Matches Vector2fx::Rotate")
+	{
+		for (int i = 0; i < 200; ++i)
+		{
+			fixed64 radians = random_fixed(fixed64::TwoPi);
+			fixed64 degrees = random_fixed(360_fx64);
+			Vector2fx v(random_fixed(), random_fixed());
+			REQUIRE(Rotation2fx::FromRadians(radians) * v == Vector2fx::RotateByRadians(v, radians));
+			REQUIRE(Rotation2fx::FromDegrees(degrees) * v == Vector2fx::Rotate(v, degrees));
+		}
+		REQUIRE(Rotation2fx::FromRadians(0_fx) == Rotation2fx::Identity);
+	}
+
+	SECTION("Compose")
+	{
+		Rotation2fx r30 = Rotation2fx::FromDegrees(30_fx);
+		Rotation2fx r60 = Rotation2fx::FromDegrees(60_fx);
+		Rotation2fx r90 = r30 * r60;
+		REQUIRE(nearVec(r90 * Vector2fx::Right, Vector2fx::Up));
+		REQUIRE(nearVec(r90.Inverted() * Vector2fx::Up, Vector2fx::Right));
+		REQUIRE(nearVec((r90 * r90.Inverted()).Direction(), Vector2fx::Right));
+		REQUIRE(Mathfx::Abs(r90.Degrees() - 90_fx) < 0.5_fx);
+
+		Rotation2fx drift = Rotation2fx::Identity;
+		Rotation2fx step = Rotation2fx::FromDegrees(1_fx);
+		for (int i = 0; i < 360; ++i)
+		{
+			drift *= step;
+		}
+		drift = drift.Normalized();
+		REQUIRE(Mathfx::Abs(drift.Direction().SqrMagnitude() - 1_fx) < kMargin);
+		REQUIRE(Vector2fx::Distance(drift * Vector2fx::Right, Vector2fx::Right) < 0.001_fx);
+	}
+
+	SECTION("FromDirection")
+	{
+		Rotation2fx r = Rotation2fx::FromDirection(Vector2fx(3_fx, 4_fx));
+		REQUIRE(nearVec(r.Direction(), Vector2fx(0.6_fx, 0.8_fx)));
+		REQUIRE(nearVec(r * Vector2fx(5_fx, 0_fx), Vector2fx(3_fx, 4_fx)));
+		REQUIRE(Rotation2fx::FromDirection(Vector2fx::Zero) == Rotation2fx::Identity);
+	}
+
+	SECTION("RotateBatch")
+	{
+		Rotation2fx r = Rotation2fx::FromRadians(random_fixed(fixed64::Pi));
+		Vector2fx axis(random_fixed(), random_fixed());
+		std::vector<Vector2fx> in(129);
+		std::ranges::generate(in, []() { return Vector2fx(random_fixed(), random_fixed()); });
+		std::vector<Vector2fx> out(in.size());
+
+		Rotation2fx::RotateBatch(r, in, out);
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == r * in[i]);
+		}
+
+		Rotation2fx::RotateAroundAxisBatch(r, in, out, axis);
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Rotation2fx::RotateAroundAxis(r, in[i], axis));
+		}
+
+		std::vector<Vector2fx> inPlace = in;
+		Rotation2fx::RotateBatch(r, inPlace);
+		Rotation2fx::RotateBatch(r, in, out);
+		REQUIRE(inPlace == out);
+	}
+}
+
+// Batch kernels are compared with their scalar functions. The vector paths only exist in the AVX2 configuration, NoSimd
+// runs the same checks over the scalar fallbacks.
+TEST_CASE("Vector2fx Batch", "[fixedmath]")
+{
+	constexpr size_t kCount = 131;
+	std::vector<Vector2fx> vecs(kCount);
+	std::ranges::generate(vecs, []() { return Vector2fx(random_fixed(), random_fixed()); });
+	vecs[5] = Vector2fx::Zero;
+	vecs[6] = Vector2fx(fixed64(static_cast<int64_t>(1)), fixed64(static_cast<int64_t>(-1)));
+	Vector2fx point(random_fixed(), random_fixed());
+	std::vector<fixed64> out(kCount);
+
+	SECTION("FastSqrtBatch")
+	{
+		std::vector<fixed64> in;
+		for (auto raw : testCases)
+		{
+			if (raw >= 0)
+			{
+				in.push_back(fixed64(raw));
+			}
+		}
+		std::vector<fixed64> roots(in.size());
+		Mathfx::FastSqrtBatch(in, std::span(roots));
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(roots[i] == Mathfx::FastSqrt(in[i]));
+		}
+
+		Mathfx::FastSqrtBatch(std::span(in));
+		REQUIRE(in == roots);
+	}
+
+	SECTION("MagnitudeBatch")
+	{
+		Vector2fx::MagnitudeBatch(vecs, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == vecs[i].Magnitude());
+		}
+	}
+
+	SECTION("NormalizeBatch")
+	{
+		std::vector<Vector2fx> normalized(kCount);
+		Vector2fx::NormalizeBatch(vecs, normalized);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(normalized[i] == Vector2fx::Normalize(vecs[i]));
+		}
+	}
+
+	SECTION("DistanceToPointBatch")
+	{
+		Vector2fx::DistanceToPointBatch(point, vecs, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == Vector2fx::Distance(vecs[i], point));
+		}
+
+		Vector2fx::DistanceSquaredToPointBatch(point, vecs, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == Vector2fx::DistanceSquared(vecs[i], point));
+		}
+	}
+}
+
+TEST_CASE("Vector2fxSoA", "[fixedmath]")
+{
+	// Odd length so the scalar tail after the four wide SIMD blocks is exercised too
+	constexpr size_t kCount = 103;
+	std::vector<Vector2fx> positions(kCount);
+	std::vector<Vector2fx> velocities(kCount);
+	std::ranges::generate(positions, []() { return Vector2fx(random_fixed(), random_fixed()); });
+	std::ranges::generate(velocities, []() { return Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)); });
+	positions[7] = Vector2fx::Zero;
+
+	Vector2fxSoA soa(positions);
+	Vector2fxSoA soaVelocities(velocities);
+
+	SECTION("Conversion")
+	{
+		REQUIRE(soa.Size() == kCount);
+		REQUIRE(soa.ToAoS() == positions);
+		REQUIRE(reinterpret_cast<uintptr_t>(soa.x.data()) % 64 == 0);
+		REQUIRE(reinterpret_cast<uintptr_t>(soa.y.data()) % 64 == 0);
+
+		soa[3] = Vector2fx(1_fx, 2_fx);
+		REQUIRE(soa.x[3] == 1_fx);
+		REQUIRE(soa.y[3] == 2_fx);
+		soa[3] += Vector2fx::One;
+		REQUIRE(static_cast<Vector2fx>(soa[3]) == Vector2fx(2_fx, 3_fx));
+
+		const Vector2fxSoA& constSoa = soa;
+		REQUIRE(constSoa[0] == positions[0]);
+	}
+
+	SECTION("Add/Sub/Scale/MulAdd")
+	{
+		Vector2fxSoA result = soa;
+		result.Add(soaVelocities);
+		result.Sub(soaVelocities);
+		REQUIRE(result.ToAoS() == positions);
+
+		fixed64 scale = random_fixed(4_fx64);
+		result.Scale(scale);
+		result.Add(Vector2fx::One);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(result[i] == positions[i] * scale + Vector2fx::One);
+		}
+
+		fixed64 dt = 1_fx64 / 60_fx64;
+		result = soa;
+		result.MulAdd(soaVelocities, dt);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(result[i] == positions[i] + velocities[i] * dt);
+		}
+	}
+
+	SECTION("Normalize")
+	{
+		Vector2fxSoA result = soa;
+		result.Normalize();
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(result[i] == Vector2fx::Normalize(positions[i]));
+		}
+	}
+
+	SECTION("DistanceSquared/Dot")
+	{
+		Vector2fx point(random_fixed(), random_fixed());
+		std::vector<fixed64> out(kCount);
+
+		soa.DistanceSquared(point, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == Vector2fx::DistanceSquared(positions[i], point));
+		}
+
+		soa.Dot(soaVelocities, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == Vector2fx::Dot(positions[i], velocities[i]));
+		}
+
+		soa.Dot(point, out);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(out[i] == Vector2fx::Dot(positions[i], point));
+		}
+	}
+}
+
+TEST_CASE("Exact Predicates", "[fixedmath]")
+{
+	auto raw = [](int64_t x, int64_t y) { return Vector2fx(fixed64(x), fixed64(y)); };
+
+	SECTION("Orient2D")
+	{
+		REQUIRE(Mathfx::Orient2D(Vector2fx::Zero, Vector2fx::Right, Vector2fx::Up) == 1);
+		REQUIRE(Mathfx::Orient2D(Vector2fx::Zero, Vector2fx::Up, Vector2fx::Right) == -1);
+		REQUIRE(Mathfx::Orient2D(Vector2fx::Zero, Vector2fx::One, Vector2fx(5_fx, 5_fx)) == 0);
+
+		// Near the coordinate limit one raw unit off the line is still seen, FastMul based Cross overflows here
+		const int64_t big = (static_cast<int64_t>(1) << 61) - 3;
+		Vector2fx a = raw(-big, -big + 1);
+		Vector2fx b = raw(big, big - 1);
+		REQUIRE(Mathfx::Orient2D(a, b, Vector2fx::Zero) == 0);
+		REQUIRE(Mathfx::Orient2D(a, b, raw(0, 1)) == 1);
+		REQUIRE(Mathfx::Orient2D(a, b, raw(0, -1)) == -1);
+		REQUIRE(Mathfx::Orient2D(b, a, raw(0, 1)) == -1);
+
+		// Small coordinates fit the plain int64 cross product, compare against it
+		const fixed64 small = fixed64(static_cast<int64_t>(1) << 30);
+		for (int i = 0; i < 10000; ++i)
+		{
+			Vector2fx p(random_fixed(small), random_fixed(small));
+			Vector2fx q(random_fixed(small), random_fixed(small));
+			Vector2fx r = (i % 4 == 0) ? p + (q - p) * 2_fx64 : Vector2fx(random_fixed(small), random_fixed(small));
+			int64_t cross = (q.x.rawValue - p.x.rawValue) * (r.y.rawValue - p.y.rawValue)
+				- (q.y.rawValue - p.y.rawValue) * (r.x.rawValue - p.x.rawValue);
+			REQUIRE(Mathfx::Orient2D(p, q, r) == (cross > 0) - (cross < 0));
+		}
+	}
+
+	SECTION("SegmentsIntersect")
+	{
+		REQUIRE(Mathfx::SegmentsIntersect(Vector2fx::Zero, Vector2fx::One, Vector2fx::Up, Vector2fx::Right));
+		REQUIRE_FALSE(Mathfx::SegmentsIntersect(Vector2fx::Zero, Vector2fx::Right, Vector2fx::Up, Vector2fx::One));
+
+		// Touching endpoints and T junctions count
+		REQUIRE(Mathfx::SegmentsIntersect(Vector2fx::Zero, Vector2fx::One, Vector2fx::One, Vector2fx(2_fx, 0_fx)));
+		REQUIRE(Mathfx::SegmentsIntersect(Vector2fx::Left, Vector2fx::Right, Vector2fx::Zero, Vector2fx::Up));
+
+		// Collinear segments only intersect when they overlap
+		REQUIRE(Mathfx::SegmentsIntersect(Vector2fx::Zero, Vector2fx(2_fx, 0_fx), Vector2fx::Right, Vector2fx(3_fx, 0_fx)));
+		REQUIRE_FALSE(Mathfx::SegmentsIntersect(Vector2fx::Zero, Vector2fx::Right, Vector2fx(2_fx, 0_fx), Vector2fx(3_fx, 0_fx)));
+
+		// Long nearly parallel segments one raw unit apart never touch
+		const int64_t big = static_cast<int64_t>(1) << 61;
+		REQUIRE_FALSE(Mathfx::SegmentsIntersect(raw(-big, -big), raw(big, big - 2), raw(-big, -big + 1), raw(big, big - 1)));
+		REQUIRE(Mathfx::SegmentsIntersect(raw(-big, -big), raw(big, big - 2), raw(-big, -big + 1), raw(big, big - 3)));
+	}
+
+	SECTION("InCircle")
+	{
+		REQUIRE(Mathfx::InCircle(Vector2fx::Right, Vector2fx::Up, Vector2fx::Left, Vector2fx::Zero) == 1);
+		REQUIRE(Mathfx::InCircle(Vector2fx::Right, Vector2fx::Up, Vector2fx::Left, Vector2fx::Down) == 0);
+		REQUIRE(Mathfx::InCircle(Vector2fx::Right, Vector2fx::Up, Vector2fx::Left, Vector2fx(2_fx, 0_fx)) == -1);
+		REQUIRE(Mathfx::InCircle(Vector2fx::Up, Vector2fx::Right, Vector2fx::Left, Vector2fx::Zero) == -1);
+
+		// Same circle scaled close to the coordinate limit, terms reach 2^250 and a single raw unit still decides it
+		const int64_t r = static_cast<int64_t>(1) << 61;
+		REQUIRE(Mathfx::InCircle(raw(r, 0), raw(0, r), raw(-r, 0), raw(0, -r)) == 0);
+		REQUIRE(Mathfx::InCircle(raw(r, 0), raw(0, r), raw(-r, 0), raw(0, -r + 1)) == 1);
+		REQUIRE(Mathfx::InCircle(raw(r, 0), raw(0, r), raw(-r, 0), raw(0, -r - 1)) == -1);
+
+		// Tiny raw coordinates fit the determinant in int64, compare against it
+		const fixed64 small = fixed64(static_cast<int64_t>(1) << 12);
+		for (int i = 0; i < 10000; ++i)
+		{
+			Vector2fx p[4];
+			for (auto& v : p)
+			{
+				v = Vector2fx(random_fixed(small), random_fixed(small));
+			}
+			int64_t d[3][2];
+			int64_t lift[3];
+			for (int j = 0; j < 3; ++j)
+			{
+				d[j][0] = p[j].x.rawValue - p[3].x.rawValue;
+				d[j][1] = p[j].y.rawValue - p[3].y.rawValue;
+				lift[j] = d[j][0] * d[j][0] + d[j][1] * d[j][1];
+			}
+			int64_t det = lift[0] * (d[1][0] * d[2][1] - d[1][1] * d[2][0])
+				+ lift[1] * (d[2][0] * d[0][1] - d[2][1] * d[0][0])
+				+ lift[2] * (d[0][0] * d[1][1] - d[0][1] * d[1][0]);
+			REQUIRE(Mathfx::InCircle(p[0], p[1], p[2], p[3]) == (det > 0) - (det < 0));
+
+			// Swapping two points flips the sign at any scale
+			Vector2fx q[4];
+			for (auto& v : q)
+			{
+				v = Vector2fx(fixed64(static_cast<int64_t>(G.rng() >> 3) - (static_cast<int64_t>(1) << 60)),
+					fixed64(static_cast<int64_t>(G.rng() >> 3) - (static_cast<int64_t>(1) << 60)));
+			}
+			REQUIRE(Mathfx::InCircle(q[0], q[1], q[2], q[3]) == -Mathfx::InCircle(q[1], q[0], q[2], q[3]));
+		}
+	}
+}
+
+TEST_CASE("Shapes", "[fixedmath]")
+{
+	SECTION("Aabb2fx")
+	{
+		Aabb2fx a(Vector2fx::Zero, Vector2fx(2_fx, 2_fx));
+		Aabb2fx b(Vector2fx::One, Vector2fx(3_fx, 3_fx));
+		Aabb2fx c(Vector2fx(2_fx, 0_fx), Vector2fx(4_fx, 1_fx));
+		Aabb2fx d(Vector2fx(5_fx, 5_fx), Vector2fx(6_fx, 6_fx));
+
+		REQUIRE(Aabb2fx::Overlaps(a, b));
+		REQUIRE(Aabb2fx::Overlaps(a, c));
+		REQUIRE_FALSE(Aabb2fx::Overlaps(a, d));
+		REQUIRE(Aabb2fx::Contains(a, Vector2fx::One));
+		REQUIRE(Aabb2fx::Contains(a, Vector2fx(2_fx, 0_fx)));
+		REQUIRE_FALSE(Aabb2fx::Contains(a, Vector2fx(3_fx, 0_fx)));
+		REQUIRE(Aabb2fx::Contains(a, Aabb2fx(Vector2fx::One, Vector2fx(2_fx, 2_fx))));
+		REQUIRE_FALSE(Aabb2fx::Contains(a, b));
+
+		Aabb2fx u = Aabb2fx::Union(a, d);
+		REQUIRE(u == Aabb2fx(Vector2fx::Zero, Vector2fx(6_fx, 6_fx)));
+		REQUIRE(Aabb2fx::Union(a, Vector2fx(-1_fx, 5_fx)) == Aabb2fx(Vector2fx(-1_fx, 0_fx), Vector2fx(2_fx, 5_fx)));
+		REQUIRE(Aabb2fx::Expand(a, 1_fx) == Aabb2fx(Vector2fx(-1_fx, -1_fx), Vector2fx(3_fx, 3_fx)));
+		REQUIRE(Aabb2fx::FromCenterExtents(Vector2fx::One, Vector2fx::One) == a);
+		REQUIRE(a.Center() == Vector2fx::One);
+		REQUIRE(a.Extents() == Vector2fx::One);
+		REQUIRE(a.Area() == 4_fx);
+		REQUIRE(a.Perimeter() == 8_fx);
+	}
+
+	SECTION("Circle2fx")
+	{
+		Circle2fx a(Vector2fx::Zero, 2_fx);
+		Circle2fx b(Vector2fx(3_fx, 0_fx), 1_fx);
+		Circle2fx c(Vector2fx(3_fx, 3_fx), 1_fx);
+
+		REQUIRE(Circle2fx::Overlaps(a, b));
+		REQUIRE_FALSE(Circle2fx::Overlaps(a, c));
+		REQUIRE(Circle2fx::Overlaps(a, Aabb2fx(Vector2fx(2_fx, -1_fx), Vector2fx(3_fx, 1_fx))));
+		REQUIRE_FALSE(Circle2fx::Overlaps(a, Aabb2fx(Vector2fx(2_fx, 2_fx), Vector2fx(3_fx, 3_fx))));
+		REQUIRE(Circle2fx::Contains(a, Vector2fx(0_fx, 2_fx)));
+		REQUIRE_FALSE(Circle2fx::Contains(a, Vector2fx(2_fx, 2_fx)));
+		REQUIRE(Circle2fx::Contains(a, Circle2fx(Vector2fx::Right, 1_fx)));
+		REQUIRE_FALSE(Circle2fx::Contains(a, b));
+
+		Circle2fx u = Circle2fx::Union(a, b);
+		REQUIRE(u == Circle2fx(Vector2fx::Right, 3_fx));
+		REQUIRE(Circle2fx::Union(a, Circle2fx(Vector2fx::Right, 1_fx)) == a);
+		REQUIRE(Circle2fx::Expand(b, 1_fx).radius == 2_fx);
+		REQUIRE(a.Bounds() == Aabb2fx(Vector2fx(-2_fx, -2_fx), Vector2fx(2_fx, 2_fx)));
+	}
+
+	SECTION("OverlapsBatch")
+	{
+		// Odd length so both the four wide blocks and the scalar tail run, integer sizes so plenty of cases touch exactly
+		constexpr size_t kCount = 203;
+		std::vector<Aabb2fx> boxes(kCount);
+		std::vector<Circle2fx> circles(kCount);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			Vector2fx center(fixed64::Int(static_cast<int>(G.rng() % 41) - 20), fixed64::Int(static_cast<int>(G.rng() % 41) - 20));
+			Vector2fx extents(fixed64::Int(static_cast<int>(G.rng() % 5)), fixed64::Int(static_cast<int>(G.rng() % 5)));
+			boxes[i] = (i % 5 == 0) ? Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(20_fx64), random_fixed(20_fx64)), extents)
+				: Aabb2fx::FromCenterExtents(center, extents);
+			circles[i] = Circle2fx(center, (i % 5 == 0) ? random_pos_fixed(5_fx64) : extents.x);
+		}
+
+		std::vector<uint64_t> mask(Mathfx::BitmaskWordCount(kCount), ~static_cast<uint64_t>(0));
+		for (int query = 0; query < 20; ++query)
+		{
+			Aabb2fx box = boxes[query];
+			Aabb2fx::OverlapsBatch(box, boxes, mask);
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				REQUIRE(((mask[i >> 6] >> (i & 63)) & 1) == static_cast<uint64_t>(Aabb2fx::Overlaps(box, boxes[i])));
+			}
+			REQUIRE((mask.back() >> (kCount & 63)) == 0);
+
+			Circle2fx circle = circles[query];
+			Circle2fx::OverlapsBatch(circle, circles, mask);
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				REQUIRE(((mask[i >> 6] >> (i & 63)) & 1) == static_cast<uint64_t>(Circle2fx::Overlaps(circle, circles[i])));
+			}
+
+			Circle2fx::OverlapsBatch(circle, std::span<const Aabb2fx>(boxes), mask);
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				REQUIRE(((mask[i >> 6] >> (i & 63)) & 1) == static_cast<uint64_t>(Circle2fx::Overlaps(circle, boxes[i])));
+			}
+		}
+	}
+}
+
+TEST_CASE("SpatialGrid2fx", "[fixedmath]")
+{
+	auto bruteForce = [](const std::vector<std::pair<uint32_t, Vector2fx>>& points, const Vector2fx& center, fixed64 radius) {
+		std::vector<uint32_t> result;
+		for (const auto& [index, position] : points)
+		{
+			if (Vector2fx::DistanceSquared(position, center) <= radius * radius)
+			{
+				result.push_back(index);
+			}
+		}
+		std::ranges::sort(result);
+		return result;
+	};
+
+	SECTION("CellOf")
+	{
+		SpatialGrid2fx shifted(4_fx64);
+		REQUIRE(shifted.CellOf(Vector2fx(5_fx64, -0.5_fx64)).x == 1);
+		REQUIRE(shifted.CellOf(Vector2fx(5_fx64, -0.5_fx64)).y == -1);
+		REQUIRE(shifted.CellOf(Vector2fx(-4_fx64, 4_fx64)).x == -1);
+		REQUIRE(shifted.CellOf(Vector2fx(-4_fx64, 4_fx64)).y == 1);
+
+		SpatialGrid2fx divided(3_fx64);
+		REQUIRE(divided.CellOf(Vector2fx(5_fx64, -0.5_fx64)).x == 1);
+		REQUIRE(divided.CellOf(Vector2fx(5_fx64, -0.5_fx64)).y == -1);
+		REQUIRE(divided.CellOf(Vector2fx(-3_fx64, 6_fx64)).x == -1);
+		REQUIRE(divided.CellOf(Vector2fx(-3_fx64, 6_fx64)).y == 2);
+		for (int i = 0; i < 1000; ++i)
+		{
+			Vector2fx p(random_fixed(), random_fixed());
+			REQUIRE(divided.CellOf(p).x == Mathfx::FloorToInt(p.x / 3_fx64));
+			REQUIRE(shifted.CellOf(p).y == Mathfx::FloorToInt(p.y / 4_fx64));
+		}
+	}
+
+	SECTION("Rebuild/QueryRadius")
+	{
+		constexpr size_t kCount = 2000;
+		std::vector<Vector2fx> positions(kCount);
+		std::ranges::generate(positions, []() { return Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)); });
+		std::vector<std::pair<uint32_t, Vector2fx>> points;
+		for (uint32_t i = 0; i < kCount; ++i)
+		{
+			points.emplace_back(i, positions[i]);
+		}
+
+		for (fixed64 cellSize : { 8_fx64, 5_fx64, 0.75_fx64 })
+		{
+			SpatialGrid2fx grid(cellSize);
+			grid.Rebuild(positions);
+			REQUIRE(grid.Size() == kCount);
+
+			std::vector<uint32_t> result;
+			for (int query = 0; query < 50; ++query)
+			{
+				Vector2fx center(random_fixed(110_fx64), random_fixed(110_fx64));
+				fixed64 radius = (query == 0) ? 500_fx64 : random_pos_fixed(15_fx64);
+				result.clear();
+				grid.QueryRadius(center, radius, result);
+				std::ranges::sort(result);
+				REQUIRE(result == bruteForce(points, center, radius));
+			}
+		}
+	}
+
+	SECTION("Insert/Remove/Move")
+	{
+		SpatialGrid2fx grid(2_fx64);
+		std::vector<std::pair<uint32_t, Vector2fx>> points;
+		std::vector<uint32_t> result;
+		for (int step = 0; step < 5000; ++step)
+		{
+			uint32_t op = static_cast<uint32_t>(G.rng() % 4);
+			Vector2fx position(random_fixed(30_fx64), random_fixed(30_fx64));
+			if (points.empty() || op == 0)
+			{
+				uint32_t index = static_cast<uint32_t>(step) * 3;
+				grid.Insert(index, position);
+				points.emplace_back(index, position);
+			}
+			else
+			{
+				size_t pick = G.rng() % points.size();
+				if (op == 1)
+				{
+					grid.Remove(points[pick].first);
+					REQUIRE_FALSE(grid.Contains(points[pick].first));
+					points[pick] = points.back();
+					points.pop_back();
+				}
+				else
+				{
+					// Half the moves are small steps that usually stay in the same cell
+					if (op == 2)
+					{
+						position = points[pick].second + Vector2fx(random_fixed(0.5_fx64), random_fixed(0.5_fx64));
+					}
+					grid.Move(points[pick].first, position);
+					points[pick].second = position;
+				}
+			}
+			REQUIRE(grid.Size() == points.size());
+
+			if (step % 50 == 0)
+			{
+				Vector2fx center(random_fixed(30_fx64), random_fixed(30_fx64));
+				fixed64 radius = random_pos_fixed(8_fx64);
+				result.clear();
+				grid.QueryRadius(center, radius, result);
+				std::ranges::sort(result);
+				REQUIRE(result == bruteForce(points, center, radius));
+			}
+		}
+	}
+}
+
+TEST_CASE("AabbTree2fx", "[fixedmath]")
+{
+	auto randomBox = []() {
+		Vector2fx center(random_fixed(100_fx64), random_fixed(100_fx64));
+		// Mix of tiny and very large objects
+		fixed64 size = (G.rng() % 10 == 0) ? random_pos_fixed(40_fx64) : random_norm_fixed() * 3_fx64;
+		return Aabb2fx::FromCenterExtents(center, Vector2fx(size, size >> 1));
+	};
+
+	AabbTree2fx tree;
+	std::vector<int32_t> proxies;
+	for (uint32_t i = 0; i < 500; ++i)
+	{
+		proxies.push_back(tree.Insert(randomBox(), i));
+	}
+	REQUIRE(tree.Size() == 500);
+	REQUIRE(tree.Validate());
+	REQUIRE(tree.Height() < 20);
+
+	// Mix of small moves inside the margin, big moves and removals
+	for (size_t i = 0; i < proxies.size(); i += 3)
+	{
+		tree.Move(proxies[i], randomBox(), Vector2fx(random_fixed(2_fx64), random_fixed(2_fx64)));
+	}
+	Aabb2fx inside = Aabb2fx::Expand(tree.FatAabb(proxies[1]), -tree.Margin());
+	REQUIRE_FALSE(tree.Move(proxies[1], inside));
+	for (size_t i = 2; i < proxies.size(); i += 7)
+	{
+		tree.Remove(proxies[i]);
+		proxies[i] = AabbTree2fx::NullNode;
+	}
+	std::erase(proxies, AabbTree2fx::NullNode);
+	REQUIRE(tree.Validate());
+	REQUIRE(tree.Size() == proxies.size());
+	REQUIRE(tree.UserData(proxies[0]) == 0);
+
+	SECTION("Query")
+	{
+		std::vector<int32_t> result;
+		for (int query = 0; query < 50; ++query)
+		{
+			Aabb2fx box = randomBox();
+			result.clear();
+			tree.Query(box, result);
+			std::ranges::sort(result);
+
+			std::vector<int32_t> expected;
+			for (int32_t proxy : proxies)
+			{
+				if (Aabb2fx::Overlaps(tree.FatAabb(proxy), box))
+				{
+					expected.push_back(proxy);
+				}
+			}
+			std::ranges::sort(expected);
+			REQUIRE(result == expected);
+		}
+	}
+
+	SECTION("OverlapPairs")
+	{
+		std::vector<std::pair<int32_t, int32_t>> pairs;
+		tree.OverlapPairs(pairs);
+		std::ranges::sort(pairs);
+
+		std::vector<std::pair<int32_t, int32_t>> expected;
+		for (int32_t a : proxies)
+		{
+			for (int32_t b : proxies)
+			{
+				if (a < b && Aabb2fx::Overlaps(tree.FatAabb(a), tree.FatAabb(b)))
+				{
+					expected.emplace_back(a, b);
+				}
+			}
+		}
+		std::ranges::sort(expected);
+		REQUIRE(pairs == expected);
+	}
+
+	SECTION("RayCast")
+	{
+		// Reference slab test in double, segments are random so exact grazing hits don't come up
+		auto segmentHitsBox = [](const Vector2fx& from, const Vector2fx& to, const Aabb2fx& box) {
+			double t0 = 0.0, t1 = 1.0;
+			double p[2] = { static_cast<double>(from.x), static_cast<double>(from.y) };
+			double d[2] = { static_cast<double>(to.x) - p[0], static_cast<double>(to.y) - p[1] };
+			double lo[2] = { static_cast<double>(box.min.x), static_cast<double>(box.min.y) };
+			double hi[2] = { static_cast<double>(box.max.x), static_cast<double>(box.max.y) };
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				if (d[axis] == 0.0)
+				{
+					if (p[axis] < lo[axis] || p[axis] > hi[axis]) return false;
+					continue;
+				}
+				double a = (lo[axis] - p[axis]) / d[axis];
+				double b = (hi[axis] - p[axis]) / d[axis];
+				t0 = std::max(t0, std::min(a, b));
+				t1 = std::min(t1, std::max(a, b));
+			}
+			return t0 <= t1;
+		};
+
+		std::vector<int32_t> result;
+		for (int ray = 0; ray < 50; ++ray)
+		{
+			Vector2fx from(random_fixed(120_fx64), random_fixed(120_fx64));
+			Vector2fx to(random_fixed(120_fx64), random_fixed(120_fx64));
+			result.clear();
+			tree.RayCast(from, to, result);
+			std::ranges::sort(result);
+
+			std::vector<int32_t> expected;
+			for (int32_t proxy : proxies)
+			{
+				if (segmentHitsBox(from, to, tree.FatAabb(proxy)))
+				{
+					expected.push_back(proxy);
+				}
+			}
+			std::ranges::sort(expected);
+			REQUIRE(result == expected);
+		}
+
+		// Stopping early
+		size_t calls = 0;
+		tree.RayCast(Vector2fx(-200_fx64, 0_fx64), Vector2fx(200_fx64, 0_fx64), [&calls](int32_t) { return ++calls < 2; });
+		REQUIRE(calls <= 2);
+	}
+}
+
+TEST_CASE("Radix Sort", "[fixedmath]")
+{
+	SECTION("RadixSort")
+	{
+		std::vector<fixed64> values;
+		for (auto raw : testCases)
+		{
+			values.push_back(fixed64(raw));
+		}
+		for (int i = 0; i < 5000; ++i)
+		{
+			values.push_back(random_fixed());
+		}
+		values.push_back(fixed64::MinValue);
+		values.push_back(fixed64::MaxValue);
+
+		std::vector<fixed64> expected = values;
+		std::ranges::sort(expected);
+		Mathfx::RadixSort(std::span(values));
+		REQUIRE(values == expected);
+
+		// Narrow range, most passes are skipped
+		std::vector<fixed64> small(1000);
+		std::ranges::generate(small, []() { return fixed64(static_cast<int64_t>(G.rng() % 200)); });
+		expected = small;
+		std::ranges::sort(expected);
+		Mathfx::RadixSort(std::span(small));
+		REQUIRE(small == expected);
+
+		std::vector<fixed32> narrow(1000);
+		std::ranges::generate(narrow, []() { return fixed32(static_cast<int32_t>(G.rng())); });
+		std::vector<fixed32> narrowExpected = narrow;
+		std::ranges::sort(narrowExpected);
+		Mathfx::RadixSort(std::span(narrow));
+		REQUIRE(narrow == narrowExpected);
+	}
+
+	SECTION("RadixSortByKey")
+	{
+		constexpr uint32_t kCount = 3000;
+		std::vector<fixed64> keys(kCount);
+		std::ranges::generate(keys, []() { return fixed64::Int(static_cast<int>(G.rng() % 100) - 50); });
+		std::vector<uint32_t> indices(kCount);
+		std::iota(indices.begin(), indices.end(), 0u);
+
+		std::vector<uint32_t> expected = indices;
+		std::ranges::stable_sort(expected, [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+		std::vector<fixed64> sortedKeys = keys;
+		Mathfx::RadixSortByKey(std::span(sortedKeys), std::span(indices));
+		REQUIRE(indices == expected);
+		for (uint32_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(sortedKeys[i] == keys[indices[i]]);
+		}
+	}
+
+	SECTION("SweepAndPrune2fx")
+	{
+		constexpr size_t kCount = 400;
+		std::vector<Aabb2fx> boxes(kCount);
+		std::ranges::generate(boxes, []() {
+			return Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(100_fx64), random_fixed(100_fx64)),
+				Vector2fx(random_pos_fixed(6_fx64), random_pos_fixed(6_fx64)));
+		});
+
+		auto bruteForce = [&boxes]() {
+			std::vector<std::pair<uint32_t, uint32_t>> pairs;
+			for (uint32_t a = 0; a < boxes.size(); ++a)
+			{
+				for (uint32_t b = a + 1; b < boxes.size(); ++b)
+				{
+					if (Aabb2fx::Overlaps(boxes[a], boxes[b]))
+					{
+						pairs.emplace_back(a, b);
+					}
+				}
+			}
+			return pairs;
+		};
+
+		SweepAndPrune2fx sap;
+		std::vector<std::pair<uint32_t, uint32_t>> pairs;
+		for (int tick = 0; tick < 20; ++tick)
+		{
+			// Small steps every tick so the order is repaired, one big shuffle to force the radix sort fallback
+			for (Aabb2fx& box : boxes)
+			{
+				Vector2fx step = (tick == 10) ? Vector2fx(random_fixed(100_fx64), 0_fx64) : Vector2fx(random_fixed(1_fx64), random_fixed(1_fx64));
+				box = Aabb2fx(box.min + step, box.max + step);
+			}
+			sap.Update(boxes);
+
+			std::vector<uint32_t> expectedOrder(kCount);
+			std::iota(expectedOrder.begin(), expectedOrder.end(), 0u);
+			std::ranges::sort(expectedOrder, [&boxes](uint32_t a, uint32_t b) {
+				return boxes[a].min.x < boxes[b].min.x || (boxes[a].min.x == boxes[b].min.x && a < b);
+			});
+			REQUIRE(std::ranges::equal(sap.Order(), expectedOrder));
+
+			pairs.clear();
+			sap.FindPairs(pairs);
+			std::ranges::sort(pairs);
+			REQUIRE(pairs == bruteForce());
+		}
+	}
+}
+
+TEST_CASE("Parallel Reductions", "[fixedmath]")
+{
+	// Not a multiple of the chunk size so the last chunk is short
+	constexpr size_t kCount = Mathfx::ParallelChunkSize * 5 + 123;
+	std::vector<fixed64> a(kCount);
+	std::vector<fixed64> b(kCount);
+	std::ranges::generate(a, []() { return random_fixed(); });
+	std::ranges::generate(b, []() { return random_fixed(); });
+
+	FixedAccumulator<int64_t, 32> serialSum;
+	FixedAccumulator<int64_t, 32> serialDot;
+	fixed64 wrappingSum = fixed64::Zero;
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		serialSum.Add(a[i]);
+		serialDot.MulAdd(a[i], b[i]);
+		wrappingSum += a[i];
+	}
+	const auto [serialMin, serialMax] = std::ranges::minmax(a);
+
+	for (size_t threads : { 1, 2, 3, 8 })
+	{
+		Mathfx::ThreadPool pool(threads);
+		REQUIRE(pool.ThreadCount() == threads);
+
+		fixed64 sum = Mathfx::ParallelSum(std::span(a), pool);
+		REQUIRE(sum == serialSum.SaturatedResult());
+		REQUIRE(sum == wrappingSum);
+		REQUIRE(Mathfx::ParallelDot(std::span(a), std::span(b), pool) == serialDot.SaturatedResult());
+
+		auto [low, high] = Mathfx::ParallelMinMax(std::span(a), pool);
+		REQUIRE(low == serialMin);
+		REQUIRE(high == serialMax);
+	}
+
+	SECTION("Concurrent callers")
+	{
+		// Two outside threads sharing a pool must each get their own complete result
+		Mathfx::ThreadPool shared(4);
+		for (Mathfx::ThreadPool* pool : { &Mathfx::DefaultThreadPool(), &shared })
+		{
+			std::vector<fixed64> sums(2 * 50);
+			std::vector<fixed64> dots(2 * 50);
+			auto caller = [&](size_t first) {
+				for (size_t i = first; i < first + 50; ++i)
+				{
+					sums[i] = Mathfx::ParallelSum(std::span(a), *pool);
+					dots[i] = Mathfx::ParallelDot(std::span(a), std::span(b), *pool);
+				}
+			};
+			std::thread left(caller, 0);
+			std::thread right(caller, 50);
+			left.join();
+			right.join();
+			REQUIRE(std::ranges::all_of(sums, [&](fixed64 sum) { return sum == wrappingSum; }));
+			REQUIRE(std::ranges::all_of(dots, [&](fixed64 dot) { return dot == serialDot.SaturatedResult(); }));
+		}
+	}
+
+	SECTION("Saturation")
+	{
+		// Partial sums run far past the range of fixed64 and come back, only the final total is clamped
+		std::vector<fixed64> values(kCount, fixed64::MaxValue);
+		REQUIRE(Mathfx::ParallelSum(std::span(values)) == fixed64::MaxValue);
+		values[kCount - 1] = fixed64::MinValue;
+		std::fill(values.begin() + kCount / 2, values.end(), fixed64::MinValue);
+		REQUIRE(Mathfx::ParallelSum(std::span(values)) == fixed64::MinValue);
+		std::fill(values.begin(), values.end(), fixed64::Zero);
+		values[0] = fixed64::MaxValue;
+		values[1] = fixed64::MaxValue;
+		values[kCount - 1] = -fixed64::MaxValue;
+		REQUIRE(Mathfx::ParallelSum(std::span(values)) == fixed64::MaxValue);
+
+		std::vector<fixed64> big(kCount, 1000000_fx64);
+		REQUIRE(Mathfx::ParallelDot(std::span(big), std::span(big)) == fixed64::MaxValue);
+
+		// fixed32 values are widened by 2^16 and products reach 2^62, the sums have to get past 64 bits and back as well
+		std::vector<fixed32> values32(70000, fixed32::MaxValue);
+		REQUIRE(Mathfx::ParallelSum(std::span(values32)) == fixed32::MaxValue);
+		std::fill(values32.begin() + values32.size() / 4, values32.end(), fixed32::MinValue);
+		REQUIRE(Mathfx::ParallelSum(std::span(values32)) == fixed32::MinValue);
+		std::ranges::fill(values32, fixed32::MinValue);
+		REQUIRE(Mathfx::ParallelSum(std::span(values32)) == fixed32::MinValue);
+
+		std::vector<fixed32> full(kCount, fixed32::MaxValue);
+		std::vector<fixed32> signs(kCount, fixed32::MaxValue);
+		REQUIRE(Mathfx::ParallelDot(std::span(full), std::span(signs)) == fixed32::MaxValue);
+		std::fill(signs.begin() + kCount / 2, signs.end(), -fixed32::MaxValue);
+		if (kCount % 2 == 1)
+		{
+			signs.back() = fixed32::Zero;
+		}
+		REQUIRE(Mathfx::ParallelDot(std::span(full), std::span(signs)) == fixed32::Zero);
+		signs[kCount / 2] = fixed32::MaxValue;
+		REQUIRE(Mathfx::ParallelDot(std::span(full), std::span(signs)) == fixed32::MaxValue);
+	}
+
+	SECTION("Empty")
+	{
+		std::vector<fixed64> empty;
+		REQUIRE(Mathfx::ParallelSum(std::span(empty)) == fixed64::Zero);
+		auto [low, high] = Mathfx::ParallelMinMax(std::span(empty));
+		REQUIRE(low == fixed64::MaxValue);
+		REQUIRE(high == fixed64::MinValue);
+	}
+}
+
+TEST_CASE("Parallel Transform", "[fixedmath]")
+{
+	constexpr size_t kCount = Mathfx::ParallelChunkSize * 3 + 77;
+	std::vector<fixed64> values(kCount);
+	std::ranges::generate(values, []() { return random_pos_fixed(); });
+	std::vector<Vector2fx> vecs(kCount);
+	std::ranges::generate(vecs, []() { return Vector2fx(random_fixed(), random_fixed()); });
+
+	std::vector<fixed64> serialSqrt(kCount);
+	std::vector<fixed64> serialSin(kCount);
+	std::vector<Vector2fx> serialNormalized(kCount);
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		serialSqrt[i] = Mathfx::FastSqrt(values[i]);
+		serialSin[i] = Mathfx::Sin(values[i]);
+		serialNormalized[i] = Vector2fx::Normalize(vecs[i]);
+	}
+
+	for (size_t threads : { 1, 2, 5 })
+	{
+		Mathfx::ThreadPool pool(threads);
+		std::vector<fixed64> out(kCount);
+
+		Mathfx::ParallelTransform(std::span(values), std::span(out), [](fixed64 x) { return Mathfx::FastSqrt(x); }, pool);
+		REQUIRE(out == serialSqrt);
+
+		std::ranges::fill(out, fixed64::Zero);
+		Mathfx::ParallelBatch(std::span(values), std::span(out), [](auto in, auto result) { Mathfx::FastSqrtBatch<int64_t, 32>(in, result); }, pool);
+		REQUIRE(out == serialSqrt);
+
+		Mathfx::ParallelBatch(std::span(values), std::span(out), [](auto in, auto result) { Mathfx::SinBatch<int64_t, 32>(in, result); }, pool);
+		REQUIRE(out == serialSin);
+
+		std::vector<Vector2fx> normalized(kCount);
+		Mathfx::ParallelBatch(std::span(vecs), std::span(normalized), [](auto in, auto result) { Vector2fx::NormalizeBatch(in, result); }, pool);
+		REQUIRE(normalized == serialNormalized);
+
+		// In place, and a nested parallel call from inside a chunk runs inline
+		std::vector<fixed64> inPlace = values;
+		Mathfx::ParallelTransform(std::span(inPlace), std::span(inPlace), [&pool](fixed64 x) {
+			fixed64 result;
+			pool.ParallelFor(2, [&](size_t) { result = Mathfx::FastSqrt(x); });
+			return result;
+		}, pool);
+		REQUIRE(inPlace == serialSqrt);
+	}
+}
+
+TEST_CASE("Integrator2fx", "[fixedmath]")
+{
+	REQUIRE(Mathfx::Exp(fixed64::Zero) == fixed64::One);
+	REQUIRE(std::abs(static_cast<double>(Mathfx::Exp(fixed64::One)) - 2.718281828) < 1e-6);
+	REQUIRE(std::abs(static_cast<double>(Mathfx::Exp(-2_fx64)) - 0.135335283) < 1e-6);
+
+	constexpr size_t kCount = Mathfx::ParallelChunkSize * 2 + 13;
+	const fixed64 dt = fixed64::One / 60_fx64;
+
+	std::vector<Vector2fx> positions(kCount);
+	std::vector<Vector2fx> velocities(kCount);
+	std::vector<Vector2fx> accelerations(kCount);
+	std::vector<fixed64> damping(kCount);
+	std::ranges::generate(positions, []() { return Vector2fx(random_fixed(), random_fixed()); });
+	std::ranges::generate(velocities, []() { return Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)); });
+	std::ranges::generate(accelerations, []() { return Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)); });
+	std::ranges::generate(damping, []() { return random_pos_fixed(2_fx64); });
+
+	std::vector<fixed64> expectedFactors(kCount);
+	for (size_t i = 0; i < kCount; ++i)
+	{
+		expectedFactors[i] = Mathfx::Exp(-(damping[i] * dt));
+	}
+
+	for (size_t threads : { 1, 2, 3 })
+	{
+		Mathfx::ThreadPool pool(threads);
+
+		std::vector<fixed64> factors(kCount);
+		Integrator2fx::DampingFactors(damping, dt, factors, pool);
+		REQUIRE(factors == expectedFactors);
+
+		for (bool damped : { false, true })
+		{
+			const std::span<const fixed64> stepFactors = damped ? std::span<const fixed64>(factors) : std::span<const fixed64>();
+
+			// A few steps, each entity compared against the same expression on a plain Vector2fx
+			Vector2fxSoA p(positions);
+			Vector2fxSoA v(velocities);
+			const Vector2fxSoA a(accelerations);
+			std::vector<Vector2fx> expectedP = positions;
+			std::vector<Vector2fx> expectedV = velocities;
+			for (int step = 0; step < 3; ++step)
+			{
+				Integrator2fx::SemiImplicitEuler(p, v, a, dt, stepFactors, pool);
+				for (size_t i = 0; i < kCount; ++i)
+				{
+					expectedV[i] = (expectedV[i] + accelerations[i] * dt) * (damped ? factors[i] : fixed64::One);
+					expectedP[i] += expectedV[i] * dt;
+				}
+			}
+			REQUIRE(p.ToAoS() == expectedP);
+			REQUIRE(v.ToAoS() == expectedV);
+
+			Vector2fxSoA q(kCount);
+			p = Vector2fxSoA(positions);
+			std::vector<Vector2fx> expectedQ(kCount);
+			for (size_t i = 0; i < kCount; ++i)
+			{
+				expectedQ[i] = positions[i] - velocities[i] * dt;
+				q[i] = expectedQ[i];
+			}
+			expectedP = positions;
+			for (int step = 0; step < 3; ++step)
+			{
+				Integrator2fx::Verlet(p, q, a, dt, stepFactors, pool);
+				for (size_t i = 0; i < kCount; ++i)
+				{
+					const Vector2fx next = expectedP[i] + (expectedP[i] - expectedQ[i]) * (damped ? factors[i] : fixed64::One)
+						+ accelerations[i] * (dt * dt);
+					expectedQ[i] = expectedP[i];
+					expectedP[i] = next;
+				}
+			}
+			REQUIRE(p.ToAoS() == expectedP);
+			REQUIRE(q.ToAoS() == expectedQ);
+		}
+	}
+
+	// Constant acceleration from rest, both steppers should land close to the analytic p = a t^2 / 2 after one second
+	Vector2fxSoA p(1);
+	Vector2fxSoA v(1);
+	Vector2fxSoA q(1);
+	Vector2fxSoA a(1);
+	a[0] = Vector2fx(0_fx64, -10_fx64);
+	for (int step = 0; step < 60; ++step)
+	{
+		Integrator2fx::SemiImplicitEuler(p, v, a, dt);
+	}
+	REQUIRE(std::abs(static_cast<double>(p[0].y) + 5.0) < 0.1);
+	REQUIRE(std::abs(static_cast<double>(v[0].y) + 10.0) < 1e-3);
+}
+
+TEST_CASE("Collision2fx", "[fixedmath]")
+{
+	const fixed64 kMargin = fixed64::One >> 12;
+	auto near = [&](const Vector2fx& a, const Vector2fx& b) {
+		return Mathfx::Abs(a.x - b.x) < kMargin && Mathfx::Abs(a.y - b.y) < kMargin;
+	};
+
+	const Polygon2fx box = Polygon2fx::Box(Vector2fx::One);
+	Manifold2fx manifold;
+
+	SECTION("Polygon construction")
+	{
+		const std::array<Vector2fx, 3> points = { Vector2fx(0_fx64, 0_fx64), Vector2fx(2_fx64, 0_fx64), Vector2fx(0_fx64, 2_fx64) };
+		const Polygon2fx triangle(points);
+		REQUIRE(triangle.count == 3);
+		REQUIRE(triangle.normals[0] == Vector2fx::Down);
+		REQUIRE(near(triangle.normals[1], Vector2fx(0.70710678_fx64, 0.70710678_fx64)));
+		REQUIRE(triangle.normals[2] == Vector2fx::Left);
+		REQUIRE(triangle.Bounds() == Aabb2fx(Vector2fx::Zero, Vector2fx(2_fx64, 2_fx64)));
+
+		REQUIRE(box.Support(Vector2fx::Right) == 1);
+		REQUIRE(box.Support(Vector2fx(-1_fx64, -1_fx64)) == 0);
+		REQUIRE(box.Support(Vector2fx::Up) == 2);
+
+		const Polygon2fx moved = Polygon2fx::Transform(box, Rotation2fx::Identity, Vector2fx(3_fx64, 0_fx64));
+		REQUIRE(moved.Bounds() == Aabb2fx(Vector2fx(2_fx64, -1_fx64), Vector2fx(4_fx64, 1_fx64)));
+		REQUIRE(moved.normals == box.normals);
+	}
+
+	SECTION("Polygon vs polygon")
+	{
+		const Polygon2fx other = Polygon2fx::FromAabb(Aabb2fx(Vector2fx(0.75_fx64, -0.5_fx64), Vector2fx(2.75_fx64, 0.5_fx64)));
+		REQUIRE(Collision2fx::Collide(box, other, manifold));
+		REQUIRE(manifold.normal == Vector2fx::Right);
+		REQUIRE(manifold.depth == 0.25_fx64);
+		REQUIRE(manifold.pointCount == 2);
+		for (int i = 0; i < 2; ++i)
+		{
+			REQUIRE(manifold.points[i].depth == 0.25_fx64);
+			REQUIRE(manifold.points[i].position.x == 0.75_fx64);
+		}
+		REQUIRE(manifold.points[0].position.y + manifold.points[1].position.y == 0_fx64);
+		REQUIRE(manifold.points[0].id != manifold.points[1].id);
+
+		REQUIRE(Collision2fx::Collide(other, box, manifold));
+		REQUIRE(manifold.normal == Vector2fx::Left);
+		REQUIRE(manifold.depth == 0.25_fx64);
+
+		// Touching counts, separated leaves the manifold alone
+		REQUIRE(Collision2fx::Collide(box, Polygon2fx::FromAabb(Aabb2fx(Vector2fx(1_fx64, -0.5_fx64), Vector2fx(2_fx64, 0.5_fx64))), manifold));
+		REQUIRE(manifold.depth == 0_fx64);
+		manifold.depth = 7_fx64;
+		REQUIRE(!Collision2fx::Collide(box, Polygon2fx::FromAabb(Aabb2fx(Vector2fx(1.25_fx64, -0.5_fx64), Vector2fx(2_fx64, 0.5_fx64))), manifold));
+		REQUIRE(manifold.depth == 7_fx64);
+
+		// Diamond standing on its corner in the top face, one contact point at the corner
+		const Polygon2fx diamond = Polygon2fx::Transform(Polygon2fx::Box(Vector2fx(0.5_fx64, 0.5_fx64)), Rotation2fx::FromDegrees(45_fx64), Vector2fx(0_fx64, 1.5_fx64));
+		REQUIRE(Collision2fx::Collide(box, diamond, manifold));
+		REQUIRE(manifold.normal == Vector2fx::Up);
+		REQUIRE(Mathfx::Abs(manifold.depth - 0.20710678_fx64) < kMargin);
+		REQUIRE(manifold.pointCount == 1);
+		REQUIRE(near(manifold.points[0].position, Vector2fx(0_fx64, 0.79289322_fx64)));
+
+		// Far from the origin the wide projections give the same answer
+		const Vector2fx far(1000000000_fx64, -1000000000_fx64);
+		REQUIRE(Collision2fx::Collide(Polygon2fx::Transform(box, Rotation2fx::Identity, far), Polygon2fx::Transform(other, Rotation2fx::Identity, far), manifold));
+		REQUIRE(manifold.normal == Vector2fx::Right);
+		REQUIRE(manifold.depth == 0.25_fx64);
+		REQUIRE(manifold.points[0].position.x == far.x + 0.75_fx64);
+	}
+
+	SECTION("Polygon vs circle")
+	{
+		// Face region
+		REQUIRE(Collision2fx::Collide(box, Circle2fx(Vector2fx(0.25_fx64, 1.5_fx64), 1_fx64), manifold));
+		REQUIRE(manifold.normal == Vector2fx::Up);
+		REQUIRE(manifold.depth == 0.5_fx64);
+		REQUIRE(manifold.pointCount == 1);
+		REQUIRE(manifold.points[0].position == Vector2fx(0.25_fx64, 0.5_fx64));
+
+		// Corner region
+		REQUIRE(Collision2fx::Collide(box, Circle2fx(Vector2fx(1.5_fx64, 1.5_fx64), 1_fx64), manifold));
+		REQUIRE(near(manifold.normal, Vector2fx(0.70710678_fx64, 0.70710678_fx64)));
+		REQUIRE(Mathfx::Abs(manifold.depth - 0.29289322_fx64) < kMargin);
+		REQUIRE(!Collision2fx::Collide(box, Circle2fx(Vector2fx(1.8_fx64, 1.8_fx64), 1_fx64), manifold));
+
+		// Center inside the polygon
+		REQUIRE(Collision2fx::Collide(box, Circle2fx(Vector2fx(0_fx64, 0.5_fx64), 0.25_fx64), manifold));
+		REQUIRE(manifold.normal == Vector2fx::Up);
+		REQUIRE(manifold.depth == 0.75_fx64);
+
+		// Circle first flips the normal
+		REQUIRE(Collision2fx::Collide(Circle2fx(Vector2fx(0.25_fx64, 1.5_fx64), 1_fx64), box, manifold));
+		REQUIRE(manifold.normal == Vector2fx::Down);
+		REQUIRE(manifold.depth == 0.5_fx64);
+		REQUIRE(manifold.points[0].position == Vector2fx(0.25_fx64, 0.5_fx64));
+	}
+
+	SECTION("Circle vs circle")
+	{
+		REQUIRE(Collision2fx::Collide(Circle2fx(Vector2fx::Zero, 1_fx64), Circle2fx(Vector2fx(1.5_fx64, 0_fx64), 1_fx64), manifold));
+		REQUIRE(manifold.normal == Vector2fx::Right);
+		REQUIRE(manifold.depth == 0.5_fx64);
+		REQUIRE(manifold.points[0].position == Vector2fx(0.5_fx64, 0_fx64));
+		REQUIRE(!Collision2fx::Collide(Circle2fx(Vector2fx::Zero, 1_fx64), Circle2fx(Vector2fx(2.5_fx64, 0_fx64), 1_fx64), manifold));
+
+		// The squared radii overflow fixed64, the wide comparison doesn't
+		REQUIRE(Collision2fx::Collide(Circle2fx(Vector2fx::Zero, 50000_fx64), Circle2fx(Vector2fx(0_fx64, 99999_fx64), 50000_fx64), manifold));
+		REQUIRE(manifold.normal == Vector2fx::Up);
+		REQUIRE(manifold.depth == 1_fx64);
+		REQUIRE(!Collision2fx::Collide(Circle2fx(Vector2fx::Zero, 50000_fx64), Circle2fx(Vector2fx(0_fx64, 100001_fx64), 50000_fx64), manifold));
+	}
+
+	SECTION("Random pairs")
+	{
+		// Pushing b out along the normal by the depth must separate the shapes
+		const fixed64 push = fixed64::One >> 10;
+		for (int i = 0; i < 2000; ++i)
+		{
+			const Polygon2fx a = Polygon2fx::Transform(Polygon2fx::Box(Vector2fx(random_pos_fixed(4_fx64) + 0.1_fx64, random_pos_fixed(4_fx64) + 0.1_fx64)),
+				Rotation2fx::FromRadians(random_fixed(fixed64::Pi)), Vector2fx(random_fixed(4_fx64), random_fixed(4_fx64)));
+			const Polygon2fx b = Polygon2fx::Transform(Polygon2fx::Box(Vector2fx(random_pos_fixed(4_fx64) + 0.1_fx64, random_pos_fixed(4_fx64) + 0.1_fx64)),
+				Rotation2fx::FromRadians(random_fixed(fixed64::Pi)), Vector2fx(random_fixed(4_fx64), random_fixed(4_fx64)));
+			const Circle2fx c(Vector2fx(random_fixed(4_fx64), random_fixed(4_fx64)), random_pos_fixed(3_fx64) + 0.1_fx64);
+
+			Manifold2fx reverse;
+			const bool hit = Collision2fx::Collide(a, b, manifold);
+			REQUIRE(hit == Collision2fx::Collide(b, a, reverse));
+			if (hit)
+			{
+				REQUIRE(manifold.depth >= 0_fx64);
+				REQUIRE(manifold.pointCount >= 1);
+				const Vector2fx offset = manifold.normal * (manifold.depth + push);
+				REQUIRE(!Collision2fx::Collide(a, Polygon2fx::Transform(b, Rotation2fx::Identity, offset), reverse));
+			}
+
+			if (Collision2fx::Collide(a, c, manifold))
+			{
+				REQUIRE(manifold.depth >= 0_fx64);
+				const Circle2fx moved(c.center + manifold.normal * (manifold.depth + push), c.radius);
+				REQUIRE(!Collision2fx::Collide(a, moved, reverse));
+			}
+		}
+	}
+}
+
+TEST_CASE("Ray2fx", "[fixedmath]")
+{
+	const fixed64 kMargin = fixed64::One >> 16;
+	fixed64 fraction;
+
+	SECTION("FixedDivisor")
+	{
+		// Same bits as SafeDiv, rounding and saturation included
+		for (int i = 0; i < 100000; ++i)
+		{
+			const fixed64 x(static_cast<int64_t>(G.rng()) >> (G.rng() % 64));
+			fixed64 y(static_cast<int64_t>(G.rng()) >> (G.rng() % 64));
+			if (y == fixed64::Zero)
+			{
+				y = fixed64::One;
+			}
+			const FixedDivisor<int64_t, 32> divisor(y);
+			REQUIRE(divisor.Divisor() == y);
+			REQUIRE(divisor.Divide(x) == fixed64::SafeDiv(x, y));
+		}
+		REQUIRE(FixedDivisor<int64_t, 32>(-fixed64::One).Divide(fixed64::MinValue) == fixed64::MaxValue);
+		REQUIRE(FixedDivisor<int64_t, 32>(fixed64(static_cast<int64_t>(1))).Divide(fixed64::One) == fixed64::MaxValue);
+		REQUIRE(FixedDivisor<int64_t, 32>(3_fx64).Divide(-1_fx64) == fixed64::SafeDiv(-1_fx64, 3_fx64));
+		REQUIRE(FixedDivisor<int64_t, 32>().Divide(7_fx64) == 7_fx64);
+	}
+
+	SECTION("Boxes")
+	{
+		const Aabb2fx box(Vector2fx(-1_fx64, -1_fx64), Vector2fx(1_fx64, 1_fx64));
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0.5_fx64), Vector2fx(10_fx64, 0_fx64)), box, fraction));
+		REQUIRE(fraction == 0.4_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(5_fx64, 0.5_fx64), Vector2fx(-10_fx64, 0_fx64)), box, fraction));
+		REQUIRE(fraction == 0.4_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(0.5_fx64, -3_fx64), Vector2fx(0_fx64, 4_fx64)), box, fraction));
+		REQUIRE(fraction == 0.5_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx::Zero, Vector2fx(3_fx64, 1_fx64)), box, fraction));
+		REQUIRE(fraction == 0_fx64);
+
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0.5_fx64), Vector2fx(-10_fx64, 0_fx64)), box, fraction));
+		REQUIRE(!Ray2fx::Cast(Ray2fx::FromPoints(Vector2fx(-5_fx64, 0_fx64), Vector2fx(-2_fx64, 0_fx64)), box, fraction));
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(1.5_fx64, -3_fx64), Vector2fx(0_fx64, 4_fx64)), box, fraction));
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(-3_fx64, 0_fx64), Vector2fx(2_fx64, 3_fx64)), box, fraction));
+
+		// Against a slab test dividing with operator/
+		for (int i = 0; i < 20000; ++i)
+		{
+			const Ray2fx ray(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_fixed(20_fx64), random_fixed(20_fx64)));
+			const Aabb2fx target = Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_pos_fixed(3_fx64), random_pos_fixed(3_fx64)));
+
+			fixed64 enter = fixed64::Zero;
+			fixed64 exit = fixed64::One;
+			for (int axis = 0; axis < 2; ++axis)
+			{
+				fixed64 near = (target.min[axis] - ray.Origin()[axis]) / ray.Direction()[axis];
+				fixed64 far = (target.max[axis] - ray.Origin()[axis]) / ray.Direction()[axis];
+				enter = std::max(enter, std::min(near, far));
+				exit = std::min(exit, std::max(near, far));
+			}
+			const bool expected = enter <= exit;
+			REQUIRE(Ray2fx::Cast(ray, target, fraction) == expected);
+			if (expected)
+			{
+				REQUIRE(fraction == enter);
+			}
+		}
+	}
+
+	SECTION("Circles")
+	{
+		const Circle2fx circle(Vector2fx::Zero, 1_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0_fx64), Vector2fx(10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(fraction == 0.4_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0.5_fx64), Vector2fx(10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(Mathfx::Abs(fraction - 0.41339746_fx64) < kMargin);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 1_fx64), Vector2fx(10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(fraction == 0.5_fx64);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx(0.5_fx64, 0_fx64), Vector2fx(10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(fraction == 0_fx64);
+
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 1.01_fx64), Vector2fx(10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0_fx64), Vector2fx(-10_fx64, 0_fx64)), circle, fraction));
+		REQUIRE(!Ray2fx::Cast(Ray2fx(Vector2fx(-5_fx64, 0_fx64), Vector2fx(3_fx64, 0_fx64)), circle, fraction));
+
+		// Hit points land on the circle
+		for (int i = 0; i < 20000; ++i)
+		{
+			const Ray2fx ray(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_fixed(20_fx64), random_fixed(20_fx64)));
+			const Circle2fx target(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), random_pos_fixed(3_fx64));
+			if (Ray2fx::Cast(ray, target, fraction) && fraction > fixed64::Zero)
+			{
+				REQUIRE(Mathfx::Abs(Vector2fx::Distance(ray.GetPoint(fraction), target.center) - target.radius) < 0.001_fx64);
+			}
+		}
+	}
+
+	SECTION("Segments")
+	{
+		const Ray2fx ray(Vector2fx::Zero, Vector2fx(10_fx64, 0_fx64));
+		REQUIRE(Ray2fx::Cast(ray, Segment2fx(Vector2fx(5_fx64, -1_fx64), Vector2fx(5_fx64, 1_fx64)), fraction));
+		REQUIRE(fraction == 0.5_fx64);
+		REQUIRE(Ray2fx::Cast(ray, Segment2fx(Vector2fx(2_fx64, 0_fx64), Vector2fx(3_fx64, 1_fx64)), fraction));
+		REQUIRE(fraction == 0.2_fx64);
+		REQUIRE(!Ray2fx::Cast(ray, Segment2fx(Vector2fx(11_fx64, -1_fx64), Vector2fx(11_fx64, 1_fx64)), fraction));
+		REQUIRE(!Ray2fx::Cast(ray, Segment2fx(Vector2fx(2_fx64, 0.5_fx64), Vector2fx(3_fx64, 1_fx64)), fraction));
+		REQUIRE(!Ray2fx::Cast(ray, Segment2fx(Vector2fx(2_fx64, 0_fx64), Vector2fx(3_fx64, 0_fx64)), fraction));
+
+		// Tiny rays keep their precision
+		const fixed64 tiny(static_cast<int64_t>(1) << 12);
+		REQUIRE(Ray2fx::Cast(Ray2fx(Vector2fx::Zero, Vector2fx(tiny, 0_fx64)), Segment2fx(Vector2fx(tiny >> 2, -1_fx64), Vector2fx(tiny >> 2, 1_fx64)), fraction));
+		REQUIRE(fraction == 0.25_fx64);
+
+		// Hit or miss agrees with the exact predicate
+		for (int i = 0; i < 20000; ++i)
+		{
+			const Vector2fx from(random_fixed(10_fx64), random_fixed(10_fx64));
+			const Vector2fx to(random_fixed(10_fx64), random_fixed(10_fx64));
+			const Segment2fx target(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)));
+			if (from == to || Mathfx::Orient2D(Vector2fx::Zero, to - from, target.b - target.a) == 0)
+			{
+				continue;
+			}
+			REQUIRE(Ray2fx::Cast(Ray2fx::FromPoints(from, to), target, fraction) == Mathfx::SegmentsIntersect(from, to, target.a, target.b));
+		}
+	}
+
+	SECTION("Batches")
+	{
+		constexpr size_t kCount = 257;
+		const Ray2fx ray(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_fixed(20_fx64), random_fixed(20_fx64)));
+		std::vector<Aabb2fx> boxes(kCount);
+		std::vector<Circle2fx> circles(kCount);
+		std::vector<Segment2fx> segments(kCount);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			boxes[i] = Aabb2fx::FromCenterExtents(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_pos_fixed(3_fx64), random_pos_fixed(3_fx64)));
+			circles[i] = Circle2fx(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), random_pos_fixed(3_fx64));
+			segments[i] = Segment2fx(Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)), Vector2fx(random_fixed(10_fx64), random_fixed(10_fx64)));
+		}
+
+		std::vector<fixed64> fractions(kCount);
+		Ray2fx::CastBatch(ray, boxes, fractions);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(fractions[i] == (Ray2fx::Cast(ray, boxes[i], fraction) ? fraction : fixed64::MaxValue));
+		}
+		Ray2fx::CastBatch(ray, circles, fractions);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(fractions[i] == (Ray2fx::Cast(ray, circles[i], fraction) ? fraction : fixed64::MaxValue));
+		}
+		Ray2fx::CastBatch(ray, segments, fractions);
+		for (size_t i = 0; i < kCount; ++i)
+		{
+			REQUIRE(fractions[i] == (Ray2fx::Cast(ray, segments[i], fraction) ? fraction : fixed64::MaxValue));
+		}
+	}
+}
+
+TEST_CASE("FFT", "[fixedmath]")
+{
+	// Reference transform with the same stages and block scaling written out directly, all plain Complexfx math
+	auto referenceFft = []<typename T, int F>(std::vector<Complexfx<T, F>> data, const std::vector<Complexfx<T, F>>& roots) {
+		using complex = Complexfx<T, F>;
+		const size_t n = data.size();
+		for (size_t i = 1, j = 0; i < n; ++i)
+		{
+			size_t bit = n >> 1;
+			for (; j & bit; bit >>= 1)
+			{
+				j ^= bit;
+			}
+			j |= bit;
+			if (i < j)
+			{
+				std::swap(data[i], data[j]);
+			}
+		}
+		int exponent = 0;
+		for (size_t half = 1; half < n; half <<= 1)
+		{
+			int64_t largest = 0;
+			for (const complex& value : data)
+			{
+				largest = std::max({ largest, std::abs(static_cast<int64_t>(value.re.rawValue)), std::abs(static_cast<int64_t>(value.im.rawValue)) });
+			}
+			while (largest >= (Fixed<T, F>::RawMaxValue >> 2))
+			{
+				largest >>= 1;
+				++exponent;
+				for (complex& value : data)
+				{
+					value.re >>= 1;
+					value.im >>= 1;
+				}
+			}
+			for (size_t start = 0; start < n; start += 2 * half)
+			{
+				for (size_t k = 0; k < half; ++k)
+				{
+					const complex product = data[start + half + k] * roots[k * (n / (2 * half))];
+					data[start + half + k] = data[start + k] - product;
+					data[start + k] += product;
+				}
+			}
+		}
+		return std::pair(data, exponent);
+	};
+
+	auto checkAgainstDft = []<typename T, int F>(const std::vector<Complexfx<T, F>>& input, const std::vector<Complexfx<T, F>>& output, int exponent, double tolerance) {
+		const size_t n = input.size();
+		const double scale = std::ldexp(1.0, exponent);
+		double largestError = 0.0;
+		double largestValue = 0.0;
+		for (size_t k = 0; k < n; ++k)
+		{
+			double re = 0.0;
+			double im = 0.0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				const double angle = -2.0 * 3.14159265358979323846 * static_cast<double>((k * i) % n) / static_cast<double>(n);
+				re += static_cast<double>(input[i].re) * std::cos(angle) - static_cast<double>(input[i].im) * std::sin(angle);
+				im += static_cast<double>(input[i].re) * std::sin(angle) + static_cast<double>(input[i].im) * std::cos(angle);
+			}
+			largestError = std::max({ largestError, std::abs(static_cast<double>(output[k].re) * scale - re), std::abs(static_cast<double>(output[k].im) * scale - im) });
+			largestValue = std::max({ largestValue, std::abs(re), std::abs(im) });
+		}
+		REQUIRE(largestError <= tolerance * largestValue);
+	};
+
+	SECTION("fixed32")
+	{
+		for (size_t n : { 2, 4, 8, 64, 512 })
+		{
+			std::vector<Complexfx<int32_t, 16>> data(n);
+			for (auto& value : data)
+			{
+				value = Complexfx<int32_t, 16>(fixed32::Float(random_float(100.0f)), fixed32::Float(random_float(100.0f)));
+			}
+			const std::vector<Complexfx<int32_t, 16>> input = data;
+
+			Fftfx<int32_t, 16> fft(n);
+			// Twiddles from the fixed64 sin table rounded to fixed32, the second quarter turn rotated from the first
+			auto round = [](fixed64 x) { return fixed32(static_cast<int32_t>((x.rawValue + (1ll << 15)) >> 16)); };
+			std::vector<Complexfx<int32_t, 16>> roots(n / 2);
+			for (size_t k = 0; k < n / 2; ++k)
+			{
+				if (k == 0)
+				{
+					roots[k] = Complexfx<int32_t, 16>(fixed32::One, fixed32::Zero);
+				}
+				else if (k < n / 4)
+				{
+					const fixed64 angle = fixed64::TwoPi * fixed64::Int(static_cast<int>(k)) / fixed64::Int(static_cast<int>(n));
+					roots[k] = Complexfx<int32_t, 16>(round(Mathfx::Cos(angle)), round(-Mathfx::Sin(angle)));
+				}
+				else
+				{
+					roots[k] = Complexfx<int32_t, 16>(roots[k - n / 4].im, -roots[k - n / 4].re);
+				}
+			}
+			const int exponent = fft.Forward(data);
+			checkAgainstDft(input, data, exponent, 1e-3);
+
+			// The SIMD butterflies must give exactly the scalar result, with twiddles that round the same way
+			const auto [expected, expectedExponent] = referenceFft(input, roots);
+			REQUIRE(exponent == expectedExponent);
+			size_t mismatches = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				mismatches += data[i] != expected[i] ? 1 : 0;
+			}
+			REQUIRE(mismatches == 0);
+
+			const int inverseExponent = fft.Inverse(data);
+			Fftfx<int32_t, 16>::ApplyExponent(data, exponent + inverseExponent);
+			for (size_t i = 0; i < n; ++i)
+			{
+				REQUIRE(std::abs(static_cast<double>(data[i].re - input[i].re)) < 0.05);
+				REQUIRE(std::abs(static_cast<double>(data[i].im - input[i].im)) < 0.05);
+			}
+		}
+	}
+
+	SECTION("fixed64")
+	{
+		for (size_t n : { 2, 16, 256, 1024 })
+		{
+			std::vector<Complexfx<int64_t, 32>> data(n);
+			for (auto& value : data)
+			{
+				value = Complexfx<int64_t, 32>(random_fixed(), random_fixed());
+			}
+			const std::vector<Complexfx<int64_t, 32>> input = data;
+
+			Fftfx<int64_t, 32> fft(n);
+			const int exponent = fft.Forward(data);
+			checkAgainstDft(input, data, exponent, 1e-6);
+
+			const int inverseExponent = fft.Inverse(data);
+			Fftfx<int64_t, 32>::ApplyExponent(data, exponent + inverseExponent);
+			for (size_t i = 0; i < n; ++i)
+			{
+				REQUIRE(std::abs(static_cast<double>(data[i].re - input[i].re)) < 1e-3);
+				REQUIRE(std::abs(static_cast<double>(data[i].im - input[i].im)) < 1e-3);
+			}
+		}
+	}
+
+	SECTION("Tone")
+	{
+		constexpr size_t n = 256;
+		std::vector<Complexfx<int32_t, 16>> data(n);
+		for (size_t i = 0; i < n; ++i)
+		{
+			data[i].re = fixed32::Float(std::cos(2.0 * 3.14159265358979323846 * 10.0 * i / n));
+		}
+		Fftfx<int32_t, 16> fft(n);
+		const int exponent = fft.Forward(data);
+		Fftfx<int32_t, 16>::ApplyExponent(data, exponent);
+
+		// A cosine at bin 10 splits evenly between bins 10 and n - 10
+		for (size_t k = 0; k < n; ++k)
+		{
+			const double expected = k == 10 || k == n - 10 ? n / 2.0 : 0.0;
+			REQUIRE(std::abs(static_cast<double>(data[k].re) - expected) < 0.05);
+			REQUIRE(std::abs(static_cast<double>(data[k].im)) < 0.05);
+		}
+	}
+
+	SECTION("Overflow")
+	{
+		// Full scale input would overflow without the block scaling
+		constexpr size_t n = 64;
+		std::vector<Complexfx<int32_t, 16>> data(n, Complexfx<int32_t, 16>(fixed32::MaxValue, fixed32::MinValue));
+		Fftfx<int32_t, 16> fft(n);
+		const int exponent = fft.Forward(data);
+		REQUIRE(std::abs(std::ldexp(static_cast<double>(data[0].re), exponent) - 32768.0 * n) < 32768.0 * n * 1e-3);
+		REQUIRE(std::abs(std::ldexp(static_cast<double>(data[0].im), exponent) + 32768.0 * n) < 32768.0 * n * 1e-3);
+		for (size_t k = 1; k < n; ++k)
+		{
+			REQUIRE(data[k] == Complexfx<int32_t, 16>());
+		}
+	}
+}
+
+TEST_CASE("Filters", "[fixedmath]")
+{
+	// Feeds the input through in blocks of random length, including empty ones
+	auto processInBlocks = [](auto& filter, const auto& input, auto& output) {
+		size_t begin = 0;
+		while (begin < input.size())
+		{
+			const size_t length = std::min<size_t>(G.rng() % 100, input.size() - begin);
+			filter.Process(std::span(input).subspan(begin, length), std::span(output).subspan(begin, length));
+			begin += length;
+		}
+	};
+
+	SECTION("FIR")
+	{
+		for (size_t tapCount : { 1, 3, 8, 17, 64 })
+		{
+			std::vector<fixed32> taps(tapCount);
+			std::ranges::generate(taps, []() { return fixed32::Float(random_float(1.0f)); });
+			std::vector<fixed32> input(1000);
+			std::ranges::generate(input, []() { return fixed32::Float(random_float(100.0f)); });
+
+			std::vector<fixed32> expected(input.size());
+			for (size_t n = 0; n < input.size(); ++n)
+			{
+				FixedAccumulator<int32_t, 16> sum;
+				for (size_t k = 0; k < tapCount && k <= n; ++k)
+				{
+					sum.MulAdd(taps[k], input[n - k]);
+				}
+				expected[n] = sum.SaturatedResult();
+			}
+
+			FirFilterfx<int32_t, 16> filter(taps);
+			std::vector<fixed32> output(input.size());
+			processInBlocks(filter, input, output);
+			REQUIRE(output == expected);
+
+			// Same again one sample at a time after a reset, and in place
+			filter.Reset();
+			for (size_t n = 0; n < input.size(); ++n)
+			{
+				REQUIRE(filter.Process(input[n]) == expected[n]);
+			}
+			filter.Reset();
+			filter.Process(input, input);
+			REQUIRE(input == expected);
+		}
+	}
+
+	SECTION("FIR fixed64")
+	{
+		std::vector<fixed64> taps(5);
+		std::ranges::generate(taps, []() { return random_fixed(fixed64::One); });
+		std::vector<fixed64> input(500);
+		std::ranges::generate(input, []() { return random_fixed(); });
+
+		FirFilterfx<int64_t, 32> filter(taps);
+		std::vector<fixed64> output(input.size());
+		processInBlocks(filter, input, output);
+		for (size_t n = 0; n < input.size(); ++n)
+		{
+			double expected = 0.0;
+			for (size_t k = 0; k < taps.size() && k <= n; ++k)
+			{
+				expected += static_cast<double>(taps[k]) * static_cast<double>(input[n - k]);
+			}
+			REQUIRE(std::abs(static_cast<double>(output[n]) - expected) < 1e-6);
+		}
+	}
+
+	SECTION("Saturation")
+	{
+		const std::vector<fixed32> taps(4, fixed32::Int(2));
+		FirFilterfx<int32_t, 16> filter(taps);
+		for (int i = 0; i < 4; ++i)
+		{
+			REQUIRE(filter.Process(fixed32::Int(20000)) == fixed32::MaxValue);
+		}
+
+		// Full scale products are 2^62 each, sums of a few of them are past 64 bits. 11 taps run both the vector lanes
+		// and the scalar tail.
+		const std::vector<fixed32> full(11, fixed32::MaxValue);
+		FirFilterfx<int32_t, 16> loud(full);
+		for (int i = 0; i < 11; ++i)
+		{
+			REQUIRE(loud.Process(fixed32::MaxValue) == fixed32::MaxValue);
+		}
+
+		// The window turns over one sample at a time, the sum crosses zero one full scale product at a time
+		for (int i = 0; i < 11; ++i)
+		{
+			REQUIRE(loud.Process(fixed32::MinValue) == (i < 5 ? fixed32::MaxValue : fixed32::MinValue));
+		}
+		for (int i = 0; i < 11; ++i)
+		{
+			REQUIRE(loud.Process(fixed32::MaxValue) == (i < 5 ? fixed32::MinValue : fixed32::MaxValue));
+		}
+
+		const std::vector<BiquadFilterfx<int32_t, 16>::Coefficients> wide = {
+			{ fixed32::MaxValue, fixed32::MaxValue, fixed32::MaxValue, fixed32::MinValue, fixed32::MinValue },
+		};
+		BiquadFilterfx<int32_t, 16> biquad(wide);
+		REQUIRE(biquad.Process(fixed32::MaxValue) == fixed32::MaxValue);
+		REQUIRE(biquad.Process(fixed32::MaxValue) == fixed32::MaxValue);
+		REQUIRE(biquad.Process(fixed32::MaxValue) == fixed32::MaxValue);
+	}
+
+	SECTION("Biquad")
+	{
+		// Two stable low pass sections
+		const std::vector<BiquadFilterfx<int32_t, 16>::Coefficients> sections = {
+			{ 0.0675_fx32, 0.135_fx32, 0.0675_fx32, -1.143_fx32, 0.413_fx32 },
+			{ 0.2_fx32, 0.4_fx32, 0.2_fx32, -0.5_fx32, 0.3_fx32 },
+		};
+		std::vector<fixed32> input(2000);
+		std::ranges::generate(input, []() { return fixed32::Float(random_float(100.0f)); });
+
+		BiquadFilterfx<int32_t, 16> filter(sections);
+		std::vector<fixed32> output(input.size());
+		processInBlocks(filter, input, output);
+
+		// Double precision reference with the same coefficients, rounding errors decay instead of accumulating
+		std::vector<double> reference(input.size());
+		std::ranges::transform(input, reference.begin(), [](fixed32 x) { return static_cast<double>(x); });
+		for (const auto& c : sections)
+		{
+			double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+			for (double& value : reference)
+			{
+				const double y = static_cast<double>(c.b0) * value + static_cast<double>(c.b1) * x1 + static_cast<double>(c.b2) * x2
+					- static_cast<double>(c.a1) * y1 - static_cast<double>(c.a2) * y2;
+				x2 = x1;
+				x1 = value;
+				y2 = y1;
+				y1 = y;
+				value = y;
+			}
+		}
+		for (size_t n = 0; n < input.size(); ++n)
+		{
+			REQUIRE(std::abs(static_cast<double>(output[n]) - reference[n]) < 1e-3);
+		}
+
+		filter.Reset();
+		for (size_t n = 0; n < input.size(); ++n)
+		{
+			REQUIRE(filter.Process(input[n]) == output[n]);
+		}
+		filter.Reset();
+		filter.Process(input, input);
+		REQUIRE(input == output);
+	}
+}
+
+TEST_CASE("Gemm", "[fixedmath]")
+{
+	// Reference: every output summed in a FixedAccumulator and pushed through the same epilogue by hand
+	auto reference = []<typename T, int F>(size_t m, size_t n, size_t k, const std::vector<Fixed<T, F>>& a, const std::vector<Fixed<T, F>>& b,
+		const Mathfx::GemmEpilogue<T, F>& epilogue) {
+		using fixed = Fixed<T, F>;
+		std::vector<fixed> c(m * n);
+		for (size_t i = 0; i < m; ++i)
+		{
+			for (size_t j = 0; j < n; ++j)
+			{
+				FixedAccumulator<T, F> sum;
+				for (size_t p = 0; p < k; ++p)
+				{
+					sum.MulAdd(a[i * k + p], b[p * n + j]);
+				}
+				if (!epilogue.bias.empty())
+				{
+					sum.Add(epilogue.bias[j]);
+				}
+				fixed value = sum.SaturatedResult();
+				if (epilogue.activation == Mathfx::GemmActivation::ReLU)
+				{
+					value = Mathfx::Max(value, fixed::Zero);
+				}
+				else if (epilogue.activation == Mathfx::GemmActivation::Clamp)
+				{
+					value = Mathfx::Clamp(value, epilogue.clampMin, epilogue.clampMax);
+				}
+				c[i * n + j] = value;
+			}
+		}
+		return c;
+	};
+
+	SECTION("fixed32")
+	{
+		for (auto [m, n, k] : { std::tuple<size_t, size_t, size_t>(1, 1, 1), { 7, 13, 29 }, { 4, 8, 64 }, { 130, 17, 33 }, { 3, 5, 0 } })
+		{
+			std::vector<fixed32> a(m * k), b(k * n), bias(n), c(m * n);
+			std::ranges::generate(a, []() { return fixed32::Float(random_float(4.0f)); });
+			std::ranges::generate(b, []() { return fixed32::Float(random_float(4.0f)); });
+			std::ranges::generate(bias, []() { return fixed32::Float(random_float(4.0f)); });
+
+			Mathfx::GemmEpilogue<int32_t, 16> epilogue;
+			Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, c, epilogue);
+			REQUIRE(c == reference(m, n, k, a, b, epilogue));
+
+			epilogue.bias = bias;
+			epilogue.activation = Mathfx::GemmActivation::ReLU;
+			Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, c, epilogue);
+			REQUIRE(c == reference(m, n, k, a, b, epilogue));
+
+			epilogue.activation = Mathfx::GemmActivation::Clamp;
+			epilogue.clampMin = -2_fx32;
+			epilogue.clampMax = 3_fx32;
+			Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, c, epilogue);
+			REQUIRE(c == reference(m, n, k, a, b, epilogue));
+
+			epilogue.activation = Mathfx::GemmActivation::Tanh;
+			Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, c, epilogue);
+			epilogue.activation = Mathfx::GemmActivation::None;
+			const std::vector<fixed32> linear = reference(m, n, k, a, b, epilogue);
+			for (size_t i = 0; i < c.size(); ++i)
+			{
+				REQUIRE(std::abs(static_cast<double>(c[i]) - std::tanh(static_cast<double>(linear[i]))) < 1e-4);
+			}
+		}
+	}
+
+	SECTION("16 bit")
+	{
+		using fixed16 = Fixed<int16_t, 8>;
+		constexpr size_t m = 21, n = 19, k = 40;
+		std::vector<fixed16> a(m * k), b(k * n), bias(n), c(m * n);
+		auto random16 = []() { return fixed16(static_cast<int16_t>(G.rng())); };
+		std::ranges::generate(a, random16);
+		std::ranges::generate(b, random16);
+		std::ranges::generate(bias, random16);
+
+		// Full range values, most outputs saturate
+		Mathfx::GemmEpilogue<int16_t, 8> epilogue;
+		epilogue.bias = bias;
+		Mathfx::Gemm<int16_t, 8>(m, n, k, a, b, c, epilogue);
+		REQUIRE(c == reference(m, n, k, a, b, epilogue));
+
+		std::ranges::generate(a, []() { return fixed16::Float(random_float(2.0f)); });
+		std::ranges::generate(b, []() { return fixed16::Float(random_float(2.0f)); });
+		epilogue.activation = Mathfx::GemmActivation::ReLU;
+		Mathfx::Gemm<int16_t, 8>(m, n, k, a, b, c, epilogue);
+		REQUIRE(c == reference(m, n, k, a, b, epilogue));
+	}
+
+	SECTION("Thread count")
+	{
+		constexpr size_t m = 200, n = 24, k = 50;
+		std::vector<fixed32> a(m * k), b(k * n), serial(m * n), threaded(m * n);
+		std::ranges::generate(a, []() { return fixed32::Float(random_float(4.0f)); });
+		std::ranges::generate(b, []() { return fixed32::Float(random_float(4.0f)); });
+
+		Mathfx::ThreadPool one(1);
+		Mathfx::ThreadPool four(4);
+		Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, serial, {}, one);
+		Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, threaded, {}, four);
+		REQUIRE(serial == threaded);
+	}
+
+	SECTION("Sums past 64 bits wrap")
+	{
+		// Each full scale product is close to 2^62, three of them wrap the 64 bit sum on the scalar and vector paths alike
+		constexpr size_t m = 5, n = 9, k = 3;
+		std::vector<fixed32> a(m * k, fixed32::MaxValue), b(k * n, fixed32::MaxValue), c(m * n);
+		b[0] = fixed32::MinValue;
+		Mathfx::Gemm<int32_t, 16>(m, n, k, a, b, c);
+
+		const uint64_t product = static_cast<uint64_t>(static_cast<int64_t>(fixed32::RawMaxValue) * fixed32::RawMaxValue);
+		const int64_t wrapped = static_cast<int64_t>(3 * product);
+		const int64_t mixed = static_cast<int64_t>(2 * product + static_cast<uint64_t>(static_cast<int64_t>(fixed32::RawMaxValue) * fixed32::RawMinValue));
+		for (size_t i = 0; i < m; ++i)
+		{
+			REQUIRE(c[i * n] == Mathfx::WideToFixedSaturated<int32_t, 16>(mixed));
+			for (size_t j = 1; j < n; ++j)
+			{
+				REQUIRE(c[i * n + j] == Mathfx::WideToFixedSaturated<int32_t, 16>(wrapped));
+			}
+		}
+	}
+}
+
+TEST_CASE("Activations", "[fixedmath]")
+{
+	auto randomRaw32 = []() { return fixed32(static_cast<int32_t>(G.rng())); };
+
+	SECTION("Tanh and Sigmoid")
+	{
+		for (int i = 0; i < 20000; ++i)
+		{
+			const fixed64 x = random_fixed(12_fx64);
+			const double expected = std::tanh(static_cast<double>(x));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Tanh(x)) - expected) < 1e-6);
+			REQUIRE(Mathfx::Tanh(-x) == -Mathfx::Tanh(x));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Sigmoid(x)) - 1.0 / (1.0 + std::exp(-static_cast<double>(x)))) < 1e-6);
+
+			const fixed32 y = fixed32(static_cast<int32_t>(x.rawValue >> 16));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Tanh(y)) - std::tanh(static_cast<double>(y))) < 4e-5);
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Sigmoid(y)) - 1.0 / (1.0 + std::exp(-static_cast<double>(y)))) < 4e-5);
+		}
+		REQUIRE(Mathfx::Tanh(fixed32::Zero) == fixed32::Zero);
+		REQUIRE(Mathfx::Tanh(fixed32::MaxValue) == fixed32::One);
+		REQUIRE(Mathfx::Tanh(fixed32::MinValue) == -fixed32::One);
+		REQUIRE(Mathfx::Sigmoid(fixed32::Zero) == fixed32::Half);
+		REQUIRE(Mathfx::Sigmoid(fixed32::MaxValue) == fixed32::One);
+		REQUIRE(Mathfx::Sigmoid(fixed32::MinValue) == fixed32::Zero);
+	}
+
+	SECTION("FastExp")
+	{
+		for (int i = 0; i < 20000; ++i)
+		{
+			const fixed64 x = random_fixed(20_fx64);
+			const double expected = std::exp(static_cast<double>(x));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::FastExp(x)) - expected) <= expected * 1e-7 + 1e-9);
+
+			const fixed32 y = fixed32::Float(random_float(10.0f));
+			const double expected32 = std::exp(static_cast<double>(y));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::FastExp(y)) - expected32) <= expected32 * 2e-4 + 3e-5);
+		}
+		REQUIRE(Mathfx::FastExp(fixed32::Zero) == fixed32::One);
+		REQUIRE(Mathfx::FastExp(fixed64::Zero) == fixed64::One);
+		REQUIRE(Mathfx::FastExp(11_fx32) == fixed32::MaxValue);
+		REQUIRE(Mathfx::FastExp(fixed32::MaxValue) == fixed32::MaxValue);
+		REQUIRE(Mathfx::FastExp(-12_fx32) == fixed32::Zero);
+		REQUIRE(Mathfx::FastExp(fixed32::MinValue) == fixed32::Zero);
+		REQUIRE(Mathfx::FastExp(fixed64::MaxValue) == fixed64::MaxValue);
+		REQUIRE(Mathfx::FastExp(fixed64::MinValue) == fixed64::Zero);
+	}
+
+	SECTION("16 bit")
+	{
+		using fixed16 = Fixed<int16_t, 8>;
+		for (int i = -1000; i <= 1000; i += 7)
+		{
+			const fixed16 x(static_cast<int16_t>(i));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Tanh(x)) - std::tanh(static_cast<double>(x))) < 0.01);
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Sigmoid(x)) - 1.0 / (1.0 + std::exp(-static_cast<double>(x)))) < 0.01);
+			const double expected = std::exp(static_cast<double>(x));
+			if (expected < 127.0)
+			{
+				REQUIRE(std::abs(static_cast<double>(Mathfx::FastExp(x)) - expected) <= expected * 0.02 + 0.01);
+			}
+		}
+	}
+
+	SECTION("Batches")
+	{
+		std::vector<fixed32> in(1003);
+		std::ranges::generate(in, [&]() { return G.rng() % 2 ? randomRaw32() : fixed32::Float(random_float(20.0f)); });
+		in[0] = fixed32::MinValue;
+		in[1] = fixed32::MaxValue;
+		in[2] = 8_fx32;
+		in[3] = -8_fx32;
+		std::vector<fixed32> out(in.size());
+
+		Mathfx::TanhBatch(in, std::span(out));
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Mathfx::Tanh(in[i]));
+		}
+		Mathfx::SigmoidBatch(in, std::span(out));
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Mathfx::Sigmoid(in[i]));
+		}
+		Mathfx::FastExpBatch(in, std::span(out));
+		for (size_t i = 0; i < in.size(); ++i)
+		{
+			REQUIRE(out[i] == Mathfx::FastExp(in[i]));
+		}
+
+		std::vector<fixed64> in64(101);
+		std::ranges::generate(in64, []() { return random_fixed(30_fx64); });
+		std::vector<fixed64> out64(in64.size());
+		Mathfx::FastExpBatch(in64, std::span(out64));
+		for (size_t i = 0; i < in64.size(); ++i)
+		{
+			REQUIRE(out64[i] == Mathfx::FastExp(in64[i]));
+		}
+	}
+
+	SECTION("Softmax")
+	{
+		for (size_t n : { 1, 2, 10, 257 })
+		{
+			std::vector<fixed32> logits(n);
+			std::ranges::generate(logits, []() { return fixed32::Float(random_float(8.0f)); });
+			std::vector<fixed32> probabilities(n);
+			Mathfx::Softmax(logits, std::span(probabilities));
+
+			const double largest = static_cast<double>(*std::ranges::max_element(logits));
+			double sum = 0.0;
+			for (fixed32 x : logits)
+			{
+				sum += std::exp(static_cast<double>(x) - largest);
+			}
+			double total = 0.0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				REQUIRE(std::abs(static_cast<double>(probabilities[i]) - std::exp(static_cast<double>(logits[i]) - largest) / sum) < 1e-4);
+				total += static_cast<double>(probabilities[i]);
+			}
+			REQUIRE(std::abs(total - 1.0) < n * 2e-5);
+
+			// In place, and shifting every logit doesn't change anything
+			std::vector<fixed32> shifted = logits;
+			std::ranges::transform(shifted, shifted.begin(), [](fixed32 x) { return x + 100_fx32; });
+			Mathfx::Softmax(shifted, std::span(shifted));
+			REQUIRE(shifted == probabilities);
+		}
+
+		// A spread wider than the type's range saturates instead of wrapping
+		std::vector<fixed32> extremes = { fixed32::MinValue, fixed32::MaxValue, fixed32::MaxValue };
+		Mathfx::Softmax(extremes, std::span(extremes));
+		REQUIRE(extremes[0] == fixed32::Zero);
+		REQUIRE(extremes[1] == fixed32::Half);
+		REQUIRE(extremes[2] == fixed32::Half);
+
+		std::vector<fixed64> logits64 = { 1_fx64, 2_fx64, 3_fx64 };
+		Mathfx::Softmax(logits64, std::span(logits64));
+		REQUIRE(std::abs(static_cast<double>(logits64[2]) - 0.66524095589) < 1e-7);
+	}
+}
+
+TEST_CASE("BLAS", "[fixedmath]")
+{
+	auto randomRaw32 = []() { return fixed32(static_cast<int32_t>(G.rng())); };
+	auto randomRaw64 = []() { return fixed64(static_cast<int64_t>((static_cast<uint64_t>(G.rng()) << 32) ^ G.rng())); };
+
+	SECTION("Hypot")
+	{
+		for (int i = 0; i < 10000; ++i)
+		{
+			const fixed64 x = random_fixed(1000000_fx64);
+			const fixed64 y = random_fixed(1000000_fx64);
+			const double expected = std::hypot(static_cast<double>(x), static_cast<double>(y));
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Hypot(x, y)) - expected) < 1e-3);
+
+			const fixed32 a = randomRaw32();
+			const fixed32 b = randomRaw32();
+			const Int128 sum = Int128::Mul(a.rawValue, a.rawValue) + Int128::Mul(b.rawValue, b.rawValue);
+			const fixed32 h = Mathfx::Hypot(a, b);
+			if (h != fixed32::MaxValue)
+			{
+				REQUIRE(!(Int128::Mul(h.rawValue, h.rawValue) > sum));
+				REQUIRE(Int128::Mul(h.rawValue + 1ll, h.rawValue + 1ll) > sum);
+			}
+			else
+			{
+				REQUIRE(!(Int128::Mul(fixed32::RawMaxValue, fixed32::RawMaxValue) > sum));
+			}
+
+			// Halved so the sum of squares stays positive when read signed
+			const fixed64 c(randomRaw64().rawValue >> 1);
+			const fixed64 d(randomRaw64().rawValue >> 1);
+			const Int128 sum64 = Int128::Mul(c.rawValue, c.rawValue) + Int128::Mul(d.rawValue, d.rawValue);
+			const fixed64 h64 = Mathfx::Hypot(c, d);
+			REQUIRE(!(Int128::Mul(h64.rawValue, h64.rawValue) > sum64));
+			REQUIRE(Int128::Mul(h64.rawValue + 1, h64.rawValue + 1) > sum64);
+		}
+		for (int64_t root : std::initializer_list<int64_t>{ 1, 2, 3, 65535, 65536, 4294967295, 4294967296, 3037000499, std::numeric_limits<int64_t>::max() })
+		{
+			const Int128 square = Int128::Mul(root, root);
+			REQUIRE(Mathfx::WideSqrt<int64_t, 32>(square).rawValue == root);
+			REQUIRE(Mathfx::WideSqrt<int64_t, 32>(square - Int128(1)).rawValue == root - 1);
+		}
+		REQUIRE(Mathfx::Hypot(3_fx64, 4_fx64) == 5_fx64);
+		REQUIRE(Mathfx::Hypot(-3_fx32, 4_fx32) == 5_fx32);
+		REQUIRE(Mathfx::Hypot(fixed64::Zero, fixed64::Zero) == fixed64::Zero);
+		REQUIRE(Mathfx::Hypot(fixed64::MinValue, fixed64::Zero) == fixed64::MaxValue);
+		REQUIRE(Mathfx::Hypot(fixed64::MaxValue, fixed64::MaxValue) == fixed64::MaxValue);
+		REQUIRE(Mathfx::Hypot(fixed64::MaxValue, fixed64::Zero) == fixed64::MaxValue);
+		REQUIRE(Mathfx::Hypot(fixed32(1), fixed32::Zero) == fixed32(1));
+	}
+
+	SECTION("Dot, Axpy and Scal")
+	{
+		// Exact products summed in 128 bits, rounded down and saturated once
+		auto referenceDot = [](const auto& a, const auto& b) {
+			using fixed = std::decay_t<decltype(a[0])>;
+			Int128 sum;
+			for (size_t i = 0; i < a.size(); ++i)
+			{
+				sum += Int128::Mul(a[i].rawValue, b[i].rawValue);
+			}
+			sum >>= fixed::FractionShift;
+			if (sum > Int128(static_cast<int64_t>(fixed::RawMaxValue)))
+			{
+				return fixed::MaxValue;
+			}
+			if (sum < Int128(static_cast<int64_t>(fixed::RawMinValue)))
+			{
+				return fixed::MinValue;
+			}
+			return fixed(static_cast<typename fixed::raw>(sum.Low()));
+		};
+
+		for (size_t n : { 0, 1, 7, 8, 9, 31, 1000 })
+		{
+			std::vector<fixed32> x(n), y(n);
+			std::ranges::generate(x, randomRaw32);
+			std::ranges::generate(y, randomRaw32);
+			std::vector<fixed64> x64(n), y64(n);
+			std::ranges::generate(x64, randomRaw64);
+			std::ranges::generate(y64, randomRaw64);
+
+			REQUIRE(Mathfx::Dot(std::span(x), std::span(y)) == referenceDot(x, y));
+			REQUIRE(Mathfx::Dot(std::span(x64), std::span(y64)) == referenceDot(x64, y64));
+
+			const fixed32 a = randomRaw32();
+			const fixed64 a64 = random_fixed(10_fx64);
+			std::vector<fixed32> expected = y;
+			std::vector<fixed64> expected64 = y64;
+			for (size_t i = 0; i < n; ++i)
+			{
+				expected[i] += a * x[i];
+				expected64[i] += a64 * x64[i];
+			}
+			Mathfx::Axpy(a, x, std::span(y));
+			Mathfx::Axpy(a64, x64, std::span(y64));
+			REQUIRE(y == expected);
+			REQUIRE(y64 == expected64);
+
+			for (size_t i = 0; i < n; ++i)
+			{
+				expected[i] = a * x[i];
+				expected64[i] = a64 * x64[i];
+			}
+			Mathfx::Scal(a, std::span(x));
+			Mathfx::Scal(a64, std::span(x64));
+			REQUIRE(x == expected);
+			REQUIRE(x64 == expected64);
+		}
+
+		// Partial sums far outside the range still give the exact total
+		std::vector<fixed32> big(100, fixed32::MaxValue);
+		std::vector<fixed32> signs(100);
+		for (size_t i = 0; i < signs.size(); ++i)
+		{
+			signs[i] = i < 50 ? 2_fx32 : -2_fx32;
+		}
+		signs.back() = -1_fx32;
+		REQUIRE(Mathfx::Dot(std::span(big), std::span(signs)) == fixed32::MaxValue);
+
+		// Full scale products are 2^62 each, sums past 64 bits still saturate the right way and cancel exactly
+		for (size_t n : { 3, 8, 17, 1000 })
+		{
+			std::vector<fixed32> full(n, fixed32::MaxValue);
+			std::vector<fixed32> lowest(n, fixed32::MinValue);
+			REQUIRE(Mathfx::Dot(std::span(full), std::span(full)) == fixed32::MaxValue);
+			REQUIRE(Mathfx::Dot(std::span(lowest), std::span(lowest)) == fixed32::MaxValue);
+			REQUIRE(Mathfx::Dot(std::span(full), std::span(lowest)) == fixed32::MinValue);
+		}
+		std::vector<fixed32> cancel(33, fixed32::MaxValue);
+		std::vector<fixed32> alternating(33);
+		for (size_t i = 0; i < alternating.size(); ++i)
+		{
+			alternating[i] = i < 16 ? fixed32::MaxValue : -fixed32::MaxValue;
+		}
+		cancel.back() = 0.5_fx32;
+		alternating.back() = 3_fx32;
+		REQUIRE(Mathfx::Dot(std::span(cancel), std::span(alternating)) == 1.5_fx32);
+	}
+
+	SECTION("Nrm2, Asum and IAmax")
+	{
+		for (size_t n : { 1, 3, 4, 8, 9, 33, 1000 })
+		{
+			std::vector<fixed32> x(n);
+			std::ranges::generate(x, [&]() { return fixed32::Float(random_float(100.0f)); });
+			std::vector<fixed64> x64(n);
+			std::ranges::generate(x64, []() { return random_fixed(100000_fx64); });
+
+			double squares = 0.0, squares64 = 0.0;
+			int64_t magnitudes = 0;
+			Int128 magnitudes64;
+			for (size_t i = 0; i < n; ++i)
+			{
+				squares += static_cast<double>(x[i]) * static_cast<double>(x[i]);
+				squares64 += static_cast<double>(x64[i]) * static_cast<double>(x64[i]);
+				magnitudes += std::abs(static_cast<int64_t>(x[i].rawValue));
+				magnitudes64 += Int128(std::abs(x64[i].rawValue));
+			}
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Nrm2(std::span(x))) - std::sqrt(squares)) < 1e-4);
+			REQUIRE(std::abs(static_cast<double>(Mathfx::Nrm2(std::span(x64))) / std::sqrt(squares64) - 1.0) < 1e-12);
+			REQUIRE(Mathfx::Asum(std::span(x)).rawValue == std::min<int64_t>(magnitudes, fixed32::RawMaxValue));
+			REQUIRE(Mathfx::Asum(std::span(x64)).rawValue == magnitudes64.Low());
+
+			const size_t largest = G.rng() % n;
+			x[largest] = G.rng() % 2 ? 200_fx32 : -200_fx32;
+			x64[largest] = -200000_fx64;
+			REQUIRE(Mathfx::IAmax(std::span(x)) == largest);
+			REQUIRE(Mathfx::IAmax(std::span(x64)) == largest);
+
+			// Ties go to the first index
+			x.back() = -x[largest];
+			x64.back() = -x64[largest];
+			REQUIRE(Mathfx::IAmax(std::span(x)) == largest);
+			REQUIRE(Mathfx::IAmax(std::span(x64)) == largest);
+		}
+
+		// Every extreme adds up without wrapping
+		std::vector<fixed32> extremes(17, fixed32::MinValue);
+		REQUIRE(Mathfx::Nrm2(std::span(extremes)) == fixed32::MaxValue);
+		REQUIRE(Mathfx::Asum(std::span(extremes)) == fixed32::MaxValue);
+		extremes[5] = fixed32::MaxValue;
+		REQUIRE(Mathfx::IAmax(std::span(extremes)) == 0);
+		std::vector<fixed64> extremes64(9, fixed64::MinValue);
+		REQUIRE(Mathfx::Nrm2(std::span(extremes64)) == fixed64::MaxValue);
+		REQUIRE(Mathfx::Asum(std::span(extremes64)) == fixed64::MaxValue);
+		extremes64[0] = fixed64::MaxValue;
+		REQUIRE(Mathfx::IAmax(std::span(extremes64)) == 1);
+
+		std::vector<fixed32> small(11, fixed32(1));
+		small[3] = fixed32(-3);
+		REQUIRE(Mathfx::Nrm2(std::span(small)) == fixed32(4));
+		REQUIRE(Mathfx::IAmax(std::span(small)) == 3);
+
+		using fixed16 = Fixed<int16_t, 8>;
+		std::vector<fixed16> x16 = { fixed16(static_cast<int16_t>(3 << 8)), fixed16(static_cast<int16_t>(-4 << 8)) };
+		REQUIRE(Mathfx::Nrm2(std::span(x16)) == fixed16(static_cast<int16_t>(5 << 8)));
+		REQUIRE(Mathfx::Asum(std::span(x16)) == fixed16(static_cast<int16_t>(7 << 8)));
+		REQUIRE(Mathfx::IAmax(std::span(x16)) == 1);
+	}
+}
+
+TEST_CASE("Solver2fx", "[fixedmath]")
+{
+	const fixed64 dt = fixed64::One / 60_fx64;
+	const fixed64 kMargin = fixed64::One >> 12;
+
+	// Body 0 is static ground, the rest are dynamic
+	struct World
+	{
+		Vector2fxSoA velocities;
+		std::vector<fixed64> angularVelocities;
+		std::vector<fixed64> inverseMasses;
+		std::vector<fixed64> inverseInertias;
+
+		explicit World(size_t count) : velocities(count), angularVelocities(count), inverseMasses(count, fixed64::One), inverseInertias(count, fixed64::One)
+		{
+			inverseMasses[0] = fixed64::Zero;
+			inverseInertias[0] = fixed64::Zero;
+		}
+
+		Solver2fx::Bodies Bodies() { return { velocities, angularVelocities, inverseMasses, inverseInertias }; }
+	};
+
+	Manifold2fx manifold;
+	manifold.normal = Vector2fx::Up;
+	manifold.depth = fixed64::Zero;
+	manifold.pointCount = 2;
+	manifold.points[0] = { Vector2fx(-1_fx64, 0_fx64), fixed64::Zero, 1 };
+	manifold.points[1] = { Vector2fx(1_fx64, 0_fx64), fixed64::Zero, 2 };
+
+	SECTION("Contact stops a falling body")
+	{
+		World world(2);
+		world.velocities.y[1] = -2_fx64;
+		world.velocities.x[1] = 0.5_fx64;
+
+		Solver2fx solver;
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), manifold, 0.5_fx64);
+		REQUIRE(solver.RowCount() == 4);
+		Solver2fx::Settings settings;
+		settings.iterations = 20;
+		solver.Solve(world.Bodies(), dt, settings);
+
+		// Both points stop sinking, the body stops spinning and friction slows the slide without reversing it
+		REQUIRE(Mathfx::Abs(world.velocities.y[1]) < kMargin);
+		REQUIRE(Mathfx::Abs(world.angularVelocities[1]) < kMargin);
+		REQUIRE(world.velocities.x[1] >= fixed64::Zero);
+		REQUIRE(world.velocities.x[1] < 0.5_fx64);
+		REQUIRE(solver.Impulse(0) + solver.Impulse(1) > 1.99_fx64);
+		for (size_t friction : { 2, 3 })
+		{
+			REQUIRE(Mathfx::Abs(solver.Impulse(friction)) <= solver.Impulse(friction - 2) * 0.5_fx64 + kMargin);
+		}
+
+		// The ground is never written
+		REQUIRE(world.velocities[0] == Vector2fx::Zero);
+		REQUIRE(world.angularVelocities[0] == fixed64::Zero);
+
+		// Separating bodies are left alone
+		World apart(2);
+		apart.velocities.y[1] = 1_fx64;
+		Solver2fx other;
+		other.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), manifold, 0.5_fx64);
+		other.Solve(apart.Bodies(), dt);
+		REQUIRE(apart.velocities.y[1] == 1_fx64);
+		REQUIRE(other.Impulse(0) == fixed64::Zero);
+	}
+
+	SECTION("Penetration is pushed out")
+	{
+		World world(2);
+		Manifold2fx deep = manifold;
+		deep.points[0].depth = 0.1_fx64;
+		deep.points[1].depth = 0.1_fx64;
+		Solver2fx solver;
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), deep, fixed64::Zero);
+		Solver2fx::Settings settings;
+		settings.iterations = 20;
+		solver.Solve(world.Bodies(), dt, settings);
+		const double expected = 0.2 * (0.1 - 0.005) * 60.0;
+		REQUIRE(std::abs(static_cast<double>(world.velocities.y[1]) - expected) < 1e-3);
+	}
+
+	SECTION("Point joint")
+	{
+		// A pendulum bob hanging from the ground and a second bob hanging from the first
+		World world(3);
+		world.velocities[1] = Vector2fx(1_fx64, 0.5_fx64);
+		world.velocities[2] = Vector2fx(-1_fx64, 2_fx64);
+		world.angularVelocities[2] = 0.3_fx64;
+		const Vector2fx centers[3] = { Vector2fx::Zero, Vector2fx(0_fx64, -1_fx64), Vector2fx(0_fx64, -2_fx64) };
+
+		Solver2fx solver;
+		solver.AddPointJoint(0, 0, 1, centers[0], centers[1], Vector2fx(0_fx64, -0.5_fx64), Vector2fx(0_fx64, -0.5_fx64));
+		solver.AddPointJoint(0, 1, 2, centers[1], centers[2], Vector2fx(0_fx64, -1.5_fx64), Vector2fx(0_fx64, -1.5_fx64));
+		Solver2fx::Settings settings;
+		settings.iterations = 100;
+		solver.Solve(world.Bodies(), dt, settings);
+
+		// The anchor points move together, v + w * (-r.y, r.x)
+		auto pointVelocity = [&](size_t body, const Vector2fx& r) {
+			return world.velocities[body] + Vector2fx(-r.y, r.x) * world.angularVelocities[body];
+		};
+		REQUIRE(pointVelocity(1, Vector2fx(0_fx64, 0.5_fx64)).Magnitude() < kMargin);
+		REQUIRE((pointVelocity(1, Vector2fx(0_fx64, -0.5_fx64)) - pointVelocity(2, Vector2fx(0_fx64, 0.5_fx64))).Magnitude() < kMargin);
+	}
+
+	SECTION("Warm starting")
+	{
+		World world(2);
+		world.velocities.y[1] = -2_fx64;
+		Solver2fx solver;
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), manifold, 0.5_fx64);
+		solver.Solve(world.Bodies(), dt);
+		const fixed64 impulses[2] = { solver.Impulse(0), solver.Impulse(1) };
+
+		// The next step starts from the last impulses, without any iterations they alone stop the body again
+		world.velocities.y[1] = -2_fx64;
+		solver.Clear();
+		REQUIRE(solver.RowCount() == 0);
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), manifold, 0.5_fx64);
+		Solver2fx::Settings settings;
+		settings.iterations = 0;
+		solver.Solve(world.Bodies(), dt, settings);
+		REQUIRE(solver.Impulse(0) == impulses[0]);
+		REQUIRE(solver.Impulse(1) == impulses[1]);
+		REQUIRE(Mathfx::Abs(world.velocities.y[1]) < kMargin);
+
+		// Rows match by key, a contact point with a new id starts from zero
+		solver.Clear();
+		Manifold2fx changed = manifold;
+		changed.points[1].id = 7;
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), changed, 0.5_fx64);
+		settings.warmStarting = true;
+		solver.Solve(world.Bodies(), dt, settings);
+		REQUIRE(solver.Impulse(0) == impulses[0]);
+		REQUIRE(solver.Impulse(1) == fixed64::Zero);
+
+		solver.Clear();
+		solver.AddContact(0, 1, Vector2fx::Zero, Vector2fx(0_fx64, 1_fx64), manifold, 0.5_fx64);
+		settings.warmStarting = false;
+		solver.Solve(world.Bodies(), dt, settings);
+		REQUIRE(solver.Impulse(0) == fixed64::Zero);
+	}
+
+	SECTION("Colored mode is deterministic")
+	{
+		// A pile of random contacts and joints between many bodies
+		constexpr size_t kBodies = 300;
+		World start(kBodies);
+		std::vector<Vector2fx> centers(kBodies);
+		for (size_t i = 0; i < kBodies; ++i)
+		{
+			start.velocities[i] = Vector2fx(random_fixed(5_fx64), random_fixed(5_fx64));
+			start.angularVelocities[i] = random_fixed(2_fx64);
+			centers[i] = Vector2fx(random_fixed(50_fx64), random_fixed(50_fx64));
+			if (i > 0)
+			{
+				start.inverseMasses[i] = random_pos_fixed(2_fx64) + 0.1_fx64;
+				start.inverseInertias[i] = random_pos_fixed(2_fx64) + 0.1_fx64;
+			}
+		}
+		start.velocities[0] = Vector2fx::Zero;
+		start.angularVelocities[0] = fixed64::Zero;
+
+		Solver2fx solver;
+		for (uint32_t c = 0; c < 2000; ++c)
+		{
+			const uint32_t a = static_cast<uint32_t>(G.rng() % kBodies);
+			uint32_t b = static_cast<uint32_t>(G.rng() % kBodies);
+			b = b == a ? (b + 1) % kBodies : b;
+			const Vector2fx point = (centers[a] + centers[b]) * 0.5_fx64;
+			if (c % 4 == 0)
+			{
+				solver.AddPointJoint(c, a, b, centers[a], centers[b], point, point + Vector2fx(random_fixed(0.01_fx64), random_fixed(0.01_fx64)));
+			}
+			else
+			{
+				Manifold2fx contact;
+				contact.normal = Vector2fx::Normalize(centers[b] - centers[a]);
+				contact.pointCount = 1;
+				contact.points[0] = { point, random_pos_fixed(0.05_fx64), c };
+				solver.AddContact(a, b, centers[a], centers[b], contact, 0.3_fx64);
+			}
+		}
+
+		Solver2fx::Settings settings;
+		settings.colored = true;
+		Mathfx::ThreadPool single(1);
+		Mathfx::ThreadPool many(4);
+
+		World first = start;
+		Solver2fx firstSolver = solver;
+		firstSolver.Solve(first.Bodies(), dt, settings, single);
+		World second = start;
+		Solver2fx secondSolver = solver;
+		secondSolver.Solve(second.Bodies(), dt, settings, many);
+		REQUIRE(first.velocities.x == second.velocities.x);
+		REQUIRE(first.velocities.y == second.velocities.y);
+		REQUIRE(first.angularVelocities == second.angularVelocities);
+		for (size_t i = 0; i < solver.RowCount(); ++i)
+		{
+			REQUIRE(firstSolver.Impulse(i) == secondSolver.Impulse(i));
+		}
+
+		// Sequential mode solves the same rows in a different order, static bodies stay untouched either way
+		World sequential = start;
+		Solver2fx sequentialSolver = solver;
+		settings.colored = false;
+		sequentialSolver.Solve(sequential.Bodies(), dt, settings);
+		REQUIRE(sequential.velocities[0] == Vector2fx::Zero);
+		REQUIRE(first.velocities[0] == Vector2fx::Zero);
+	}
+}
+
+TEST_CASE("Convolution", "[fixedmath]")
+{
+	using fixed16 = Fixed<int16_t, 8>;
+	const Mathfx::BorderMode borders[] = { Mathfx::BorderMode::Clamp, Mathfx::BorderMode::Wrap, Mathfx::BorderMode::Mirror, Mathfx::BorderMode::Zero };
+
+	// Textbook convolution, one output at a time with the border resolved for every tap and the kernel flipped
+	auto reference = [](size_t width, size_t height, const auto& source, size_t kernelWidth, size_t kernelHeight, const auto& kernel, Mathfx::BorderMode border) {
+		using fixed = std::decay_t<decltype(source[0])>;
+		auto resolve = [border](ptrdiff_t i, ptrdiff_t n) -> ptrdiff_t {
+			while (i < 0 || i >= n)
+			{
+				switch (border)
+				{
+				case Mathfx::BorderMode::Clamp: i = std::clamp<ptrdiff_t>(i, 0, n - 1); break;
+				case Mathfx::BorderMode::Wrap: i = i < 0 ? i + n : i - n; break;
+				case Mathfx::BorderMode::Mirror: i = i < 0 ? -i - 1 : 2 * n - 1 - i; break;
+				default: return -1;
+				}
+			}
+			return i;
+		};
+		std::vector<fixed> result(width * height);
+		for (size_t y = 0; y < height; ++y)
+		{
+			for (size_t x = 0; x < width; ++x)
+			{
+				int64_t sum = 0;
+				for (size_t ky = 0; ky < kernelHeight; ++ky)
+				{
+					for (size_t kx = 0; kx < kernelWidth; ++kx)
+					{
+						const ptrdiff_t sy = resolve(static_cast<ptrdiff_t>(y + kernelHeight / 2) - static_cast<ptrdiff_t>(ky), static_cast<ptrdiff_t>(height));
+						const ptrdiff_t sx = resolve(static_cast<ptrdiff_t>(x + kernelWidth / 2) - static_cast<ptrdiff_t>(kx), static_cast<ptrdiff_t>(width));
+						if (sy >= 0 && sx >= 0)
+						{
+							sum += static_cast<int64_t>(kernel[ky * kernelWidth + kx].rawValue) * source[sy * width + sx].rawValue;
+						}
+					}
+				}
+				sum >>= fixed::FractionShift;
+				result[y * width + x] = fixed(static_cast<typename fixed::raw>(std::clamp<int64_t>(sum, fixed::RawMinValue, fixed::RawMaxValue)));
+			}
+		}
+		return result;
+	};
+
+	SECTION("General kernels")
+	{
+		for (const auto& [width, height, kernelWidth, kernelHeight] : { std::array<size_t, 4> { 37, 23, 5, 3 }, { 8, 8, 3, 3 }, { 4, 9, 7, 1 }, { 1, 1, 3, 3 }, { 64, 5, 1, 5 } })
+		{
+			std::vector<fixed32> source(width * height);
+			std::ranges::generate(source, []() { return fixed32::Float(random_float(100.0f)); });
+			std::vector<fixed32> kernel(kernelWidth * kernelHeight);
+			std::ranges::generate(kernel, []() { return fixed32::Float(random_float(2.0f)); });
+			std::vector<fixed16> source16(width * height);
+			std::ranges::generate(source16, []() { return fixed16(static_cast<int16_t>(G.rng())); });
+			std::vector<fixed16> kernel16(kernelWidth * kernelHeight);
+			std::ranges::generate(kernel16, []() { return fixed16(static_cast<int16_t>(static_cast<int>(G.rng() % 512) - 256)); });
+
+			for (Mathfx::BorderMode border : borders)
+			{
+				std::vector<fixed32> result(width * height);
+				Mathfx::Convolve2D(width, height, source, std::span(result), kernelWidth, kernelHeight, kernel, border);
+				REQUIRE(result == reference(width, height, source, kernelWidth, kernelHeight, kernel, border));
+
+				std::vector<fixed16> result16(width * height);
+				Mathfx::Convolve2D(width, height, source16, std::span(result16), kernelWidth, kernelHeight, kernel16, border);
+				REQUIRE(result16 == reference(width, height, source16, kernelWidth, kernelHeight, kernel16, border));
+			}
+		}
+
+		// An impulse comes out as the kernel itself, the right way round
+		std::vector<fixed32> impulse(7 * 5, fixed32::Zero);
+		impulse[2 * 7 + 3] = fixed32::One;
+		const std::vector<fixed32> ramp = { 1_fx32, 2_fx32, 3_fx32, 4_fx32, 5_fx32, 6_fx32, 7_fx32, 8_fx32, 9_fx32 };
+		std::vector<fixed32> response(impulse.size());
+		Mathfx::Convolve2D(7, 5, impulse, std::span(response), 3, 3, ramp, Mathfx::BorderMode::Zero);
+		for (size_t y = 0; y < 3; ++y)
+		{
+			for (size_t x = 0; x < 3; ++x)
+			{
+				REQUIRE(response[(y + 1) * 7 + x + 2] == ramp[y * 3 + x]);
+			}
+		}
+		std::vector<fixed32> rowResponse(impulse.size());
+		Mathfx::ConvolveSeparable(7, 5, impulse, std::span(rowResponse), std::span(ramp).first(3), std::span(ramp).last(3), Mathfx::BorderMode::Zero);
+		REQUIRE(rowResponse[1 * 7 + 2] == 7_fx32);
+		REQUIRE(rowResponse[1 * 7 + 4] == 21_fx32);
+		REQUIRE(rowResponse[3 * 7 + 2] == 9_fx32);
+
+		// Saturates instead of wrapping
+		std::vector<fixed32> bright(20 * 9, fixed32::MaxValue);
+		std::vector<fixed32> box(9, fixed32::One);
+		std::vector<fixed32> result(bright.size());
+		Mathfx::Convolve2D(20, 9, bright, std::span(result), 3, 3, box);
+		REQUIRE(std::ranges::all_of(result, [](fixed32 x) { return x == fixed32::MaxValue; }));
+		std::ranges::fill(box, -fixed32::One);
+		Mathfx::Convolve2D(20, 9, bright, std::span(result), 3, 3, box);
+		REQUIRE(std::ranges::all_of(result, [](fixed32 x) { return x == fixed32::MinValue; }));
+	}
+
+	SECTION("Separable kernels")
+	{
+		constexpr size_t width = 45, height = 31;
+		std::vector<fixed32> source(width * height);
+		std::ranges::generate(source, []() { return fixed32::Float(random_float(100.0f)); });
+		const std::vector<fixed32> horizontal = { 0.0625_fx32, 0.25_fx32, 0.375_fx32, 0.25_fx32, 0.0625_fx32 };
+		const std::vector<fixed32> vertical = { 0.25_fx32, 0.5_fx32, 0.25_fx32 };
+
+		for (Mathfx::BorderMode border : borders)
+		{
+			// Exactly the two passes done as general convolutions
+			std::vector<fixed32> rows(source.size()), expected(source.size());
+			Mathfx::Convolve2D(width, height, source, std::span(rows), horizontal.size(), 1, horizontal, border);
+			Mathfx::Convolve2D(width, height, rows, std::span(expected), 1, vertical.size(), vertical, border);
+
+			std::vector<fixed32> result(source.size());
+			Mathfx::ConvolveSeparable(width, height, source, std::span(result), horizontal, vertical, border);
+			REQUIRE(result == expected);
+
+			std::vector<fixed32> inPlace = source;
+			Mathfx::ConvolveSeparable(width, height, inPlace, std::span(inPlace), horizontal, vertical, border);
+			REQUIRE(inPlace == expected);
+
+			// Close to the general convolution with the product kernel
+			std::vector<fixed32> product(horizontal.size() * vertical.size());
+			for (size_t y = 0; y < vertical.size(); ++y)
+			{
+				for (size_t x = 0; x < horizontal.size(); ++x)
+				{
+					product[y * horizontal.size() + x] = vertical[y] * horizontal[x];
+				}
+			}
+			std::vector<fixed32> general(source.size());
+			Mathfx::Convolve2D(width, height, source, std::span(general), horizontal.size(), vertical.size(), product, border);
+			for (size_t i = 0; i < source.size(); ++i)
+			{
+				REQUIRE(Mathfx::Abs(general[i] - result[i]).rawValue <= 4);
+			}
+		}
+
+		// A constant grid stays constant everywhere, borders included, with any border that doesn't read zero
+		std::vector<fixed16> flat(width * height, fixed16(static_cast<int16_t>(3 << 8)));
+		const std::vector<fixed16> quarters(3, fixed16(static_cast<int16_t>(1 << 6)));
+		std::vector<fixed16> blurred(flat.size());
+		Mathfx::ConvolveSeparable(width, height, flat, std::span(blurred), quarters, quarters, Mathfx::BorderMode::Mirror);
+		REQUIRE(std::ranges::all_of(blurred, [](fixed16 x) { return x.rawValue == (3 << 8) * 9 / 16; }));
+	}
+
+	SECTION("Thread count doesn't matter")
+	{
+		constexpr size_t width = 100, height = 77;
+		std::vector<fixed32> source(width * height);
+		std::ranges::generate(source, []() { return fixed32::Float(random_float(100.0f)); });
+		std::vector<fixed32> kernel(5 * 5);
+		std::ranges::generate(kernel, []() { return fixed32::Float(random_float(1.0f)); });
+
+		Mathfx::ThreadPool single(1);
+		Mathfx::ThreadPool many(4);
+		std::vector<fixed32> first(source.size()), second(source.size());
+		Mathfx::Convolve2D(width, height, source, std::span(first), 5, 5, kernel, Mathfx::BorderMode::Wrap, single);
+		Mathfx::Convolve2D(width, height, source, std::span(second), 5, 5, kernel, Mathfx::BorderMode::Wrap, many);
+		REQUIRE(first == second);
+		Mathfx::ConvolveSeparable(width, height, source, std::span(first), std::span(kernel).first(5), std::span(kernel).last(5), Mathfx::BorderMode::Zero, single);
+		Mathfx::ConvolveSeparable(width, height, source, std::span(second), std::span(kernel).first(5), std::span(kernel).last(5), Mathfx::BorderMode::Zero, many);
+		REQUIRE(first == second);
+	}
+
+	SECTION("Sums past 64 bits wrap")
+	{
+		// Each full scale product is close to 2^62, a few of them wrap the 64 bit sum on the scalar and vector paths alike.
+		// Rows of 20 run both the vector spans and the edges.
+		constexpr size_t width = 20, height = 9;
+		std::vector<fixed32> source(width * height, fixed32::MaxValue), result(width * height);
+		std::vector<fixed32> kernel(9, fixed32::MaxValue);
+
+		const uint64_t product = static_cast<uint64_t>(static_cast<int64_t>(fixed32::RawMaxValue) * fixed32::RawMaxValue);
+		Mathfx::Convolve2D(width, height, source, std::span(result), 3, 3, kernel, Mathfx::BorderMode::Clamp);
+		REQUIRE(std::ranges::all_of(result, [&](fixed32 x) { return x == Mathfx::WideToFixedSaturated<int32_t, 16>(static_cast<int64_t>(9 * product)); }));
+
+		// The zero border leaves four products at the corners and six along the edges
+		Mathfx::Convolve2D(width, height, source, std::span(result), 3, 3, kernel, Mathfx::BorderMode::Zero);
+		REQUIRE(result[0] == Mathfx::WideToFixedSaturated<int32_t, 16>(static_cast<int64_t>(4 * product)));
+		REQUIRE(result[width / 2] == Mathfx::WideToFixedSaturated<int32_t, 16>(static_cast<int64_t>(6 * product)));
+		REQUIRE(result[width + width / 2] == Mathfx::WideToFixedSaturated<int32_t, 16>(static_cast<int64_t>(9 * product)));
+	}
+}
+
+TEST_CASE("Stats", "[fixedmath]")
+{
+	SECTION("Int128 division")
+	{
+		for (int i = 0; i < 10000; ++i)
+		{
+			const int64_t a = static_cast<int64_t>((static_cast<uint64_t>(G.rng()) << 32) ^ G.rng());
+			const int64_t b = static_cast<int64_t>((static_cast<uint64_t>(G.rng()) << 32) ^ G.rng());
+			const uint64_t divisor = (i & 1) ? G.rng() % 1000 + 1 : (static_cast<uint64_t>(G.rng()) << 32) ^ G.rng() | 1;
+			const Int128 x = Int128::Mul(a, b);
+
+			uint64_t remainder = 0;
+			const Int128 quotient = Int128::DivUnsigned(x, divisor, &remainder);
+			REQUIRE(remainder < divisor);
+			REQUIRE(Int128::MulUnsigned(quotient.lo, divisor) + Int128(quotient.hi * divisor, 0) + Int128(0, remainder) == x);
+
+			const Int128 floor = Int128::DivFloor(x, divisor);
+			const Int128 product = Int128::MulUnsigned(floor.lo, divisor) + Int128(floor.hi * divisor, 0);
+			REQUIRE(!(product > x));
+			REQUIRE(product + Int128(0, divisor) > x);
+		}
+		REQUIRE(Int128::DivFloor(Int128(-7), 2) == Int128(-4));
+		REQUIRE(Int128::DivFloor(Int128(-8), 2) == Int128(-4));
+		REQUIRE(Int128::DivFloor(Int128(7), 2) == Int128(3));
+		REQUIRE(Int128::DivUnsigned(Int128(1, 0), 3) == Int128(0, 0x5555555555555555ull));
+	}
+
+	SECTION("Mean, variance and extremes")
+	{
+		for (size_t n : { 1, 2, 10, 1000, 20000 })
+		{
+			std::vector<fixed64> values(n);
+			std::ranges::generate(values, []() { return 5000_fx64 + random_fixed(100_fx64); });
+			std::vector<fixed32> values32(n);
+			std::ranges::generate(values32, []() { return -300_fx32 + fixed32::Float(random_float(10.0f)); });
+
+			long double sum = 0, sum32 = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				sum += static_cast<long double>(values[i].rawValue);
+				sum32 += values32[i].rawValue;
+			}
+			const long double mean = sum / n, mean32 = sum32 / n;
+			long double squares = 0, squares32 = 0;
+			for (size_t i = 0; i < n; ++i)
+			{
+				squares += (values[i].rawValue - mean) * (values[i].rawValue - mean);
+				squares32 += (values32[i].rawValue - mean32) * (values32[i].rawValue - mean32);
+			}
+			const double variance = static_cast<double>(squares / n / 0x1p32L / 0x1p32L);
+			const double variance32 = static_cast<double>(squares32 / n / 0x1p16L / 0x1p16L);
+
+			Mathfx::Stats<int64_t, 32> stats;
+			stats.Add(values);
+			Mathfx::Stats<int32_t, 16> stats32;
+			stats32.Add(values32);
+
+			REQUIRE(stats.Count() == n);
+			REQUIRE(stats.Sum().rawValue == static_cast<int64_t>(sum));
+			REQUIRE(stats.Mean().rawValue == static_cast<int64_t>(std::floor(mean)));
+			REQUIRE(stats32.Mean().rawValue == static_cast<int32_t>(std::floor(mean32)));
+			REQUIRE(stats.Min() == *std::ranges::min_element(values));
+			REQUIRE(stats.Max() == *std::ranges::max_element(values));
+			REQUIRE(stats32.Min() == *std::ranges::min_element(values32));
+			REQUIRE(stats32.Max() == *std::ranges::max_element(values32));
+			REQUIRE(std::abs(static_cast<double>(stats.Variance()) - variance) < 1e-6);
+			REQUIRE(std::abs(static_cast<double>(stats32.Variance()) - variance32) < 1e-3);
+			REQUIRE(std::abs(static_cast<double>(stats.StdDev()) - std::sqrt(variance)) < 1e-6);
+			REQUIRE(std::abs(static_cast<double>(stats32.StdDev()) - std::sqrt(variance32)) < 1e-3);
+			if (n > 1)
+			{
+				REQUIRE(std::abs(static_cast<double>(stats.SampleVariance()) - variance * n / (n - 1)) < 1e-6);
+			}
+
+			// Merging any split matches adding everything to one
+			const size_t split = G.rng() % (n + 1);
+			Mathfx::Stats<int64_t, 32> left, right;
+			left.Add(std::span(values).first(split));
+			right.Add(std::span(values).subspan(split));
+			left.Merge(right);
+			REQUIRE(left.Count() == n);
+			REQUIRE(left.Sum() == stats.Sum());
+			REQUIRE(left.Mean() == stats.Mean());
+			REQUIRE(left.Min() == stats.Min());
+			REQUIRE(left.Max() == stats.Max());
+			REQUIRE(std::abs(static_cast<double>(left.Variance()) - variance) < 1e-6);
+
+			// fixed32 keeps exact sums, the variance is the floor of n * sum(x^2) - sum(x)^2 over n^2 * 2^16
+			Int128 rawSum32;
+			uint64_t rawSquares32 = 0;
+			for (fixed32 x : values32)
+			{
+				rawSum32 += Int128(static_cast<int64_t>(x.rawValue));
+				rawSquares32 += static_cast<uint64_t>(static_cast<int64_t>(x.rawValue) * x.rawValue);
+			}
+			const Int128 spread = Int128::MulUnsigned(rawSquares32, n) - Int128::Mul(rawSum32.Low(), rawSum32.Low());
+			REQUIRE(stats32.Variance().rawValue == (Int128::DivUnsigned(Int128::DivUnsigned(spread, n), n) >> 16).Low());
+
+			// and any partition merged in any grouping gives the same bits as adding the values one by one
+			const size_t first = G.rng() % (n + 1);
+			const size_t second = first + G.rng() % (n - first + 1);
+			Mathfx::Stats<int32_t, 16> a, b, c;
+			a.Add(std::span(values32).first(first));
+			b.Add(std::span(values32).subspan(first, second - first));
+			c.Add(std::span(values32).subspan(second));
+			Mathfx::Stats<int32_t, 16> ab = a, bc = b;
+			ab.Merge(b);
+			ab.Merge(c);
+			bc.Merge(c);
+			Mathfx::Stats<int32_t, 16> abc = a;
+			abc.Merge(bc);
+			Mathfx::Stats<int32_t, 16> cba = c;
+			cba.Merge(b);
+			cba.Merge(a);
+			for (const Mathfx::Stats<int32_t, 16>& merged : { ab, abc, cba, Mathfx::ParallelStats(std::span(values32)) })
+			{
+				REQUIRE(merged.Count() == n);
+				REQUIRE(merged.Sum() == stats32.Sum());
+				REQUIRE(merged.Mean() == stats32.Mean());
+				REQUIRE(merged.Min() == stats32.Min());
+				REQUIRE(merged.Max() == stats32.Max());
+				REQUIRE(merged.Variance() == stats32.Variance());
+				REQUIRE(merged.SampleVariance() == stats32.SampleVariance());
+				REQUIRE(merged.StdDev() == stats32.StdDev());
+			}
+		}
+
+		Mathfx::Stats<int32_t, 16> empty;
+		REQUIRE(empty.Count() == 0);
+		REQUIRE(empty.Mean() == fixed32::Zero);
+		REQUIRE(empty.Variance() == fixed32::Zero);
+		REQUIRE(empty.StdDev() == fixed32::Zero);
+		REQUIRE(empty.Min() == fixed32::MaxValue);
+		REQUIRE(empty.Max() == fixed32::MinValue);
+
+		// The sum and deviations of extreme values don't overflow
+		Mathfx::Stats<int32_t, 16> extremes;
+		const std::vector<fixed32> ends = { fixed32::MaxValue, fixed32::MinValue, fixed32::MaxValue, fixed32::MinValue };
+		extremes.Add(ends);
+		REQUIRE(extremes.Sum() == fixed32(-2));
+		REQUIRE(extremes.Mean() == fixed32(-1));
+		REQUIRE(extremes.Variance() == fixed32::MaxValue);
+		REQUIRE(std::abs(static_cast<double>(extremes.StdDev()) - 32768.0) < 1e-3);
+
+		Mathfx::Stats<int32_t, 16> saturated;
+		for (int i = 0; i < 3; ++i)
+		{
+			saturated.Add(fixed32::MaxValue);
+		}
+		REQUIRE(saturated.Sum() == fixed32::MaxValue);
+		REQUIRE(saturated.Mean() == fixed32::MaxValue);
+		REQUIRE(saturated.Variance() == fixed32::Zero);
+	}
+
+	SECTION("ParallelStats is independent of the thread count")
+	{
+		std::vector<fixed64> values(50000);
+		std::ranges::generate(values, []() { return random_fixed(1000000_fx64); });
+		Mathfx::ThreadPool single(1);
+		Mathfx::ThreadPool many(4);
+		const auto a = Mathfx::ParallelStats(std::span(values), single);
+		const auto b = Mathfx::ParallelStats(std::span(values), many);
+		REQUIRE(a.Count() == b.Count());
+		REQUIRE(a.Sum() == b.Sum());
+		REQUIRE(a.Mean() == b.Mean());
+		REQUIRE(a.Variance() == b.Variance());
+		REQUIRE(a.StdDev() == b.StdDev());
+		REQUIRE(a.Min() == b.Min());
+		REQUIRE(a.Max() == b.Max());
+
+		Mathfx::Stats<int64_t, 32> serial;
+		serial.Add(values);
+		REQUIRE(a.Mean() == serial.Mean());
+		REQUIRE(std::abs(static_cast<double>(a.StdDev() - serial.StdDev())) < 1e-6);
+	}
+
+	SECTION("Histogram")
+	{
+		std::vector<fixed32> values(5000);
+		std::ranges::generate(values, []() { return fixed32::Float(random_float(12.0f)); });
+		values.push_back(fixed32::MinValue);
+		values.push_back(fixed32::MaxValue);
+
+		// 0.5 is a power of two raw width, 0.75 is not
+		for (fixed32 width : { 0.5_fx32, 0.75_fx32 })
+		{
+			const size_t bins = 20;
+			Mathfx::Histogram<int32_t, 16> histogram(-5_fx32, width, bins);
+			histogram.Add(values);
+
+			std::vector<uint64_t> expected(bins);
+			uint64_t under = 0, over = 0;
+			for (fixed32 x : values)
+			{
+				const double offset = (static_cast<double>(x) + 5.0) / static_cast<double>(width);
+				if (offset < 0)
+				{
+					++under;
+				}
+				else if (offset >= bins)
+				{
+					++over;
+				}
+				else
+				{
+					++expected[static_cast<size_t>(offset)];
+				}
+			}
+			REQUIRE(histogram.BinCount() == bins);
+			REQUIRE(histogram.Underflow() == under);
+			REQUIRE(histogram.Overflow() == over);
+			for (size_t i = 0; i < bins; ++i)
+			{
+				REQUIRE(histogram.Bin(i) == expected[i]);
+			}
+			REQUIRE(histogram.BinStart(2) == -5_fx32 + width * 2_fx32);
+
+			Mathfx::Histogram<int32_t, 16> left(-5_fx32, width, bins), right(-5_fx32, width, bins);
+			left.Add(std::span(values).first(100));
+			right.Add(std::span(values).subspan(100));
+			right.Merge(left);
+			for (size_t i = 0; i < bins; ++i)
+			{
+				REQUIRE(right.Bin(i) == histogram.Bin(i));
+			}
+			REQUIRE(right.Underflow() == under);
+			REQUIRE(right.Overflow() == over);
+		}
+
+		using fixed16 = Fixed<int16_t, 8>;
+		Mathfx::Histogram<int16_t, 8> small(fixed16::MinValue, fixed16::Float(32.0), 8);
+		small.Add(fixed16::MinValue);
+		small.Add(fixed16::MaxValue);
+		small.Add(fixed16::Zero);
+		REQUIRE(small.Bin(0) == 1);
+		REQUIRE(small.Bin(4) == 1);
+		REQUIRE(small.Bin(7) == 1);
+		REQUIRE(small.Overflow() == 0);
+	}
+}
+
+TEST_CASE("Splines", "[fixedmath]")
+{
+	auto bezier = [](double p0, double p1, double p2, double p3, double t) {
+		const double s = 1.0 - t;
+		return s * s * s * p0 + 3.0 * s * s * t * p1 + 3.0 * s * t * t * p2 + t * t * t * p3;
+	};
+	auto hermite = [](double p0, double m0, double p1, double m1, double t) {
+		const double t2 = t * t, t3 = t2 * t;
+		return (2.0 * t3 - 3.0 * t2 + 1.0) * p0 + (t3 - 2.0 * t2 + t) * m0 + (-2.0 * t3 + 3.0 * t2) * p1 + (t3 - t2) * m1;
+	};
+
+	SECTION("Evaluate matches the textbook forms")
+	{
+		for (int i = 0; i < 1000; ++i)
+		{
+			fixed64 p[4];
+			for (fixed64& x : p)
+			{
+				x = random_fixed(1000_fx64);
+			}
+			const double d[4] = { static_cast<double>(p[0]), static_cast<double>(p[1]), static_cast<double>(p[2]), static_cast<double>(p[3]) };
+			const fixed64 t = random_pos_fixed(1_fx64);
+			const double td = static_cast<double>(t);
+
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed64>::Bezier(p[0], p[1], p[2], p[3]).Evaluate(t)) - bezier(d[0], d[1], d[2], d[3], td)) < 1e-6);
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed64>::Hermite(p[0], p[1], p[2], p[3]).Evaluate(t)) - hermite(d[0], d[1], d[2], d[3], td)) < 1e-6);
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed64>::CatmullRom(p[0], p[1], p[2], p[3]).Evaluate(t)) -
+				hermite(d[1], (d[2] - d[0]) / 2.0, d[2], (d[3] - d[1]) / 2.0, td)) < 1e-6);
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed64>::QuadraticBezier(p[0], p[1], p[2]).Evaluate(t)) -
+				bezier(d[0], d[0] + 2.0 * (d[1] - d[0]) / 3.0, d[2] + 2.0 * (d[1] - d[2]) / 3.0, d[2], td)) < 1e-6);
+
+			const double dt = 1e-6;
+			const double slope = (bezier(d[0], d[1], d[2], d[3], td + dt) - bezier(d[0], d[1], d[2], d[3], td - dt)) / (2.0 * dt);
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed64>::Bezier(p[0], p[1], p[2], p[3]).Tangent(t)) - slope) < 1e-3);
+
+			const fixed32 q0 = fixed32::Float(static_cast<float>(d[0]));
+			const fixed32 q1 = fixed32::Float(static_cast<float>(d[1]));
+			const fixed32 q2 = fixed32::Float(static_cast<float>(d[2]));
+			const fixed32 q3 = fixed32::Float(static_cast<float>(d[3]));
+			const fixed32 t32 = fixed32::Float(static_cast<float>(td));
+			REQUIRE(std::abs(static_cast<double>(CubicSplinefx<fixed32>::Bezier(q0, q1, q2, q3).Evaluate(t32)) -
+				bezier(static_cast<double>(q0), static_cast<double>(q1), static_cast<double>(q2), static_cast<double>(q3), static_cast<double>(t32))) < 0.05);
+		}
+
+		const Vector2fx a(0_fx64, 0_fx64), b(1_fx64, 2_fx64), c(3_fx64, 2_fx64), e(4_fx64, 0_fx64);
+		const auto curve = CubicSplinefx<Vector2fx>::Bezier(a, b, c, e);
+		REQUIRE(curve.Evaluate(fixed64::Zero) == a);
+		REQUIRE(curve.Evaluate(fixed64::One) == e);
+		REQUIRE(curve.Evaluate(fixed64::Half) == Vector2fx(2_fx64, 1.5_fx64));
+		const auto path = CubicSplinefx<Vector2fx>::CatmullRom(a, b, c, e);
+		REQUIRE(path.Evaluate(fixed64::Zero) == b);
+		REQUIRE(path.Evaluate(fixed64::One) == c);
+	}
+
+	SECTION("Forward differencing stays on the curve")
+	{
+		for (size_t n : { 0, 1, 2, 3, 17, 1000, 4097 })
+		{
+			fixed64 p[4];
+			for (fixed64& x : p)
+			{
+				x = random_fixed(100000_fx64);
+			}
+			const auto curve = CubicSplinefx<fixed64>::Bezier(p[0], p[1], p[2], p[3]);
+			std::vector<fixed64> samples(n);
+			curve.Sample(samples);
+			for (size_t i = 0; i < n; ++i)
+			{
+				const long double t = n == 1 ? 0.0L : static_cast<long double>(i) / (n - 1);
+				const long double s = 1.0L - t;
+				long double expected = 0;
+				for (int k = 0; k < 4; ++k)
+				{
+					const long double weight = (k == 0 || k == 3 ? 1.0L : 3.0L) * std::pow(s, 3 - k) * std::pow(t, k);
+					expected += weight * p[k].rawValue;
+				}
+				REQUIRE(std::abs(static_cast<long double>(samples[i].rawValue) - expected) < 2.0L);
+			}
+			if (n >= 2)
+			{
+				REQUIRE(samples.front() == p[0]);
+				REQUIRE(samples.back() == p[3]);
+			}
+
+			std::vector<Vector2fx> points(n);
+			const auto arc = CubicSplinefx<Vector2fx>::Hermite(Vector2fx(p[0], p[1]), Vector2fx(p[2], p[3]), Vector2fx(p[1], p[0]), Vector2fx(p[3], p[2]));
+			arc.Sample(points);
+			for (size_t i = 0; i < n; ++i)
+			{
+				const fixed64 t = n == 1 ? fixed64::Zero : fixed64::Int(static_cast<int>(i)) / fixed64::Int(static_cast<int>(n - 1));
+				const Vector2fx expected = arc.Evaluate(t);
+				REQUIRE(std::abs(static_cast<double>(points[i].x - expected.x)) < 1e-4);
+				REQUIRE(std::abs(static_cast<double>(points[i].y - expected.y)) < 1e-4);
+			}
+
+			std::vector<fixed32> samples32(n);
+			const auto curve32 = CubicSplinefx<fixed32>::CatmullRom(-100_fx32, 20_fx32, 300_fx32, -5_fx32);
+			curve32.Sample(samples32);
+			for (size_t i = 0; i < n; ++i)
+			{
+				const double t = n == 1 ? 0.0 : static_cast<double>(i) / (n - 1);
+				REQUIRE(std::abs(static_cast<double>(samples32[i]) - hermite(20.0, 200.0, 300.0, -12.5, t)) < 1e-4);
+			}
+		}
+	}
+
+	SECTION("Arc length table")
+	{
+		// Control points bunched at the start make t run slowly there, the table evens it out
+		const Vector2fx start(0_fx64, 0_fx64), end(90_fx64, 0_fx64);
+		const auto line = CubicSplinefx<Vector2fx>::Bezier(start, Vector2fx(1_fx64, 0_fx64), Vector2fx(2_fx64, 0_fx64), end);
+		const ArcLengthTablefx<Vector2fx> table(line, 64);
+		REQUIRE(std::abs(static_cast<double>(table.Length()) - 90.0) < 1e-6);
+		REQUIRE(table.Parameter(-1_fx64) == fixed64::Zero);
+		REQUIRE(table.Parameter(fixed64::Zero) == fixed64::Zero);
+		REQUIRE(table.Parameter(100_fx64) == fixed64::One);
+		REQUIRE(table.Parameter(table.Length()) == fixed64::One);
+
+		std::vector<Vector2fx> points(31);
+		table.SampleUniform(points);
+		for (size_t i = 0; i < points.size(); ++i)
+		{
+			REQUIRE(std::abs(static_cast<double>(points[i].x) - 3.0 * i) < 0.05);
+			REQUIRE(points[i].y == fixed64::Zero);
+		}
+		REQUIRE(table.Evaluate(45_fx64).x > 44.95_fx64);
+
+		// A Bezier quarter circle of radius 100
+		const fixed64 k = 55.2284749831_fx64;
+		const auto quarter = CubicSplinefx<Vector2fx>::Bezier(Vector2fx(100_fx64, 0_fx64), Vector2fx(100_fx64, k), Vector2fx(k, 100_fx64), Vector2fx(0_fx64, 100_fx64));
+		const ArcLengthTablefx<Vector2fx> circle(quarter, 256);
+		REQUIRE(std::abs(static_cast<double>(circle.Length()) - 50.0 * std::numbers::pi) < 0.05);
+		fixed64 previous = -1_fx64;
+		for (int i = 0; i <= 100; ++i)
+		{
+			const fixed64 distance = circle.Length() * fixed64::Int(i) / 100_fx64;
+			const fixed64 t = circle.Parameter(distance);
+			REQUIRE(t > previous);
+			previous = t;
+			const Vector2fx point = circle.Evaluate(distance);
+			const double angle = std::atan2(static_cast<double>(point.y), static_cast<double>(point.x));
+			REQUIRE(std::abs(angle * 100.0 - static_cast<double>(distance)) < 0.2);
+		}
+
+		const ArcLengthTablefx<fixed32> flat(CubicSplinefx<fixed32>::Bezier(5_fx32, 5_fx32, 5_fx32, 5_fx32), 8);
+		REQUIRE(flat.Length() == fixed32::Zero);
+		REQUIRE(flat.Parameter(1_fx32) == fixed32::One);
+		REQUIRE(flat.Evaluate(fixed32::Zero) == 5_fx32);
+	}
+}
+
+static fixed32 MakeQuarterSineEntry(int i, size_t n)
+{
+	return fixed32::Float(std::sin(i * std::numbers::pi / 2.0 / (n - 1)));
+}
+
+TEST_CASE("FixedCurve", "[fixedmath]")
+{
+	SECTION("Baked functions")
+	{
+		const auto falloff = FixedCurve<int32_t, 16>::FromFunction(0_fx32, 10_fx32, 256, [](double x) { return std::pow(1.0 - x / 10.0, 2.5); });
+		REQUIRE(falloff.Min() == 0_fx32);
+		REQUIRE(falloff.Max() == 10_fx32);
+		REQUIRE(falloff.Resolution() >= 256);
+		REQUIRE(falloff.Resolution() <= 512);
+		REQUIRE(falloff.Evaluate(0_fx32) == fixed32::One);
+		REQUIRE(falloff.Evaluate(10_fx32) == fixed32::Zero);
+		REQUIRE(falloff.Evaluate(-3_fx32) == fixed32::One);
+		REQUIRE(falloff.Evaluate(fixed32::MaxValue) == fixed32::Zero);
+		for (int i = 0; i < 10000; ++i)
+		{
+			const fixed32 x = fixed32::Float(random_float(10.0f));
+			const double expected = std::pow(1.0 - std::abs(static_cast<double>(x)) / 10.0, 2.5);
+			REQUIRE(std::abs(static_cast<double>(falloff(Mathfx::Abs(x))) - expected) < 1e-3);
+		}
+
+		// The domain end falls between grid points, the extrapolated entry still lands on the value at the end
+		const auto xp = FixedCurve<int64_t, 32>::FromFunction(1_fx64, 99.3_fx64, 100, [](fixed64 level) { return level * level * 50_fx64; });
+		REQUIRE(xp(1_fx64) == 50_fx64);
+		REQUIRE(std::abs(static_cast<double>(xp(99.3_fx64)) - 99.3 * 99.3 * 50.0) < 1e-3);
+		for (int i = 0; i < 10000; ++i)
+		{
+			const fixed64 level = 1_fx64 + random_pos_fixed(98.3_fx64);
+			const double expected = static_cast<double>(level) * static_cast<double>(level) * 50.0;
+			REQUIRE(std::abs(static_cast<double>(xp(level)) - expected) < 25.0);
+		}
+
+		const auto saturated = FixedCurve<int32_t, 16>::FromFunction(0_fx32, 1_fx32, 16, [](double x) { return x * 1e6 - 5e5; });
+		REQUIRE(saturated(0_fx32) == fixed32::MinValue);
+		REQUIRE(saturated(1_fx32) == fixed32::MaxValue);
+	}
+
+	SECTION("Control points")
+	{
+		const std::vector<FixedCurve<int32_t, 16>::Point> points = { { 0_fx32, 0_fx32 }, { 1_fx32, 5_fx32 }, { 2.5_fx32, 6_fx32 }, { 7_fx32, 6_fx32 }, { 10_fx32, 20_fx32 } };
+		const auto linear = FixedCurve<int32_t, 16>::FromPoints(points, 512);
+		const auto smooth = FixedCurve<int32_t, 16>::FromPoints(points, 512, Mathfx::CurveInterpolation::Smooth);
+		for (const auto& point : points)
+		{
+			REQUIRE(std::abs(static_cast<double>(linear(point.x) - point.y)) < 1e-3);
+			REQUIRE(std::abs(static_cast<double>(smooth(point.x) - point.y)) < 1e-3);
+		}
+		REQUIRE(std::abs(static_cast<double>(linear(0.5_fx32)) - 2.5) < 1e-3);
+		REQUIRE(std::abs(static_cast<double>(linear(8.5_fx32)) - 13.0) < 1e-3);
+		REQUIRE(linear(5_fx32) == 6_fx32);
+
+		// Monotone points give a monotone curve that stays within them, flat between equal points
+		fixed32 previous = fixed32::Zero;
+		for (int i = 0; i <= 1000; ++i)
+		{
+			const fixed32 value = smooth(fixed32::Int(i) / 100_fx32);
+			REQUIRE(value >= previous - fixed32(2));
+			REQUIRE(value >= -0.001_fx32);
+			REQUIRE(value <= 20.001_fx32);
+			previous = value;
+		}
+		REQUIRE(std::abs(static_cast<double>(smooth(4_fx32)) - 6.0) < 1e-3);
+		REQUIRE(smooth(1.5_fx32) > linear(1.5_fx32));
+	}
+
+	SECTION("Sample tables")
+	{
+		// 256 intervals over [0, 1] is a raw step of 256, the samples become the table as they are
+		std::vector<fixed32> samples(257);
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			samples[i] = fixed32::Float(std::sqrt(i / 256.0));
+		}
+		const FixedCurve<int32_t, 16> root(0_fx32, 1_fx32, samples);
+		REQUIRE(root.Resolution() == 256);
+		for (size_t i = 0; i < samples.size(); ++i)
+		{
+			REQUIRE(root(fixed32(static_cast<int32_t>(i << 8))) == samples[i]);
+		}
+
+		// Ten intervals over [0, 100] are resampled
+		const std::vector<fixed32> steps = { 0_fx32, 1_fx32, 4_fx32, 9_fx32, 16_fx32, 25_fx32, 36_fx32, 49_fx32, 64_fx32, 81_fx32, 100_fx32 };
+		const FixedCurve<int32_t, 16> squares(0_fx32, 100_fx32, steps);
+		REQUIRE(squares(0_fx32) == 0_fx32);
+		REQUIRE(squares(100_fx32) == 100_fx32);
+		for (int i = 0; i <= 100; ++i)
+		{
+			const double x = i;
+			const double low = std::floor(x / 10.0);
+			const double expected = low * low + (x - 10.0 * low) * (2.0 * low + 1.0) / 10.0;
+			REQUIRE(std::abs(static_cast<double>(squares(fixed32::Int(i))) - expected) < 0.5);
+		}
+
+		const auto sine = FixedCurve<int32_t, 16>::FromLookupTable<&MakeQuarterSineEntry, 1025>(0_fx32, 64_fx32);
+		REQUIRE(sine(0_fx32) == fixed32::Zero);
+		REQUIRE(sine(64_fx32) == fixed32::Float(1.0));
+		REQUIRE(std::abs(static_cast<double>(sine(32_fx32)) - std::sqrt(0.5)) < 1e-4);
+	}
+
+	SECTION("Batch evaluation matches Evaluate")
+	{
+		const auto curve = FixedCurve<int32_t, 16>::FromFunction(-20_fx32, 30_fx32, 300, [](double x) { return std::sin(x) * 100.0; });
+		const auto wide = FixedCurve<int32_t, 16>::FromFunction(-30000_fx32, 30000_fx32, 8, [](double x) { return x / 4.0; });
+		const auto curve64 = FixedCurve<int64_t, 32>::FromFunction(-20_fx64, 30_fx64, 300, [](double x) { return std::sin(x) * 100.0; });
+		for (size_t n : { 0, 1, 7, 8, 9, 33, 1000 })
+		{
+			std::vector<fixed32> x(n), out(n), outWide(n);
+			std::ranges::generate(x, []() { return fixed32::Float(random_float(40.0f)); });
+			if (n > 2)
+			{
+				x[0] = fixed32::MinValue;
+				x[1] = fixed32::MaxValue;
+			}
+			curve.Evaluate(x, out);
+			wide.Evaluate(x, outWide);
+			for (size_t i = 0; i < n; ++i)
+			{
+				REQUIRE(out[i] == curve.Evaluate(x[i]));
+				REQUIRE(outWide[i] == wide.Evaluate(x[i]));
+			}
+			curve.Evaluate(std::span(x));
+			REQUIRE(x == out);
+
+			std::vector<fixed64> x64(n), out64(n);
+			std::ranges::generate(x64, []() { return random_fixed(40_fx64); });
+			curve64.Evaluate(x64, out64);
+			for (size_t i = 0; i < n; ++i)
+			{
+				REQUIRE(out64[i] == curve64(x64[i]));
+				REQUIRE(std::abs(static_cast<double>(out64[i]) - std::sin(std::clamp(static_cast<double>(x64[i]), -20.0, 30.0)) * 100.0) < 0.25);
+			}
+		}
+	}
 }
 
 int main(int argc, char* argv[])